@@ -43,6 +43,14 @@ cdef extern from "mata/nfa/nfa.hh" namespace "Mata::Nfa":
     cdef const Symbol CEPSILON "Mata::Nfa::EPSILON"
 
     cdef cppclass CPost "Mata::Nfa::Post":
+        # Nested iterator
+        cppclass const_iterator:
+            const_iterator()
+            CMove& operator*()
+            const_iterator& operator++()
+            bool operator==(const_iterator&)
+            bool operator!=(const_iterator&)
+
         void insert(CMove&)
         CMove& operator[](Symbol)
         CMove& back()
@@ -51,8 +59,8 @@ cdef extern from "mata/nfa/nfa.hh" namespace "Mata::Nfa":
         bool empty()
         size_t size()
         vector[CMove] ToVector()
-        COrdVector[CMove].const_iterator cbegin()
-        COrdVector[CMove].const_iterator cend()
+        CPost.const_iterator cbegin()
+        CPost.const_iterator cend()
 
     cdef cppclass CDelta "Mata::Nfa::Delta":
         vector[CPost] post
@@ -164,8 +172,8 @@ cdef extern from "mata/nfa/nfa.hh" namespace "Mata::Nfa":
         StateSet get_reachable_states()
         StateSet get_terminating_states()
         void remove_epsilon(Symbol) except +
-        COrdVector[CMove].const_iterator get_epsilon_transitions(State state, Symbol epsilon)
-        COrdVector[CMove].const_iterator get_epsilon_transitions(CPost& post, Symbol epsilon)
+        CPost.const_iterator get_epsilon_transitions(State state, Symbol epsilon)
+        CPost.const_iterator get_epsilon_transitions(CPost& post, Symbol epsilon)
         void clear()
         size_t size()
 
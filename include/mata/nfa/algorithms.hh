@@ -18,6 +18,7 @@
 
 #include "nfa.hh"
 #include "mata/simlib/util/binary_relation.hh"
+#include "mata/utils/two-dimensional-map.hh"
 
 /**
  * Concrete NFA implementations of algorithms, such as complement, inclusion, or universality checking.
@@ -37,6 +38,9 @@
  */
 namespace Mata::Nfa::Algorithms {
 
+/// States simulated by each state of an automaton, see @c get_simulated_states().
+using SimulatedStates = std::vector<std::vector<State>>;
+
 /**
  * Brzozowski minimization of automata (revert -> determinize -> revert -> determinize).
  * @param[in] aut Automaton to be minimized.
@@ -44,6 +48,36 @@ namespace Mata::Nfa::Algorithms {
  */
 Nfa minimize_brzozowski(const Nfa& aut);
 
+/**
+ * Minimization of deterministic automata by partition refinement in O(m log n) (Hopcroft's algorithm in the variant
+ *  of Valmari and Lehtinen for partial transition functions). Nondeterministic automata are determinized first.
+ * @param[in] aut Automaton to be minimized.
+ * @return Minimized automaton, with useless states removed (with a single initial state if the language is empty).
+ */
+Nfa minimize_hopcroft(const Nfa& aut);
+
+/**
+ * Renumber states of @p aut by @c Nfa::reorder() with the strategy given by the "reorder" key of @p params: "bfs",
+ *  "dfs" or "rcm". Nothing is done when the key is not set.
+ * @return Renaming of the states of @p aut, empty when the key is not set.
+ */
+std::vector<State> reorder(Nfa& aut, const StringMap& params);
+
+/**
+ * Subset construction computed by @p num_of_threads threads (0 means the number of hardware threads). Numbers of
+ *  threads above four times the number of hardware threads are capped.
+ *
+ * Macrostates are explored breadth-first, each level by all threads in parallel. The states of the result are
+ *  numbered in the order of the breadth-first exploration with successors ordered by symbols, so the result is the
+ *  same for any number of threads and any scheduling of the threads.
+ * @param[in] aut Automaton to determinize.
+ * @param[in] num_of_threads Number of threads to use.
+ * @param[out] subset_map Map that maps sets of states of input automaton to states of determinized automaton.
+ * @return Determinized automaton.
+ */
+Nfa determinize_parallel(const Nfa& aut, size_t num_of_threads,
+                         std::unordered_map<StateSet, State>* subset_map = nullptr);
+
 /**
  * Complement implemented by determization, adding sink state and making automaton complete. Then it adds final states
  *  which were non final in the original automaton.
@@ -80,6 +114,62 @@ bool is_included_naive(const Nfa& smaller, const Nfa& bigger, const Alphabet* al
  */
 bool is_included_antichains(const Nfa& smaller, const Nfa& bigger, const Alphabet*  alphabet = nullptr, Run* cex = nullptr);
 
+/**
+ * Inclusion implemented by antichain algorithms, where a product state subsumes another one with the same state of
+ *  smaller if every state of its macrostate of bigger is simulated by some state of the other macrostate (by the
+ *  forward direct simulation on bigger).
+ * @param[in] smaller Automaton which language should be included in the bigger one
+ * @param[in] bigger Automaton which language should include the smaller one
+ * @param[in] alphabet Alphabet of both automata (not needed for antichain algorithm)
+ * @param[out] cex A potential counterexample word which breaks inclusion
+ * @return True if smaller language is included,
+ * i.e., if the final intersection of smaller complement of bigger is empty.
+ */
+bool is_included_antichains_sim(const Nfa& smaller, const Nfa& bigger, const Alphabet* alphabet = nullptr,
+                                Run* cex = nullptr);
+
+/**
+ * Inclusion as @c is_included_antichains_sim() with @p simulated_states of @p bigger precomputed by
+ *  @c get_simulated_states(), so that checking inclusion of many automata in the same bigger one computes the
+ *  simulation only once.
+ */
+bool is_included_antichains_sim(const Nfa& smaller, const Nfa& bigger, const SimulatedStates& simulated_states,
+                                Run* cex = nullptr);
+
+/**
+ * Inclusion implemented by bisimulation up to congruence (HKC) on the disjoint union of the automata, using that
+ *  smaller is included in bigger iff smaller united with bigger is equivalent to bigger.
+ * @param[in] smaller Automaton which language should be included in the bigger one
+ * @param[in] bigger Automaton which language should include the smaller one
+ * @param[in] alphabet Alphabet of both automata (not needed for this algorithm)
+ * @param[out] cex A shortest counterexample word which breaks inclusion
+ * @return True if smaller language is included,
+ * i.e., if the final intersection of smaller complement of bigger is empty.
+ */
+bool is_included_hkc(const Nfa& smaller, const Nfa& bigger, const Alphabet* alphabet = nullptr, Run* cex = nullptr);
+
+/**
+ * Equivalence implemented by bisimulation up to congruence (HKC) on the disjoint union of the automata.
+ * @param[in] lhs First automaton
+ * @param[in] rhs Second automaton
+ * @param[in] alphabet Alphabet of both automata (not needed for this algorithm)
+ * @param[out] cex A shortest word in the language of exactly one of the automata
+ * @return True if the languages of @p lhs and @p rhs are equal.
+ */
+bool are_equivalent_hkc(const Nfa& lhs, const Nfa& rhs, const Alphabet* alphabet = nullptr, Run* cex = nullptr);
+
+/**
+ * Inclusion implemented by a breadth-first search of the product of smaller with the determinized bigger, where
+ *  bigger is determinized on the fly (see @c LazyDfa) only in the explored part of the product.
+ * @param[in] smaller Automaton which language should be included in the bigger one
+ * @param[in] bigger Automaton which language should include the smaller one
+ * @param[in] alphabet Alphabet of both automata (not needed for this algorithm)
+ * @param[out] cex A shortest counterexample word which breaks inclusion
+ * @return True if smaller language is included,
+ * i.e., if the final intersection of smaller complement of bigger is empty.
+ */
+bool is_included_lazy_dfa(const Nfa& smaller, const Nfa& bigger, const Alphabet* alphabet = nullptr, Run* cex = nullptr);
+
 /**
  * Universality check implemented by checking emptiness of complemented automaton
  * @param[in] aut Automaton which universality is checked
@@ -98,10 +188,36 @@ bool is_universal_naive(const Nfa& aut, const Alphabet& alphabet, Run* cex);
  */
 bool is_universal_antichains(const Nfa& aut, const Alphabet& alphabet, Run* cex);
 
+/**
+ * Universality checking based on subset construction with antichain, where a macrostate subsumes another one if
+ *  every state of the former is simulated by some state of the latter (by the forward direct simulation).
+ * @param[in] aut Automaton which universality is checked
+ * @param[in] alphabet Alphabet of the automaton
+ * @param[out] cex Counterexample word which eventually breaks the universality
+ * @return True if the automaton is universal, otherwise false.
+ */
+bool is_universal_antichains_sim(const Nfa& aut, const Alphabet& alphabet, Run* cex);
+
+/**
+ * Universality as @c is_universal_antichains_sim() with @p simulated_states of @p aut precomputed by
+ *  @c get_simulated_states().
+ */
+bool is_universal_antichains_sim(const Nfa& aut, const Alphabet& alphabet, const SimulatedStates& simulated_states,
+                                 Run* cex);
+
 Simlib::Util::BinaryRelation compute_relation(
         const Nfa& aut,
         const StringMap&  params = {{"relation", "simulation"}, {"direction", "forward"}});
 
+/**
+ * Compute, for each state r of @p aut, the sorted states q simulated by r (including r itself) by the forward direct
+ *  simulation. Macrostates closed under these sets (i.e., downward closed under simulation) are used by the antichain
+ *  algorithms with subsumption by simulation.
+ * @param[in] aut Automaton to compute the simulation for.
+ * @return Vector of states simulated by each state of @p aut.
+ */
+SimulatedStates get_simulated_states(const Nfa& aut);
+
 /**
  * @brief Compute intersection of two NFAs with a possibility of using multiple epsilons.
  *
@@ -110,10 +226,13 @@ Simlib::Util::BinaryRelation compute_relation(
  * @param[in] preserve_epsilon Whether to compute intersection preserving epsilon transitions.
  * @param[in] epsilons Set of symbols to be considered as epsilons
  * @param[out] prod_map Mapping of pairs of the original states (lhs_state, rhs_state) to new product states.
+ * @param[in] product_matrix_budget Maximal number of pairs of states (lhs.size() * rhs.size()) for which the product
+ *  states are looked up in a dense matrix. Larger products use a hash table instead.
  * @return NFA as a product of NFAs @p lhs and @p rhs with ε-transitions preserved.
  */
 Nfa intersection_eps(const Nfa& lhs, const Nfa& rhs, bool preserve_epsilon, const std::set<Symbol>& epsilons,
-    std::unordered_map<std::pair<State,State>, State> *prod_map = nullptr);
+    std::unordered_map<std::pair<State,State>, State> *prod_map = nullptr,
+    size_t product_matrix_budget = Util::TwoDimensionalMap<State, State>::DEFAULT_MATRIX_BUDGET);
 
 /**
  * @brief Concatenate two NFAs.
@@ -3,24 +3,45 @@
 #ifndef MATA_DELTA_HH
 #define MATA_DELTA_HH
 
+#include <atomic>
+#include <memory>
+#include <memory_resource>
+#include <optional>
+#include <span>
+
 namespace Mata::Nfa {
 
 /**
  * Structure represents a move which is a symbol and a set of target states of transitions.
+ *
+ * The targets are allocated from a memory resource (see @c Delta), the default resource unless another one is given.
+ *  The moves in a @c Post allocate their targets from the resource of the post.
  */
 class Move {
 public:
+    using allocator_type = std::pmr::polymorphic_allocator<State>;
+    /// Target states, an ordered vector like @c StateSet allocated from the memory resource of the move.
+    using Targets = Util::OrdVector<State, allocator_type>;
+
     Symbol symbol{};
-    StateSet targets{};
+    Targets targets{};
 
     Move() = default;
-    explicit Move(Symbol symbol) : symbol{ symbol }, targets{} {}
-    Move(Symbol symbol, State state_to) : symbol{ symbol }, targets{ state_to } {}
-    Move(Symbol symbol, StateSet states_to) : symbol{ symbol }, targets{ std::move(states_to) } {}
+    explicit Move(const allocator_type& alloc) : symbol{}, targets{ alloc } {}
+    explicit Move(Symbol symbol, const allocator_type& alloc = {}) : symbol{ symbol }, targets{ alloc } {}
+    Move(Symbol symbol, State state_to, const allocator_type& alloc = {})
+        : symbol{ symbol }, targets{ state_to, alloc } {}
+    Move(Symbol symbol, const StateSet& states_to, const allocator_type& alloc = {})
+        : symbol{ symbol }, targets{ states_to, alloc } {}
+    template<class StatesAllocator>
+    Move(Symbol symbol, const Util::OrdVector<State, StatesAllocator>& states_to, const allocator_type& alloc = {})
+        : symbol{ symbol }, targets{ states_to, alloc } {}
 
     Move(Move&& rhs) noexcept : symbol{ rhs.symbol }, targets{ std::move(rhs.targets) } {}
     Move(const Move& rhs) = default;
-    Move& operator=(Move&& rhs) noexcept;
+    Move(Move&& rhs, const allocator_type& alloc) : symbol{ rhs.symbol }, targets{ std::move(rhs.targets), alloc } {}
+    Move(const Move& rhs, const allocator_type& alloc) : symbol{ rhs.symbol }, targets{ rhs.targets, alloc } {}
+    Move& operator=(Move&& rhs) noexcept(std::is_nothrow_move_assignable_v<Targets>);
     Move& operator=(const Move& rhs) = default;
 
     inline bool operator<(const Move& rhs) const { return symbol < rhs.symbol; }
@@ -30,11 +51,11 @@ public:
     inline bool operator>(const Move& rhs) const { return symbol > rhs.symbol; }
     inline bool operator>=(const Move& rhs) const { return symbol >= rhs.symbol; }
 
-    StateSet::iterator begin() { return targets.begin(); }
-    StateSet::iterator end() { return targets.end(); }
+    Targets::iterator begin() { return targets.begin(); }
+    Targets::iterator end() { return targets.end(); }
 
-    StateSet::const_iterator cbegin() const { return targets.cbegin(); }
-    StateSet::const_iterator cend() const { return targets.cend(); }
+    Targets::const_iterator cbegin() const { return targets.cbegin(); }
+    Targets::const_iterator cend() const { return targets.cend(); }
 
     size_t count(State s) const { return targets.count(s); }
     bool empty() const { return targets.empty(); }
@@ -42,6 +63,7 @@ public:
 
     void insert(State s);
     void insert(const StateSet& states);
+    void insert(const Targets& states);
 
     // THIS BREAKS THE SORTEDNESS INVARIANT,
     // dangerous,
@@ -50,33 +72,44 @@ public:
 
     void remove(State s) { targets.remove(s); }
 
-    std::vector<State>::const_iterator find(State s) const { return targets.find(s); }
-    std::vector<State>::iterator find(State s) { return targets.find(s); }
+    Targets::const_iterator find(State s) const { return targets.find(s); }
+    Targets::iterator find(State s) { return targets.find(s); }
+
+    allocator_type get_allocator() const { return targets.get_allocator(); }
 }; // class Mata::Nfa::Move.
 
 /**
  * Post is a data structure representing possible transitions over different symbols.
  * It is an ordered vector containing possible Moves (i.e., pair of symbol and target states.
  * Vector is ordered by symbols which are numbers.
+ *
+ * The moves and their targets are allocated from the memory resource of the post, see @c Delta.
  */
-class Post : private Util::OrdVector<Move> {
+class Post : private Util::OrdVector<Move, std::pmr::polymorphic_allocator<Move>> {
 private:
-    using super = Util::OrdVector<Move>;
+    using super = Util::OrdVector<Move, std::pmr::polymorphic_allocator<Move>>;
 public:
+    using super::allocator_type;
     using super::iterator, super::const_iterator;
     using super::begin, super::end, super::cbegin, super::cend;
     using super::OrdVector;
     using super::operator=;
+    Post() = default;
+    explicit Post(const allocator_type& alloc) : super{ alloc } {}
     Post(const Post&) = default;
     Post(Post&&) = default;
+    Post(const Post& other, const allocator_type& alloc) : super{ other, alloc } {}
+    Post(Post&& other, const allocator_type& alloc) : super{ std::move(other), alloc } {}
     Post& operator=(const Post&) = default;
     Post& operator=(Post&&) = default;
+    using super::get_allocator;
     using super::insert;
     using super::reserve;
     using super::remove;
     using super::empty, super::size;
     using super::ToVector;
     using super::erase;
+    using super::clear;
     // dangerous, breaks the sortedness invariant
     using super::push_back;
     // is adding non-const version as well ok?
@@ -84,25 +117,168 @@ public:
     using super::filter;
 
     using super::find;
-    iterator find(const Symbol symbol) { return super::find({ symbol, {} }); }
-    const_iterator find(const Symbol symbol) const { return super::find({ symbol, {} }); }
+    iterator find(const Symbol symbol) { return super::find(Move{ symbol }); }
+    const_iterator find(const Symbol symbol) const { return super::find(Move{ symbol }); }
 }; // struct Post.
 
+class Delta;
+
+/**
+ * Immutable reverse index of @c Delta in the compressed sparse row (CSR) form: the transitions incoming to each state.
+ *
+ * Transitions incoming to state q are stored contiguously, ordered by symbols and then by source states, so @c pre(q)
+ *  takes constant time and @c pre(q, symbol) time logarithmic in the number of transitions incoming to q. Built from
+ *  a @c Delta by counting sorts in time linear in its size and number of states regardless of the magnitude of the
+ *  symbols (plus sorting the distinct symbols).
+ *
+ * Any modification of the original @c Delta is not reflected in the reverse index.
+ */
+class ReverseDelta {
+public:
+    /// Transition incoming to some state: its symbol and its source state.
+    struct InTransition {
+        Symbol symbol;
+        State source;
+
+        bool operator<(const InTransition& rhs) const {
+            return symbol < rhs.symbol || (symbol == rhs.symbol && source < rhs.source);
+        }
+        bool operator==(const InTransition& rhs) const = default;
+    };
+
+    ReverseDelta() = default;
+    explicit ReverseDelta(const Delta& delta);
+
+    /**
+     * @return Transitions incoming to @p q. Empty for states outside of the reverse index.
+     */
+    std::span<const InTransition> pre(State q) const {
+        if (q + 1 >= offsets.size()) { return {}; }
+        return { in_transitions.data() + offsets[q], in_transitions.data() + offsets[q + 1] };
+    }
+
+    /**
+     * @return Transitions incoming to @p q over @p symbol, ordered by their source states.
+     */
+    std::span<const InTransition> pre(State q, Symbol symbol) const;
+
+    /**
+     * Replace the moves of @p post by the moves of @p q in the reverted delta, i.e., by the transitions incoming to
+     *  @p q turned around. The move array of @p post is reused, its target sets are not.
+     */
+    void get_reverted_post(State q, Post& post) const;
+
+    /**
+     * @return Number of states in the reverse index (including states without incoming transitions).
+     */
+    size_t num_of_states() const { return offsets.empty() ? 0 : offsets.size() - 1; }
+
+    /**
+     * @return Number of transitions, i.e., triples (source, symbol, target).
+     */
+    size_t size() const { return in_transitions.size(); }
+
+private:
+    std::vector<size_t> offsets{}; ///< Index of the first transition incoming to each state; one extra sentinel.
+    std::vector<InTransition> in_transitions{}; ///< Transitions incoming to all states.
+}; // class ReverseDelta.
+
+/**
+ * Reverse index of a @c Delta built on demand and shared by the copies of the delta.
+ *
+ * The index is built at most once between two resets even when many threads ask for it at the same time, so reading
+ *  the reverse index of a delta shared among threads is safe as long as the delta is not modified.
+ */
+class LazyReverseDelta {
+public:
+    LazyReverseDelta() = default;
+    LazyReverseDelta(const LazyReverseDelta& other) noexcept : index{ other.index.load() } {}
+    LazyReverseDelta& operator=(const LazyReverseDelta& other) noexcept {
+        index.store(other.index.load());
+        return *this;
+    }
+
+    /**
+     * @return Reverse index of @p delta, built by this call if there is none.
+     */
+    const ReverseDelta& get(const Delta& delta) const;
+
+    /// Drop the index, it is built again by the next call of @c get().
+    void reset() noexcept { index.store(nullptr); }
+
+private:
+    mutable std::atomic<std::shared_ptr<const ReverseDelta>> index{};
+}; // class LazyReverseDelta.
+
+/**
+ * Changes of @c Delta recorded since the tracking of changes was started by @c Delta::track_changes().
+ *
+ * Transitions added and removed by @c Delta::add(), @c Delta::remove() and @c Delta::finalize() are recorded exactly,
+ *  adding states does not change any transition. Other modifications (through @c Delta::get_mutable_post(), ...)
+ *  cannot be described by transitions and only set @c is_untracked.
+ */
+struct DeltaChanges {
+    std::vector<Trans> added{}; ///< Added transitions, possibly with duplicates or transitions already present.
+    std::vector<Trans> removed{}; ///< Removed transitions.
+    bool is_untracked{ false }; ///< Whether the delta was modified in a way not recorded in @c added or @c removed.
+};
+
 /**
  * Delta is a data structure for representing transition relation.
  * Its underlying data structure is vector of Post structures.
  * Each index of vector corresponds to one state, that is a number of
  * state is an index to the vector of Posts.
+ *
+ * The posts, their moves and the targets of the moves are all allocated from a single memory resource, given at the
+ *  construction of the delta (@c std::pmr::get_default_resource() by default). With an arena, such as
+ *  @c std::pmr::monotonic_buffer_resource, building the delta does not call the global allocator for each move, and the
+ *  memory of all automata built in the arena is released at once with the arena. The arena has to outlive the automata
+ *  using it. Copies of the delta allocate from the default resource, moving keeps the resource.
  */
 class Delta {
+public:
+    using allocator_type = std::pmr::polymorphic_allocator<Post>;
+
 private:
-    std::vector<Post> posts;
+    std::pmr::vector<Post> posts;
+    /// Transitions added by @c add_unsorted() which are not yet in @c posts.
+    std::vector<Trans> bulk_transitions{};
+    bool bulk_mode{ false };
+    /// Reverse index of the posts, built on demand by @c get_reverse() and dropped on each modification.
+    LazyReverseDelta reverse{};
+    /// Changes since the last call to @c track_changes(), recorded only when the changes are tracked.
+    std::optional<DeltaChanges> changes{};
+
+    void set_untracked() { if (changes) { changes->is_untracked = true; } }
 
 public:
     inline static const Post empty_post; // When posts[q] is not allocated, then delta[q] returns this.
 
     Delta() : posts() {}
     explicit Delta(size_t n) : posts(n) {}
+    /**
+     * Create an empty delta allocating from @p resource, which has to outlive the delta.
+     */
+    explicit Delta(std::pmr::memory_resource* resource) : posts(resource) {}
+    /**
+     * Create a delta with @p n states allocating from @p resource, which has to outlive the delta.
+     */
+    Delta(size_t n, std::pmr::memory_resource* resource) : posts(n, resource) {}
+    Delta(const Delta&) = default;
+    Delta(Delta&&) = default;
+    /**
+     * Copy @p other, allocating the copy from @p resource.
+     */
+    Delta(const Delta& other, std::pmr::memory_resource* resource);
+    Delta& operator=(const Delta&) = default;
+    Delta& operator=(Delta&&) = default;
+
+    allocator_type get_allocator() const { return posts.get_allocator(); }
+
+    /**
+     * @return Memory resource from which the transitions are allocated.
+     */
+    std::pmr::memory_resource* get_memory_resource() const { return posts.get_allocator().resource(); }
 
     void reserve(size_t n) {
         posts.reserve(n);
@@ -130,13 +306,23 @@ public:
     // Get a constant reference to the post of a state. No side effects.
     const Post & operator[] (State q) const;
 
-    void emplace_back() { posts.emplace_back(); }
+    void emplace_back() {
+        posts.emplace_back();
+        reverse.reset();
+    }
 
-    void clear() { posts.clear(); }
+    void clear() {
+        posts.clear();
+        reverse.reset();
+        set_untracked();
+        bulk_transitions.clear();
+        bulk_mode = false;
+    }
 
     void increase_size(size_t n) {
         assert(n >= posts.size());
         posts.resize(n);
+        reverse.reset();
     }
 
     /**
@@ -151,6 +337,42 @@ public:
 
     bool contains(State src, Symbol symb, State tgt) const;
 
+    /**
+     * Get the reverse index of the delta (see @c ReverseDelta), giving the transitions incoming to states.
+     *
+     * The index is built by the first call after a modification of the delta and is kept (and shared by copies of the
+     *  delta) until the next modification, taking memory linear in the size of the delta. A post returned by
+     *  @c get_mutable_post() must not be modified after the index is built, get it again instead. Concurrent calls on
+     *  an unmodified delta are safe and build the index once. Algorithms making a single pass over the reverted
+     *  transitions build a local @c ReverseDelta instead, so that they do not keep the index in their operands.
+     */
+    const ReverseDelta& get_reverse() const { return reverse.get(*this); }
+
+    /**
+     * @return Transitions incoming to @p q. Builds and keeps the reverse index, see @c get_reverse().
+     */
+    std::span<const ReverseDelta::InTransition> pre(State q) const { return get_reverse().pre(q); }
+
+    /**
+     * @return Transitions incoming to @p q over @p symbol, ordered by their source states. Builds and keeps the
+     *  reverse index, see @c get_reverse().
+     */
+    std::span<const ReverseDelta::InTransition> pre(State q, Symbol symbol) const {
+        return get_reverse().pre(q, symbol);
+    }
+
+    /**
+     * Start recording the changes of the delta (see @c DeltaChanges) anew, forgetting the changes recorded so far.
+     */
+    void track_changes() { changes.emplace(); }
+
+    void stop_tracking_changes() { changes.reset(); }
+
+    /**
+     * @return Changes since the last call to @c track_changes(), or nullptr if the changes are not tracked.
+     */
+    const DeltaChanges* get_changes() const { return changes ? &*changes : nullptr; }
+
     /**
      * Check whether automaton contains no transitions.
      * @return True if there are no transitions in the automaton, false otherwise.
@@ -166,6 +388,8 @@ public:
         for(const Post& pst : post_vector) {
             this->posts.push_back(pst);
         }
+        reverse.reset();
+        set_untracked();
     }
 
     /**
@@ -189,15 +413,47 @@ public:
      */
     void add(const State state_from, const Symbol symbol, const StateSet& states);
 
+    /**
+     * Start adding transitions in bulk.
+     *
+     * Transitions are then added by @c add_unsorted() in an arbitrary order, possibly with duplicates, and are merged
+     *  into the delta only by @c finalize(). Until then, the added transitions are not visible through any other
+     *  method of the delta. Use when adding many transitions at once (constructing or copying automata, ...), where
+     *  the ordered insertion of @c add() would shift the posts and moves on each transition.
+     */
+    void start_bulk() { bulk_mode = true; }
+
+    /**
+     * Add transition in the bulk mode started by @c start_bulk().
+     */
+    void add_unsorted(State state_from, Symbol symbol, State state_to) {
+        assert(bulk_mode);
+        bulk_transitions.emplace_back(state_from, symbol, state_to);
+    }
+    void add_unsorted(const Trans& trans) { add_unsorted(trans.src, trans.symb, trans.tgt); }
+
+    /**
+     * Merge all transitions added by @c add_unsorted() into the delta and end the bulk mode.
+     *
+     * The buffered transitions are sorted by a counting sort on the source states and then by symbols and targets for
+     *  each source state separately, so the posts are built sorted in a single pass.
+     */
+    void finalize();
+
+    /**
+     * @return True if the delta is in the bulk mode started by @c start_bulk() and not yet finalized.
+     */
+    bool is_in_bulk() const { return bulk_mode; }
+
     /**
      * Iterator over transitions. It iterates over triples (lhs, symbol, rhs) where lhs and rhs are states.
      */
     struct const_iterator {
     private:
-        const std::vector<Post>& post;
+        const std::pmr::vector<Post>& post;
         size_t current_state;
         Post::const_iterator post_iterator{};
-        StateSet::const_iterator targets_position{};
+        Move::Targets::const_iterator targets_position{};
         bool is_end;
 
     public:
@@ -207,15 +463,15 @@ public:
         using pointer = int*;
         using reference = int&;
 
-        explicit const_iterator(const std::vector<Post>& post_p, bool ise = false);
+        explicit const_iterator(const std::pmr::vector<Post>& post_p, bool ise = false);
 
-        const_iterator(const std::vector<Post>& post_p, size_t as,
-                       Post::const_iterator pi, StateSet::const_iterator ti, bool ise = false) :
+        const_iterator(const std::pmr::vector<Post>& post_p, size_t as,
+                       Post::const_iterator pi, Move::Targets::const_iterator ti, bool ise = false) :
                 post(post_p), current_state(as), post_iterator(pi), targets_position(ti), is_end(ise) {};
 
         const_iterator(const const_iterator& other) = default;
 
-        Trans operator*() const { return Trans{current_state, (*post_iterator).symbol, *targets_position}; }
+        Trans operator*() const { return Trans{static_cast<State>(current_state), (*post_iterator).symbol, *targets_position}; }
 
         // Prefix increment
         const_iterator& operator++();
@@ -239,6 +495,124 @@ private:
 
 bool operator==(const Delta::const_iterator& a, const Delta::const_iterator& b);
 
+/**
+ * An immutable move of @c FrozenDelta: a symbol and a contiguous range of target states.
+ *
+ * Mirrors the read-only interface of @c Move, so that algorithms written for @c Post can iterate over @c FrozenPost.
+ */
+struct FrozenMove {
+    Symbol symbol{};
+    std::span<const State> targets{};
+
+    inline bool operator<(const FrozenMove& rhs) const { return symbol < rhs.symbol; }
+    inline bool operator<=(const FrozenMove& rhs) const { return symbol <= rhs.symbol; }
+    inline bool operator==(const FrozenMove& rhs) const { return symbol == rhs.symbol; }
+    inline bool operator!=(const FrozenMove& rhs) const { return symbol != rhs.symbol; }
+    inline bool operator>(const FrozenMove& rhs) const { return symbol > rhs.symbol; }
+    inline bool operator>=(const FrozenMove& rhs) const { return symbol >= rhs.symbol; }
+
+    const State* begin() const { return targets.data(); }
+    const State* end() const { return targets.data() + targets.size(); }
+    const State* cbegin() const { return begin(); }
+    const State* cend() const { return end(); }
+
+    size_t size() const { return targets.size(); }
+    bool empty() const { return targets.empty(); }
+    size_t count(State s) const { return std::binary_search(begin(), end(), s) ? 1 : 0; }
+}; // struct FrozenMove.
+
+/**
+ * A read-only view of the moves of a single state in @c FrozenDelta, ordered by symbols.
+ */
+class FrozenPost {
+public:
+    using iterator = std::vector<FrozenMove>::const_iterator;
+    using const_iterator = std::vector<FrozenMove>::const_iterator;
+
+    FrozenPost() = default;
+    FrozenPost(const_iterator first, const_iterator last) : first_{ first }, last_{ last } {}
+
+    const_iterator begin() const { return first_; }
+    const_iterator end() const { return last_; }
+    const_iterator cbegin() const { return first_; }
+    const_iterator cend() const { return last_; }
+
+    size_t size() const { return static_cast<size_t>(last_ - first_); }
+    bool empty() const { return first_ == last_; }
+    const FrozenMove& back() const { return *(last_ - 1); }
+
+    /**
+     * Find the move over @p symbol.
+     * @return Iterator to the move over @p symbol, or @c end() if there is none.
+     */
+    const_iterator find(Symbol symbol) const;
+
+private:
+    const_iterator first_{};
+    const_iterator last_{};
+}; // class FrozenPost.
+
+/**
+ * Immutable compressed sparse row (CSR) representation of @c Delta.
+ *
+ * All moves and all targets are stored in two contiguous arrays and @c post_offsets[q] points to the first move of
+ *  state q in the array of moves. Built from a @c Delta in a single pass, it provides the read-only interface of
+ *  @c Delta (@c operator[], @c num_of_states(), ...) to algorithms which only traverse the transition relation (product
+ *  constructions, subset constructions, ...), without chasing pointers to separately allocated posts and moves.
+ *
+ * Any modification of the original @c Delta is not reflected in the frozen copy.
+ */
+class FrozenDelta {
+public:
+    FrozenDelta() = default;
+    explicit FrozenDelta(const Delta& delta);
+
+    FrozenDelta(const FrozenDelta& other);
+    FrozenDelta(FrozenDelta&& other) noexcept = default;
+    FrozenDelta& operator=(const FrozenDelta& other);
+    FrozenDelta& operator=(FrozenDelta&& other) noexcept = default;
+
+    /**
+     * Get the post of state @p q. Empty post is returned for states outside of the frozen delta.
+     */
+    FrozenPost operator[](State q) const {
+        if (q + 1 >= post_offsets.size()) { return {}; }
+        return { moves.cbegin() + static_cast<long>(post_offsets[q]),
+                 moves.cbegin() + static_cast<long>(post_offsets[q + 1]) };
+    }
+
+    /**
+     * @return Number of states in the frozen delta (including states with an empty post).
+     */
+    size_t num_of_states() const { return post_offsets.empty() ? 0 : post_offsets.size() - 1; }
+
+    /**
+     * @return Number of transitions, i.e., triples (source, symbol, target).
+     */
+    size_t size() const { return targets.size(); }
+
+    /**
+     * @return Number of moves, i.e., pairs (source, symbol).
+     */
+    size_t num_of_moves() const { return moves.size(); }
+
+    /**
+     * @return Index of @p move among all moves of the frozen delta, from 0 to @c num_of_moves() - 1. Allows keeping
+     *  additional data for moves in arrays.
+     */
+    size_t index_of(FrozenPost::const_iterator move) const { return static_cast<size_t>(move - moves.cbegin()); }
+
+    bool empty() const { return targets.empty(); }
+
+private:
+    std::vector<size_t> post_offsets{}; ///< Index of the first move of each state; one extra sentinel at the end.
+    std::vector<FrozenMove> moves{}; ///< Moves of all states, each pointing into @c targets.
+    std::vector<State> targets{}; ///< Targets of all moves.
+
+    /// Let the target ranges of the moves point to the own @c targets after copying them from @p other.
+    void rebase_moves(const FrozenDelta& other);
+}; // class FrozenDelta.
+
 } // namespace Mata::Nfa.
 
 #endif //MATA_DELTA_HH
@@ -0,0 +1,98 @@
+/* dense-dfa.hh -- Deterministic automata with dense transition tables for fast matching.
+ *
+ * This file is a part of libmata.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#ifndef MATA_DENSE_DFA_HH
+#define MATA_DENSE_DFA_HH
+
+#include <cstdint>
+#include <vector>
+
+#include "nfa.hh"
+
+namespace Mata::Nfa {
+
+/**
+ * @brief Deterministic automaton over a range of symbols with a dense transition table, for matching many words.
+ *
+ * Transitions are stored in a flat table indexed by @c state * @c alphabet_size() + @c symbol - @c first_symbol(), so
+ *  reading a symbol takes a single table lookup instead of a search in the posts of @c Nfa. Missing transitions lead to
+ *  a dead state, which is not accepting and has no transitions to other states. The table takes
+ *  (@c num_of_states() + 1) * @c alphabet_size() entries, so the range of symbols should be small (e.g., bytes).
+ */
+class DenseDfa {
+public:
+    using StateId = uint32_t;
+
+    /**
+     * Build the dense automaton from @p aut over symbols from @p first_symbol to @p first_symbol + @p alphabet_size - 1.
+     *
+     * Transitions of @p aut over other symbols are left out.
+     * @param[in] aut Deterministic automaton (with at most one initial state and at most one target of each symbol).
+     * @param[in] first_symbol The smallest symbol in the table.
+     * @param[in] alphabet_size Number of symbols in the table.
+     */
+    explicit DenseDfa(const Nfa& aut, Symbol first_symbol = 0, size_t alphabet_size = 256);
+
+    /**
+     * @return True iff the word of @p length bytes at @p data (read as symbols) is accepted.
+     */
+    bool match(const uint8_t* data, const size_t length) const {
+        const StateId* const table{ transitions.data() };
+        StateId state{ initial_state };
+        for (const uint8_t* const end{ data + length }; data != end; ++data) {
+            // Symbols before the first symbol wrap around to large numbers, out of the table as well.
+            const Symbol column{ static_cast<Symbol>(*data) - first_symbol_ };
+            if (column >= alphabet_size_) { return false; }
+            state = table[static_cast<size_t>(state) * alphabet_size_ + column];
+            if (state == dead_state) { return false; }
+        }
+        return is_accepting(state);
+    }
+
+    /**
+     * @return True iff @p word is accepted.
+     */
+    bool match(const std::vector<Symbol>& word) const;
+
+    /**
+     * @return Target of the transition from @p state over @p symbol, the dead state if there is none.
+     */
+    StateId step(const StateId state, const Symbol symbol) const {
+        const Symbol column{ symbol - first_symbol_ };
+        if (column >= alphabet_size_) { return dead_state; }
+        return transitions[static_cast<size_t>(state) * alphabet_size_ + column];
+    }
+
+    bool is_accepting(const StateId state) const { return (accepting[state / 64] >> (state % 64)) & 1; }
+
+    StateId get_initial_state() const { return initial_state; }
+    StateId get_dead_state() const { return dead_state; }
+    /// @return Number of states, without the dead state.
+    size_t num_of_states() const { return dead_state; }
+    Symbol first_symbol() const { return first_symbol_; }
+    size_t alphabet_size() const { return alphabet_size_; }
+
+private:
+    Symbol first_symbol_;
+    Symbol alphabet_size_;
+    StateId dead_state; ///< The state following the states of the automaton.
+    StateId initial_state; ///< The dead state if the automaton has no initial state.
+    std::vector<StateId> transitions{}; ///< Targets of transitions from all states including the dead state.
+    std::vector<uint64_t> accepting{}; ///< Bitmap of accepting states.
+}; // class DenseDfa.
+
+} // namespace Mata::Nfa.
+
+#endif // MATA_DENSE_DFA_HH
@@ -0,0 +1,109 @@
+/* lazy-dfa.hh -- Determinized automaton constructed on demand.
+ *
+ * This file is a part of libmata.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#ifndef MATA_LAZY_DFA_HH
+#define MATA_LAZY_DFA_HH
+
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "nfa.hh"
+#include "macrostate-store.hh"
+#include "mata/utils/k-way-merge.hh"
+
+namespace Mata::Nfa {
+
+/**
+ * @brief View of the automaton @c determinize(aut) whose states and transitions are computed only when queried.
+ *
+ * States of the view are ids of macrostates of the wrapped automaton, assigned consecutively from 0 in the order in
+ *  which the macrostates are reached. State @c initial_state() is the set of initial states of the wrapped automaton.
+ *  The view is complete: @c post() of a macrostate with no move over a symbol is the empty macrostate, which is not
+ *  final and loops to itself over every symbol.
+ *
+ * Computed transitions are memoized in a cache of at most @c max_cached_transitions() entries. The cache is flushed
+ *  when it is full; the transitions are then recomputed when queried again. Explored macrostates are kept for the
+ *  whole lifetime of the view, so the states returned earlier stay valid.
+ *
+ * The wrapped automaton must outlive the view and must not be modified while the view is used.
+ */
+class LazyDfa {
+public:
+    /// Maximal number of cached transitions used when the constructor is not given an explicit bound.
+    static constexpr size_t DEFAULT_MAX_CACHED_TRANSITIONS{ 1 << 20 };
+
+    explicit LazyDfa(const Nfa& aut, size_t max_cached_transitions = DEFAULT_MAX_CACHED_TRANSITIONS);
+
+    State initial_state() const { return initial_state_; }
+
+    /**
+     * @return Successor of @p dfa_state over @p symbol, computing it if it is not cached.
+     */
+    State post(State dfa_state, Symbol symbol);
+
+    bool is_final(State dfa_state) const { return is_final_[dfa_state]; }
+
+    /**
+     * @return True iff @p dfa_state is the empty macrostate, from which no word is accepted.
+     */
+    bool is_empty(State dfa_state) const { return macrostates[static_cast<MacrostateStore::Id>(dfa_state)].empty(); }
+
+    /**
+     * @return States of the wrapped automaton in the macrostate @p dfa_state.
+     */
+    StateSet get_macrostate(State dfa_state) const {
+        return macrostates.get_state_set(static_cast<MacrostateStore::Id>(dfa_state));
+    }
+
+    /**
+     * @return Number of states of the view explored so far.
+     */
+    size_t num_of_explored_states() const { return macrostates.size(); }
+
+    size_t num_of_cached_transitions() const { return transitions.size(); }
+    size_t max_cached_transitions() const { return max_cached_transitions_; }
+
+    /**
+     * Forget all cached transitions. Explored states stay valid.
+     */
+    void clear_cache() { transitions.clear(); }
+
+private:
+    const Nfa& aut;
+    const FrozenDelta delta; ///< Contiguous copy of the transitions of @c aut, searched for moves over symbols.
+    size_t max_cached_transitions_;
+    MacrostateStore macrostates{};
+    std::vector<bool> is_final_{}; ///< Whether the macrostate with the given id contains a final state.
+    State initial_state_;
+    std::unordered_map<std::pair<State, Symbol>, State> transitions{}; ///< Cached transitions.
+    Util::KWayMerger<State> targets_merger{};
+    std::vector<State> targets_union{};
+
+    /// Get the id of the sorted @p macrostate, storing it if it is new.
+    State get_or_insert(std::span<const State> macrostate);
+
+    /// Compute the successor of @p dfa_state over @p symbol.
+    State compute_post(State dfa_state, Symbol symbol);
+}; // class LazyDfa.
+
+/**
+ * Check whether @p word is in the language of the automaton of @p dfa, exploring only the states read by the word.
+ */
+bool is_in_lang(LazyDfa& dfa, const Run& word);
+
+} // namespace Mata::Nfa.
+
+#endif // MATA_LAZY_DFA_HH
@@ -0,0 +1,274 @@
+/* macrostate-store.hh -- Store of interned sets of states for subset constructions.
+ *
+ * This file is a part of libmata.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#ifndef MATA_MACROSTATE_STORE_HH
+#define MATA_MACROSTATE_STORE_HH
+
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <vector>
+
+#include "types.hh"
+#include "delta.hh"
+#include "mata/utils/bit-words.hh"
+
+namespace Mata::Nfa {
+
+/**
+ * @brief Store of macrostates (sets of states) explored by subset constructions.
+ *
+ * Each distinct macrostate is stored exactly once, in a single contiguous array of states shared by all macrostates,
+ *  and is identified by a 32-bit id. Ids are assigned consecutively from 0 in the order of insertion, so they can be
+ *  directly used as states of the constructed automaton. The hash of a macrostate is computed while its states are
+ *  copied into the array, and a lookup of an already stored macrostate does not allocate anything.
+ *
+ * Macrostates are inserted as sorted sequences of states without duplicates. Views of stored macrostates returned by
+ *  @c operator[] are invalidated by subsequent insertions.
+ */
+class MacrostateStore {
+public:
+    using Id = uint32_t;
+    /// Id returned for macrostates which are not stored.
+    static constexpr Id NO_ID{ std::numeric_limits<Id>::max() };
+
+    MacrostateStore() = default;
+
+    /**
+     * Store the macrostate [@p first, @p last) unless it is already stored.
+     * @return Pair of the id of the macrostate and a flag which is true iff the macrostate has just been inserted.
+     */
+    template<class Iterator>
+    std::pair<Id, bool> insert(Iterator first, Iterator last) {
+        const size_t start{ states.size() };
+        size_t hash{ HASH_SEED };
+        for (; first != last; ++first) {
+            states.push_back(*first);
+            hash = combine_hash(hash, *first);
+        }
+        return insert_appended(start, hash);
+    }
+    std::pair<Id, bool> insert(std::span<const State> macrostate) {
+        return insert(macrostate.begin(), macrostate.end());
+    }
+    std::pair<Id, bool> insert(const StateSet& macrostate) { return insert(macrostate.begin(), macrostate.end()); }
+
+    /**
+     * @return Id of the stored @p macrostate, or @c NO_ID if it is not stored.
+     */
+    Id find(std::span<const State> macrostate) const;
+    Id find(const StateSet& macrostate) const { return find(std::span<const State>{ macrostate.ToVector() }); }
+
+    /**
+     * @return View of the states of the macrostate @p id. Invalidated by the next insertion.
+     */
+    std::span<const State> operator[](Id id) const {
+        return { states.data() + offsets[id], states.data() + offsets[id + 1] };
+    }
+
+    /**
+     * @return The macrostate @p id as a newly created set of states.
+     */
+    StateSet get_state_set(Id id) const;
+
+    /**
+     * @return Number of stored macrostates.
+     */
+    size_t size() const { return offsets.size() - 1; }
+    bool empty() const { return size() == 0; }
+
+    /**
+     * @return Number of states in all stored macrostates together.
+     */
+    size_t num_of_stored_states() const { return states.size(); }
+
+    void clear();
+
+    /**
+     * Fill @p subset_map with all stored macrostates mapped to their ids.
+     */
+    void to_subset_map(std::unordered_map<StateSet, State>& subset_map) const;
+
+private:
+    static constexpr size_t HASH_SEED{ 0x9e3779b97f4a7c15ULL };
+    static constexpr size_t INITIAL_TABLE_SIZE{ 64 }; ///< Must be a power of two.
+
+    std::vector<State> states{}; ///< States of all macrostates, one after another.
+    std::vector<size_t> offsets{ 0 }; ///< Macrostate i occupies states[offsets[i]] to states[offsets[i + 1] - 1].
+    std::vector<size_t> hashes{}; ///< Hash of each macrostate.
+    std::vector<Id> table{ std::vector<Id>(INITIAL_TABLE_SIZE, NO_ID) }; ///< Open-addressing table of macrostate ids.
+
+    static size_t combine_hash(size_t hash, State state) {
+        hash ^= static_cast<size_t>(state) + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2);
+        return hash;
+    }
+
+    static size_t hash_of(std::span<const State> macrostate);
+
+    /**
+     * Finish insertion of the macrostate just appended to @c states from position @p start. If an equal macrostate is
+     *  already stored, the appended states are removed again.
+     */
+    std::pair<Id, bool> insert_appended(size_t start, size_t hash);
+
+    /// Find the slot of @c table holding the macrostate equal to @p macrostate, or the empty slot where it belongs.
+    size_t find_slot(std::span<const State> macrostate, size_t hash) const;
+
+    void grow_table();
+}; // class MacrostateStore.
+
+/**
+ * @brief Store of macrostates represented as bit sets of a fixed width.
+ *
+ * Variant of @c MacrostateStore for automata with few states, where a macrostate is an array of @c num_of_words()
+ *  64-bit words (see @c Util::BitWords). Union of macrostates is then a word-wise OR and inclusion a word-wise
+ *  (lhs & ~rhs) == 0, both vectorized where possible. Ids are assigned consecutively from 0 in the order of insertion.
+ */
+class BitMacrostateStore {
+public:
+    using Id = MacrostateStore::Id;
+    static constexpr Id NO_ID{ MacrostateStore::NO_ID };
+
+    /**
+     * Maximal number of states of an automaton for which the algorithms choose bit set macrostates automatically.
+     * For more states, sorted vectors of states are more compact for the sparse macrostates typically explored.
+     */
+    static constexpr size_t MAX_STATES{ 4096 };
+    /// Maximal number of words of the bit sets of targets of all moves of an automaton, see @c get_move_targets().
+    static constexpr size_t MAX_MOVE_TARGETS_WORDS{ 1 << 22 };
+
+    /**
+     * Create a store of macrostates of an automaton with @p num_of_states states.
+     */
+    explicit BitMacrostateStore(size_t num_of_states);
+
+    /**
+     * Decide whether to use bit set macrostates for an automaton with @p num_of_states states and transitions
+     *  @p delta, considering the memory needed for them and for the result of @c get_move_targets().
+     */
+    static bool is_suitable_for(size_t num_of_states, const FrozenDelta& delta) {
+        return num_of_states <= MAX_STATES
+               && delta.num_of_moves() * Util::BitWords::num_of_words(num_of_states) <= MAX_MOVE_TARGETS_WORDS;
+    }
+
+    /**
+     * Get targets of all moves of @p delta as bit sets of the width of this store.
+     * @return Words of the targets of all moves, where targets of move m start at index
+     *  @c delta.index_of(m) * num_of_words().
+     */
+    std::vector<uint64_t> get_move_targets(const FrozenDelta& delta) const;
+
+    /**
+     * Store the macrostate given by @c num_of_words() words at @p words unless it is already stored.
+     * @return Pair of the id of the macrostate and a flag which is true iff the macrostate has just been inserted.
+     */
+    std::pair<Id, bool> insert(const uint64_t* words);
+
+    /**
+     * @return Id of the stored macrostate given by @p words, or @c NO_ID if it is not stored.
+     */
+    Id find(const uint64_t* words) const;
+
+    /**
+     * @return Words of the macrostate @p id. Invalidated by the next insertion.
+     */
+    const uint64_t* operator[](Id id) const { return words_.data() + static_cast<size_t>(id) * num_of_words_; }
+
+    /**
+     * @return The macrostate @p id as a newly created set of states.
+     */
+    StateSet get_state_set(Id id) const;
+
+    size_t num_of_words() const { return num_of_words_; }
+    size_t size() const { return hashes.size(); }
+    bool empty() const { return hashes.empty(); }
+
+    void clear();
+
+private:
+    static constexpr size_t INITIAL_TABLE_SIZE{ 64 }; ///< Must be a power of two.
+
+    size_t num_of_words_;
+    std::vector<uint64_t> words_{}; ///< Words of all macrostates, one after another.
+    std::vector<size_t> hashes{}; ///< Hash of each macrostate.
+    std::vector<Id> table{ std::vector<Id>(INITIAL_TABLE_SIZE, NO_ID) }; ///< Open-addressing table of macrostate ids.
+
+    /// Find the slot of @c table holding the macrostate equal to @p words, or the empty slot where it belongs.
+    size_t find_slot(const uint64_t* words, size_t hash) const;
+
+    void grow_table();
+}; // class BitMacrostateStore.
+
+/**
+ * @brief Store of tuples of states of a fixed arity, such as states of products of several automata.
+ *
+ * Unlike macrostates, tuples are neither sorted nor free of duplicates: position i of a tuple holds a state of the
+ *  i-th automaton. Each distinct tuple is stored once in a single contiguous array, tuple i occupying positions
+ *  i * arity() to (i + 1) * arity() - 1, and is identified by a 32-bit id. Ids are assigned consecutively from 0 in
+ *  the order of insertion, so they can be directly used as states of the product.
+ */
+class TupleStore {
+public:
+    using Id = MacrostateStore::Id;
+    static constexpr Id NO_ID{ MacrostateStore::NO_ID };
+
+    /**
+     * Create a store of tuples of @p arity states.
+     */
+    explicit TupleStore(size_t arity) : arity_{ arity } {}
+
+    /**
+     * Store the tuple @p tuple of @c arity() states unless it is already stored.
+     * @return Pair of the id of the tuple and a flag which is true iff the tuple has just been inserted.
+     */
+    std::pair<Id, bool> insert(std::span<const State> tuple);
+
+    /**
+     * @return Id of the stored @p tuple, or @c NO_ID if it is not stored.
+     */
+    Id find(std::span<const State> tuple) const;
+
+    /**
+     * @return View of the states of the tuple @p id. Invalidated by the next insertion.
+     */
+    std::span<const State> operator[](Id id) const {
+        return { states.data() + static_cast<size_t>(id) * arity_, arity_ };
+    }
+
+    size_t arity() const { return arity_; }
+    size_t size() const { return hashes.size(); }
+    bool empty() const { return hashes.empty(); }
+
+    void clear();
+
+private:
+    static constexpr size_t INITIAL_TABLE_SIZE{ 64 }; ///< Must be a power of two.
+
+    size_t arity_;
+    std::vector<State> states{}; ///< States of all tuples, one after another.
+    std::vector<size_t> hashes{}; ///< Hash of each tuple.
+    std::vector<Id> table{ std::vector<Id>(INITIAL_TABLE_SIZE, NO_ID) }; ///< Open-addressing table of tuple ids.
+
+    static size_t hash_of(std::span<const State> tuple);
+
+    /// Find the slot of @c table holding the tuple equal to @p tuple, or the empty slot where it belongs.
+    size_t find_slot(std::span<const State> tuple, size_t hash) const;
+
+    void grow_table();
+}; // class TupleStore.
+
+} // namespace Mata::Nfa.
+
+#endif // MATA_MACROSTATE_STORE_HH
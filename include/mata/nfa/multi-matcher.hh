@@ -0,0 +1,104 @@
+/* multi-matcher.hh -- Matching words against many automata at once.
+ *
+ * This file is a part of libmata.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#ifndef MATA_MULTI_MATCHER_HH
+#define MATA_MULTI_MATCHER_HH
+
+#include <cstdint>
+#include <vector>
+
+#include "nfa.hh"
+#include "lazy-dfa.hh"
+
+namespace Mata::Nfa {
+
+/**
+ * @brief Matcher of words against a sequence of patterns (automata), reporting all patterns accepting a word.
+ *
+ * The patterns are compiled into a single union automaton whose states remember the pattern they come from. Words
+ *  are read by a @c LazyDfa of the union, so each symbol is read once for all patterns, and determinized states
+ *  and transitions explored by earlier words are reused by later ones. Matching a word thus costs a cached
+ *  transition per symbol once the rule set is warmed up, instead of a simulation of each pattern.
+ *
+ * The matcher keeps its own copy of the patterns, which may be destroyed after the construction. The matcher can be
+ *  neither copied nor moved, since its lazy automaton refers to the union automaton.
+ */
+class MultiMatcher {
+public:
+    /// Index of a pattern in the sequence the matcher was constructed from.
+    using PatternId = size_t;
+
+    /**
+     * Compile @p patterns into the matcher. Epsilon transitions of the patterns are removed.
+     *
+     * @param[in] patterns Automata to match against, identified by their indices.
+     * @param[in] max_cached_transitions Bound on the number of cached transitions of the lazy automaton (see
+     *  @c LazyDfa).
+     */
+    explicit MultiMatcher(const ConstAutRefSequence& patterns,
+                          size_t max_cached_transitions = LazyDfa::DEFAULT_MAX_CACHED_TRANSITIONS);
+
+    MultiMatcher(const MultiMatcher&) = delete;
+    MultiMatcher& operator=(const MultiMatcher&) = delete;
+
+    /**
+     * @return Sorted ids of patterns accepting @p word.
+     */
+    std::vector<PatternId> match(const std::vector<Symbol>& word);
+
+    /**
+     * @return Sorted ids of patterns accepting the word of @p length bytes at @p data (read as symbols).
+     */
+    std::vector<PatternId> match(const uint8_t* data, size_t length);
+
+    /**
+     * @return True iff some pattern accepts @p word.
+     */
+    bool matches_any(const std::vector<Symbol>& word);
+
+    size_t num_of_patterns() const { return num_of_patterns_; }
+
+    /**
+     * @return Union of the patterns, its states numbered pattern by pattern.
+     */
+    const Nfa& get_union() const { return union_aut; }
+
+    /**
+     * @return Pattern of the state @p state of the union automaton.
+     */
+    PatternId pattern_of(const State state) const { return pattern_of_[state]; }
+
+    const LazyDfa& get_lazy_dfa() const { return lazy_dfa; }
+
+private:
+    size_t num_of_patterns_;
+    std::vector<PatternId> pattern_of_{}; ///< Pattern of each state of the union automaton.
+    Nfa union_aut;
+    LazyDfa lazy_dfa; ///< Determinization of @c union_aut, explored by the matched words.
+    /// Sorted ids of patterns with a final state in each state of @c lazy_dfa, computed when first reached.
+    std::vector<std::vector<PatternId>> accepted_patterns{};
+    std::vector<bool> is_accepted_computed{};
+
+    /// Read @p symbols from the initial state of @c lazy_dfa, stopping early in the empty macrostate.
+    template<class Symbols>
+    State run(const Symbols& symbols);
+
+    /// @return Sorted ids of patterns with a final state in @p dfa_state.
+    const std::vector<PatternId>& get_accepted_patterns(State dfa_state);
+}; // class MultiMatcher.
+
+} // namespace Mata::Nfa.
+
+#endif // MATA_MULTI_MATCHER_HH
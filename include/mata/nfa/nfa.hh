@@ -16,8 +16,7 @@
 #ifndef MATA_NFA_HH_
 #define MATA_NFA_HH_
 
-// Static data structures, such as search stack, in algorithms. Might have some effect on some algorithms (like
-//  fragile_revert).
+// Static data structures, such as search stack, in algorithms. Might have some effect on some algorithms.
 //#define _STATIC_STRUCTURES_
 
 #include <algorithm>
@@ -40,6 +39,7 @@
 #include "mata/utils/sparse-set.hh"
 #include "types.hh"
 #include "delta.hh"
+#include "macrostate-store.hh"
 
 /**
  * Nondeterministic Finite Automata including structures, transitions and algorithms.
@@ -54,6 +54,35 @@
  */
 namespace Mata::Nfa {
 
+/**
+ * Strategies of renumbering states by @c Nfa::reorder().
+ */
+enum class ReorderStrategy {
+    BFS, ///< Breadth-first order from the initial states.
+    DFS_PREORDER, ///< Depth-first preorder from the initial states.
+    /// Reverse Cuthill-McKee order of the transition graph taken as undirected, reducing the differences between the
+    ///  source and target states of transitions.
+    REVERSE_CUTHILL_MCKEE,
+};
+
+/**
+ * State of the automaton kept by @c Nfa::incremental_trim() between its calls.
+ *
+ * After each incremental trim, the states of the automaton are either useful (reachable and terminating) or tombstones:
+ *  states without any transitions which are neither initial nor final, left in place until they are compacted.
+ */
+struct IncrementalTrimState {
+    bool is_active{ false }; ///< Whether the rest of the state describes the automaton at the last incremental trim.
+    BoolVector is_reachable{};
+    BoolVector is_terminating{};
+    BoolVector is_tombstone{};
+    size_t num_of_tombstones{ 0 };
+    /// Sources of transitions incoming to each state. Over-approximation, filtered lazily when used.
+    std::vector<std::vector<State>> predecessors{};
+    std::vector<State> initial{}; ///< Initial states at the last incremental trim.
+    std::vector<State> final{}; ///< Final states at the last incremental trim.
+};
+
 /**
  * A struct representing an NFA.
  */
@@ -76,8 +105,16 @@ public:
     // TODO: When there is a need for state dictionary, consider creating default library implementation of state
     //  dictionary in the attributes.
     std::unordered_map<std::string, void*> attributes{};
+    /// State of the incremental trimming, see @c incremental_trim().
+    IncrementalTrimState incremental_trim_state{};
 
 public:
+    /**
+     * @brief Construct a new explicit NFA with the transitions @p delta.
+     *
+     * The automaton keeps the memory resource of @p delta, so an automaton constructed from @c Delta{ &arena } keeps
+     *  all its transitions in the arena (see @c Delta) and has to be destroyed before the arena.
+     */
     explicit Nfa(Delta delta = {}, Util::SparseSet<State> initial_states = {},
                  Util::SparseSet<State> final_states = {}, Alphabet* alphabet = nullptr)
         : delta(std::move(delta)), initial(std::move(initial_states)), final(std::move(final_states)), alphabet(alphabet) {}
@@ -98,7 +135,8 @@ public:
 
     Nfa(Mata::Nfa::Nfa&& other) noexcept
         : delta{ std::move(other.delta) }, initial{ std::move(other.initial) }, final{ std::move(other.final) },
-          alphabet{ other.alphabet }, attributes{ std::move(other.attributes) } { other.alphabet = nullptr; }
+          alphabet{ other.alphabet }, attributes{ std::move(other.attributes) },
+          incremental_trim_state{ std::move(other.incremental_trim_state) } { other.alphabet = nullptr; }
 
     Nfa& operator=(const Mata::Nfa::Nfa& other) = default;
     Nfa& operator=(Mata::Nfa::Nfa&& other) noexcept;
@@ -219,6 +257,21 @@ public:
     void trim_reverting(StateToStateMap* state_map = nullptr);
     void trim(StateToStateMap* state_map = nullptr) { trim_inplace(state_map); }
 
+    /**
+     * @brief Remove useless states, exploring only the parts of the automaton affected by changes since the last call.
+     *
+     * The first call trims the automaton by @c trim_inplace() and starts tracking changes of @c delta (see
+     *  @c Delta::track_changes()). Later calls only re-explore states whose reachability or termination may have
+     *  changed by the transitions added and removed since and by changes of initial and final states. Useless states
+     *  found are not renumbered: their transitions are removed and they are left in place as tombstones. The states
+     *  are compacted only when the tombstones make more than @p defragment_threshold of all states. A modification of
+     *  @c delta which is not tracked (such as through @c Delta::get_mutable_post()) makes the next call a full trim.
+     *
+     * @param[out] state_map Mapping of the states staying in the automaton to their new numbers.
+     * @param[in] defragment_threshold Ratio of tombstones to all states at which the states are compacted.
+     */
+    void incremental_trim(StateToStateMap* state_map = nullptr, double defragment_threshold = 0.25);
+
     /**
      * @brief Remove inaccessible (unreachable) and not co-accessible (non-terminating) states.
      *
@@ -232,10 +285,32 @@ public:
     Nfa get_trimmed_automaton(StateToStateMap* state_map = nullptr) const;
 
     /**
-     * Remove epsilon transitions from the automaton.
+     * @brief Renumber the states so that the states used together are stored close to each other.
+     *
+     * Product constructions and subset constructions number states in the order of their discovery, so the successors
+     *  of a state are scattered over the whole automaton. Renumbering the states by a traversal of the automaton
+     *  improves locality of later algorithms. States not reached from the initial states (or, for the reverse
+     *  Cuthill-McKee order, from any state) are traversed from the remaining states in their order.
+     *
+     * @param[in] strategy Order of the states to use.
+     * @return Renaming of the states: the new number of each original state.
+     */
+    std::vector<State> reorder(ReorderStrategy strategy);
+
+    /**
+     * Remove epsilon transitions from the automaton in place, replacing only its transitions.
      */
     void remove_epsilon(Symbol epsilon = EPSILON);
 
+    /**
+     * Revert the automaton in place: turn all transitions around and swap initial and final states.
+     *
+     * Works like @c revert(const Nfa&): a temporary reverse index of the transitions is built and the post of each
+     *  state is refilled from it. Only the move arrays of the posts are reused, the target sets are allocated anew, so
+     *  the peak memory is the same as for @c revert(const Nfa&).
+     */
+    void revert_inplace();
+
     /**
      * @brief In-place concatenation.
      */
@@ -278,7 +353,8 @@ public:
      * Get transitions leading to @p state_to.
      * @param state_to[in] Target state for transitions to get.
      * @return Sequence of @c Trans transitions leading to @p state_to.
-     * (!slow!, traverses the entire delta)
+     * Reads the reverse index of @c delta by @c Delta::pre(), which builds the index if there is none and keeps it in
+     *  @c delta, so that further calls take time linear in the number of the returned transitions.
      */
     TransSequence get_transitions_to(State state_to) const;
 
@@ -344,7 +420,7 @@ public:
         const Nfa* nfa;
         size_t trIt;
         Post::const_iterator tlIt;
-        StateSet::const_iterator ssIt;
+        Move::Targets::const_iterator ssIt;
         Trans trans;
         bool is_end = { false };
 
@@ -355,7 +431,7 @@ public:
         // FIXME: He, what is this? Some comment would help.
         // I am thinking about that removing everything having to do with Transition might be a good thing. Transition
         //  adds clutter and makes people write inefficient code.
-        void refresh_trans() { this->trans = {trIt, this->tlIt->symbol, *(this->ssIt)}; }
+        void refresh_trans() { this->trans = {static_cast<State>(trIt), this->tlIt->symbol, *(this->ssIt)}; }
 
         const Trans& operator*() const { return this->trans; }
 
@@ -485,6 +561,80 @@ Nfa uni(const Nfa &lhs, const Nfa &rhs);
 Nfa intersection(const Nfa& lhs, const Nfa& rhs,
                  bool preserve_epsilon = false, std::unordered_map<std::pair<State, State>, State> *prod_map = nullptr);
 
+/**
+ * Options of operations which can be computed by multiple threads.
+ */
+struct ParallelOptions {
+    /// Number of threads to use. 0 means the number of hardware threads, 1 computes the operation sequentially.
+    ///  Numbers of threads above four times the number of hardware threads are capped.
+    size_t threads{ 0 };
+};
+
+/**
+ * @brief Compute intersection of two NFAs (without preserving epsilon transitions) by @c options.threads threads.
+ *
+ * The product is explored breadth-first, states of each level are processed by all threads in parallel. The product
+ *  states are numbered by the order in which the threads reach them, so the result is isomorphic to the result of the
+ *  sequential intersection(), but the numbering of its states may differ between runs.
+ *
+ * @param[in] lhs First NFA to compute intersection for.
+ * @param[in] rhs Second NFA to compute intersection for.
+ * @param[in] options Number of threads to use.
+ * @param[out] prod_map Mapping of pairs of the original states (lhs_state, rhs_state) to new product states.
+ * @return NFA as a product of NFAs @p lhs and @p rhs.
+ */
+Nfa intersection(const Nfa& lhs, const Nfa& rhs, const ParallelOptions& options,
+                 std::unordered_map<std::pair<State, State>, State> *prod_map = nullptr);
+
+/**
+ * @brief Compute intersection of two NFAs as intersection(lhs, rhs, preserve_epsilon, prod_map) controlled by @p params.
+ *
+ * @param[in] lhs First NFA to compute intersection for.
+ * @param[in] rhs Second NFA to compute intersection for.
+ * @param[in] params Parameters to control the intersection:
+ * - "preserve_epsilon": "true", "false" (Default: "false")
+ * - "reorder": "bfs", "dfs", "rcm" to renumber the states of the result by @c Nfa::reorder() with
+ *    @c ReorderStrategy::BFS, @c ReorderStrategy::DFS_PREORDER or @c ReorderStrategy::REVERSE_CUTHILL_MCKEE.
+ *    (Default: the states are not renumbered)
+ * @param[out] prod_map Mapping of pairs of the original states (lhs_state, rhs_state) to new product states.
+ * @return NFA as a product of NFAs @p lhs and @p rhs.
+ */
+Nfa intersection(const Nfa& lhs, const Nfa& rhs, const StringMap& params,
+                 std::unordered_map<std::pair<State, State>, State> *prod_map = nullptr);
+
+/**
+ * @brief Compute intersection of all @p nfas (without preserving epsilon transitions) in a single product.
+ *
+ * Tuples of states of the automata are explored directly, without constructing the intermediate products of
+ *  intersection() of pairs of automata. Tuples containing a useless state of some automaton (see
+ *  @c Nfa::get_useful_states()) are not explored, as no final tuple is reachable from them.
+ *
+ * @param[in] nfas Automata to intersect, at least one.
+ * @return NFA as a product of @p nfas.
+ */
+Nfa intersection(const ConstAutRefSequence& nfas);
+
+/**
+ * @brief Check whether the intersection of the languages of @p lhs and @p rhs is empty.
+ *
+ * The product of the automata is explored breadth-first on the fly and the exploration stops at the first pair of
+ *  final states, without constructing the product automaton.
+ *
+ * @param[in] lhs First NFA.
+ * @param[in] rhs Second NFA.
+ * @param[out] cex A shortest word in the intersection in @c cex->word if it is not empty. @c cex->path is cleared.
+ * @return True if the intersection is empty, false otherwise.
+ */
+bool is_intersection_empty(const Nfa& lhs, const Nfa& rhs, Run* cex = nullptr);
+
+/**
+ * @brief Check whether the intersection of the languages of all @p nfas is empty.
+ *
+ * N-ary version of is_intersection_empty(lhs, rhs, cex), exploring tuples of states of the automata. The intersection
+ *  of no automata is the language of all words, which is not empty.
+ */
+bool is_intersection_empty(const ConstAutRefSequence& nfas, Run* cex = nullptr);
+
 /**
  * @brief Concatenate two NFAs.
  *
@@ -543,7 +693,7 @@ bool make_complete(Nfa& aut, const Util::OrdVector<Symbol>& symbols, State sink_
  * @param[in] alphabet Alphabet to use for computing "missing" symbols.
  * @return True if some new transition (and sink state) was added to the automaton.
  */
-inline bool make_complete(Nfa& aut, const Alphabet& alphabet) { return make_complete(aut, alphabet, aut.size()); }
+inline bool make_complete(Nfa& aut, const Alphabet& alphabet) { return make_complete(aut, alphabet, static_cast<State>(aut.size())); }
 
 /**
  * @brief Compute automaton accepting complement of @p aut.
@@ -581,7 +731,7 @@ Nfa complement(const Nfa& aut, const Util::OrdVector<Symbol>& symbols,
  *
  * @param[in] aut Automaton whose minimal version to compute.
  * @param[in] params Optional parameters to control the minimization algorithm:
- * - "algorithm": "brzozowski"
+ * - "algorithm": "brzozowski", "hopcroft" (deterministic automata are always minimized by "hopcroft")
  * @return Minimal deterministic automaton.
  */
 Nfa minimize(const Nfa &aut, const StringMap& params = {{"algorithm", "brzozowski"}});
@@ -595,6 +745,31 @@ Nfa minimize(const Nfa &aut, const StringMap& params = {{"algorithm", "brzozowsk
  */
 Nfa determinize(const Nfa&  aut, std::unordered_map<StateSet, State> *subset_map = nullptr);
 
+/**
+ * @brief Determinize automaton.
+ *
+ * @param[in] aut Automaton to determinize.
+ * @param[in] params Parameters to control the determinization:
+ * - "threads": decimal number of threads to use, "0" for the number of hardware threads. When set, the result is
+ *    numbered canonically (see @c Algorithms::determinize_parallel()), independently of the number of threads. When
+ *    not set, the automaton is determinized sequentially by determinize(aut, subset_map).
+ * - "reorder": "bfs", "dfs", "rcm" to renumber the states of the result by @c Nfa::reorder() (see
+ *    intersection(const Nfa&, const Nfa&, const StringMap&, std::unordered_map<std::pair<State, State>, State>*)).
+ * @param[out] subset_map Map that maps sets of states of input automaton to states of determinized automaton.
+ * @return Determinized automaton.
+ */
+Nfa determinize(const Nfa& aut, const StringMap& params, std::unordered_map<StateSet, State> *subset_map = nullptr);
+
+/**
+ * @brief Determinize automaton, keeping the explored sets of states in @p macrostates.
+ *
+ * State q of the determinized automaton corresponds to the set of states @c macrostates[q] of @p aut.
+ * @param[in] aut Automaton to determinize.
+ * @param[out] macrostates Store of sets of states of @p aut, cleared before the determinization.
+ * @return Determinized automaton.
+ */
+Nfa determinize(const Nfa& aut, MacrostateStore& macrostates);
+
 /**
  * Reduce the size of the automaton.
  *
@@ -603,6 +778,8 @@ Nfa determinize(const Nfa&  aut, std::unordered_map<StateSet, State> *subset_map
  * @param[out] state_map Mapping of trimmed states to new states.
  * @param[in] params Optional parameters to control the reduction algorithm:
  * - "algorithm": "simulation".
+ * - "reorder": "bfs", "dfs", "rcm" to renumber the states of the result by @c Nfa::reorder() (see
+ *    intersection(const Nfa&, const Nfa&, const StringMap&, std::unordered_map<std::pair<State, State>, State>*)).
  * @return Reduced automaton.
  */
 Nfa reduce(const Nfa &aut, bool trim_input = true, StateToStateMap *state_map = nullptr,
@@ -630,7 +807,7 @@ inline bool is_universal(
  * @param[out] cex Counterexample for the inclusion.
  * @param[in] alphabet Alphabet of both NFAs to compute with.
  * @param[in] params Optional parameters to control the equivalence check algorithm:
- * - "algorithm": "naive", "antichains" (Default: "antichains")
+ * - "algorithm": "naive", "antichains", "antichains-sim", "lazy_dfa", "hkc" (Default: "antichains")
  * @return True if @p smaller is included in @p bigger, false otherwise.
  */
 bool is_included(
@@ -647,7 +824,7 @@ bool is_included(
  * @param[in] bigger Second automaton to concatenate.
  * @param[in] alphabet Alphabet of both NFAs to compute with.
  * @param[in] params Optional parameters to control the equivalence check algorithm:
- * - "algorithm": "naive", "antichains" (Default: "antichains")
+ * - "algorithm": "naive", "antichains", "antichains-sim", "lazy_dfa", "hkc" (Default: "antichains")
  * @return True if @p smaller is included in @p bigger, false otherwise.
  */
 inline bool is_included(
@@ -665,7 +842,7 @@ inline bool is_included(
  * @param[in] rhs Second automaton to concatenate.
  * @param[in] alphabet Alphabet of both NFAs to compute with.
  * @param[in] params[ Optional parameters to control the equivalence check algorithm:
- * - "algorithm": "naive", "antichains" (Default: "antichains")
+ * - "algorithm": "naive", "antichains", "antichains-sim", "lazy_dfa", "hkc" (Default: "antichains")
  * @return True if @p lhs and @p rhs are equivalent, false otherwise.
  */
 bool are_equivalent(const Nfa& lhs, const Nfa& rhs, const Alphabet* alphabet,
@@ -685,30 +862,16 @@ bool are_equivalent(const Nfa& lhs, const Nfa& rhs, const Alphabet* alphabet,
  * @param[in] lhs First automaton to concatenate.
  * @param[in] rhs Second automaton to concatenate.
  * @param[in] params Optional parameters to control the equivalence check algorithm:
- * - "algorithm": "naive", "antichains" (Default: "antichains")
+ * - "algorithm": "naive", "antichains", "antichains-sim", "lazy_dfa", "hkc" (Default: "antichains")
  * @return True if @p lhs and @p rhs are equivalent, false otherwise.
  */
 bool are_equivalent(const Nfa& lhs, const Nfa& rhs, const StringMap& params = {{"algorithm", "antichains"}});
 
-// Reverting the automaton by one of the three functions below,
-// currently simple_revert seems best (however, not tested enough).
+// Reverting the automaton by reading a reverse index of aut.delta (see ReverseDelta), which is the reverted transition
+//  relation already ordered as the posts of the result, in time linear in the size of the automaton regardless of the
+//  magnitude of the symbols. See also Nfa::revert_inplace().
 Nfa revert(const Nfa& aut);
 
-// This revert algorithm is fragile, uses low level accesses to Nfa and static data structures,
-// and it is potentially dangerous when there are used symbols with large numbers (allocates an array indexed by symbols)
-// It is faster asymptotically and for somewhat dense automata,
-// the same or a little bit slower than simple_revert otherwise.
-// Not affected by pre-reserving vectors.
-Nfa fragile_revert(const Nfa& aut);
-
-// Reverting the automaton by a simple algorithm, which does a lot of random access addition to Post and Move.
-//  Much affected by pre-reserving vectors.
-Nfa simple_revert(const Nfa& aut);
-
-// Reverting the automaton by a modification of the simple algorithm.
-// It replaces random access addition to Move by push_back and sorting later, so far seems the slowest of all, except on dense automata, where it is almost as slow as simple_revert. Candidate for removal.
-Nfa somewhat_simple_revert(const Nfa& aut);
-
 // Removing epsilon transitions
 Nfa remove_epsilon(const Nfa& aut, Symbol epsilon = EPSILON);
 
@@ -0,0 +1,83 @@
+/* scc.hh -- Strongly connected components of automata.
+ *
+ * This file is a part of libmata.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#ifndef MATA_SCC_HH
+#define MATA_SCC_HH
+
+#include <span>
+#include <vector>
+
+#include "nfa.hh"
+
+namespace Mata::Nfa {
+
+/**
+ * @brief Decomposition of the states of an automaton into strongly connected components (SCCs).
+ *
+ * Components are numbered in a topological order of the condensation of the automaton: each transition leads from
+ *  a component to the same component or to a component with a greater number. Processing the components from the
+ *  last one to the first one thus visits the successors of each component before the component itself, which turns
+ *  fixpoint computations over successors into single passes.
+ */
+class SccDecomposition {
+public:
+    /**
+     * @return Number of the component of @p state.
+     */
+    size_t component_of(const State state) const { return component_of_[state]; }
+
+    /**
+     * @return States of the component @p component, in no particular order.
+     */
+    std::span<const State> operator[](const size_t component) const {
+        return { states.data() + offsets[component], states.data() + offsets[component + 1] };
+    }
+
+    size_t num_of_components() const { return offsets.size() - 1; }
+
+    /**
+     * @return True iff @p state lies on a cycle, that is, its component has multiple states or a self-loop.
+     */
+    bool is_on_cycle(State state) const { return is_on_cycle_[component_of_[state]]; }
+
+private:
+    std::vector<size_t> component_of_{}; ///< Component of each state.
+    std::vector<size_t> offsets{ 0 }; ///< Index of the first state of each component in @c states; one sentinel.
+    std::vector<State> states{}; ///< States of all components, one component after another.
+    std::vector<bool> is_on_cycle_{}; ///< Whether each component has multiple states or a self-loop.
+
+    /// Decompose the graph of the transitions of @p aut over the symbols for which @p is_followed holds.
+    template<class IsFollowed>
+    static SccDecomposition compute(const Nfa& aut, const IsFollowed& is_followed);
+
+    friend SccDecomposition compute_sccs(const Nfa& aut);
+    friend SccDecomposition compute_sccs(const Nfa& aut, Symbol symbol);
+}; // class SccDecomposition.
+
+/**
+ * Compute strongly connected components of the transition graph of @p aut by an iterative version of Tarjan's
+ *  algorithm in time linear in the size of the automaton.
+ */
+SccDecomposition compute_sccs(const Nfa& aut);
+
+/**
+ * Compute strongly connected components of the graph of the transitions of @p aut over @p symbol only (e.g., of its
+ *  epsilon transitions).
+ */
+SccDecomposition compute_sccs(const Nfa& aut, Symbol symbol);
+
+} // namespace Mata::Nfa.
+
+#endif // MATA_SCC_HH
@@ -0,0 +1,117 @@
+/* symbol-classes.hh -- Classes of symbols with the same transitions in automata.
+ *
+ * This file is a part of libmata.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#ifndef MATA_SYMBOL_CLASSES_HH
+#define MATA_SYMBOL_CLASSES_HH
+
+#include <unordered_map>
+#include <vector>
+
+#include "nfa.hh"
+
+namespace Mata::Nfa {
+
+/**
+ * @brief Partition of symbols into classes of symbols with the same transitions from each state of an automaton.
+ *
+ * Symbols of a class are interchangeable in every word with respect to the language of the automaton, so algorithms
+ *  iterating over symbols (determinization, completion, complementation, universality checking) need to consider
+ *  only a single symbol of each class. Classes are numbered from 0 in the increasing order of their smallest symbols
+ *  and used as symbols of automata over classes (see @c to_symbol_classes()). Epsilon is in no class.
+ */
+class SymbolClasses {
+public:
+    /**
+     * @return Class of @p symbol. The symbol has to be in some class.
+     */
+    Symbol class_of(const Symbol symbol) const { return class_of_.at(symbol); }
+
+    /**
+     * @return True iff @p symbol is in some class.
+     */
+    bool contains(const Symbol symbol) const { return class_of_.find(symbol) != class_of_.end(); }
+
+    /**
+     * @return Map of each symbol in some class to its class.
+     */
+    const std::unordered_map<Symbol, Symbol>& get_class_map() const { return class_of_; }
+
+    /**
+     * @return Sorted symbols of the class @p symbol_class.
+     */
+    const Util::OrdVector<Symbol>& operator[](const Symbol symbol_class) const { return members[symbol_class]; }
+
+    /**
+     * @return The smallest symbol of the class @p symbol_class, which stands for the whole class.
+     */
+    Symbol get_representative(const Symbol symbol_class) const { return *members[symbol_class].begin(); }
+
+    size_t num_of_classes() const { return members.size(); }
+
+    /**
+     * @return Classes of @p symbols, ignoring symbols in no class.
+     */
+    Util::OrdVector<Symbol> get_classes_of(const Util::OrdVector<Symbol>& symbols) const;
+
+private:
+    std::unordered_map<Symbol, Symbol> class_of_{}; ///< Class of each symbol.
+    std::vector<Util::OrdVector<Symbol>> members{}; ///< Sorted symbols of each class.
+
+    /// Partition the symbols of transitions of @p aut and the symbols of @p symbols if not null.
+    static SymbolClasses compute(const Nfa& aut, const Util::OrdVector<Symbol>* symbols);
+
+    friend SymbolClasses compute_symbol_classes(const Nfa& aut);
+    friend SymbolClasses compute_symbol_classes(const Nfa& aut, const Util::OrdVector<Symbol>& symbols);
+}; // class SymbolClasses.
+
+/**
+ * Compute the coarsest partition of the symbols of transitions of @p aut into classes of symbols with the same
+ *  targets from each state, in time linear in the size of the automaton (with hashing).
+ */
+SymbolClasses compute_symbol_classes(const Nfa& aut);
+
+/**
+ * Compute the coarsest partition of the symbols of transitions of @p aut and of @p symbols into classes of symbols
+ *  with the same targets from each state, such that symbols of @p symbols are never in a class with other symbols.
+ *
+ * Symbols of @p symbols without any transitions in @p aut thus form a single class. Use this version to work over an
+ *  alphabet, e.g., to complete the automaton over classes of the alphabet symbols.
+ */
+SymbolClasses compute_symbol_classes(const Nfa& aut, const Util::OrdVector<Symbol>& symbols);
+
+/**
+ * Replace symbols of the transitions of @p aut by their classes in @p classes, merging the transitions of symbols of
+ *  the same class. Epsilon transitions are kept.
+ *
+ * @param[in] aut Automaton whose symbols are all in some class of @p classes, e.g., computed for @p aut.
+ * @param[in] classes Classes of symbols of @p aut.
+ * @return Automaton over classes with the same states.
+ */
+Nfa to_symbol_classes(const Nfa& aut, const SymbolClasses& classes);
+
+/**
+ * Replace classes on the transitions of @p aut by all symbols of the classes in @p classes, the inverse of
+ *  to_symbol_classes(). Epsilon transitions are kept.
+ *
+ * @param[in] aut Automaton over classes of @p classes (e.g., an automaton obtained from to_symbol_classes() and
+ *  determinized).
+ * @param[in] classes Classes of symbols.
+ * @return Automaton over symbols with the same states.
+ */
+Nfa from_symbol_classes(const Nfa& aut, const SymbolClasses& classes);
+
+} // namespace Mata::Nfa.
+
+#endif // MATA_SYMBOL_CLASSES_HH
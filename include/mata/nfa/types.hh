@@ -7,12 +7,24 @@
 #include "mata/parser/parser.hh"
 
 #include <memory>
+#include <cstdint>
 
 namespace Mata::Nfa {
 
 extern const std::string TYPE_NFA;
 
+#ifndef MATA_STATE_BITS
+#define MATA_STATE_BITS 64
+#endif
+
+/// State of an automaton. Its width is selected at build time by the CMake option @c MATA_STATE_BITS.
+#if MATA_STATE_BITS == 32
+using State = uint32_t;
+#elif MATA_STATE_BITS == 64
 using State = unsigned long;
+#else
+#error "MATA_STATE_BITS has to be either 32 or 64."
+#endif
 using StateSet = Mata::Util::OrdVector<State>;
 
 template<typename T> using Set = Mata::Util::OrdVector<T>;
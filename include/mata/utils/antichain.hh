@@ -0,0 +1,201 @@
+/* antichain.hh -- Antichain of sets with indexed subsumption checks.
+ *
+ * This file is a part of libmata.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#ifndef MATA_ANTICHAIN_HH
+#define MATA_ANTICHAIN_HH
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "bit-words.hh"
+
+namespace Mata::Util {
+
+/**
+ * Sets of an @c Antichain given as sorted sequences of numbers without duplicates.
+ */
+template<typename Number>
+struct SortedSetTraits {
+    static size_t cardinality(const std::span<const Number> set) { return set.size(); }
+
+    /// Bloom-style signature with bit h(n) set for each number n of @p set.
+    static uint64_t signature(const std::span<const Number> set) {
+        uint64_t signature{ 0 };
+        for (const Number number: set) {
+            // Fibonacci hashing of the number to one of the 64 bits.
+            signature |= uint64_t{ 1 } << ((static_cast<uint64_t>(number) * 0x9e3779b97f4a7c15ULL) >> 58);
+        }
+        return signature;
+    }
+
+    static bool is_subset(const std::span<const Number> lhs, const std::span<const Number> rhs) {
+        return std::includes(rhs.begin(), rhs.end(), lhs.begin(), lhs.end());
+    }
+};
+
+/**
+ * Sets of an @c Antichain given as bit sets of the same number of words (see @c BitWords).
+ */
+struct BitSetTraits {
+    static size_t cardinality(const std::span<const uint64_t> set) {
+        size_t cardinality{ 0 };
+        for (const uint64_t word: set) { cardinality += static_cast<size_t>(std::popcount(word)); }
+        return cardinality;
+    }
+
+    /// Words of @p set, each rotated by its index, folded by OR. Folding and rotating keep the inclusion of sets.
+    static uint64_t signature(const std::span<const uint64_t> set) {
+        uint64_t signature{ 0 };
+        for (size_t i{ 0 }; i < set.size(); ++i) { signature |= std::rotl(set[i], static_cast<int>(i % 64)); }
+        return signature;
+    }
+
+    static bool is_subset(const std::span<const uint64_t> lhs, const std::span<const uint64_t> rhs) {
+        return BitWords::is_subset(lhs.data(), rhs.data(), lhs.size());
+    }
+};
+
+/**
+ * @brief Antichain of elements (bucket, set) ordered by inclusion of the sets within the same bucket.
+ *
+ * Meant for antichain-based inclusion and universality checking, where the bucket is a state of the smaller automaton
+ *  (or always 0) and the set is a macrostate of the bigger one. Each element carries a value (e.g., an id of the
+ *  macrostate) and is identified by a handle which stays valid after the element is removed, so that worklists can
+ *  hold handles and skip removed elements (see @c is_alive()).
+ *
+ * Elements of a bucket are indexed by the cardinality of their sets, so subsumption checks only visit sets which are
+ *  not too big or too small. Each set also has a 64-bit signature which is monotone in the set, that is, set A can
+ *  be a subset of set B only if (sig(A) & ~sig(B)) == 0. This rules out most pairs without looking at the sets.
+ *
+ * @tparam Number Type of numbers of the sequences representing the sets.
+ * @tparam Value Type of values attached to the elements.
+ * @tparam SetTraits Representation of the sets: @c SortedSetTraits for sorted sequences without duplicates,
+ *  @c BitSetTraits for bit sets.
+ */
+template<typename Number, typename Value, typename SetTraits = SortedSetTraits<Number>>
+class Antichain {
+public:
+    using Handle = size_t;
+
+    /**
+     * @return True iff there is an element in @p bucket whose set is a subset of @p set.
+     */
+    bool contains_subset_of(const size_t bucket, const std::span<const Number> set) const {
+        if (bucket >= buckets.size()) { return false; }
+        const uint64_t signature{ SetTraits::signature(set) };
+        const std::vector<std::vector<Handle>>& by_cardinality{ buckets[bucket] };
+        const size_t max_cardinality{ std::min(SetTraits::cardinality(set) + 1, by_cardinality.size()) };
+        for (size_t cardinality{ 0 }; cardinality < max_cardinality; ++cardinality) {
+            for (const Handle handle: by_cardinality[cardinality]) {
+                const Element& element{ elements[handle] };
+                if ((element.signature & ~signature) != 0) { continue; }
+                if (SetTraits::is_subset(get_set(handle), set)) { return true; }
+            }
+        }
+        return false;
+    }
+
+    /**
+     * Remove all elements of @p bucket whose sets are supersets of @p set.
+     * @return Number of removed elements.
+     */
+    size_t remove_supersets_of(const size_t bucket, const std::span<const Number> set) {
+        if (bucket >= buckets.size()) { return 0; }
+        const uint64_t signature{ SetTraits::signature(set) };
+        std::vector<std::vector<Handle>>& by_cardinality{ buckets[bucket] };
+        size_t num_of_removed{ 0 };
+        for (size_t cardinality{ SetTraits::cardinality(set) }; cardinality < by_cardinality.size(); ++cardinality) {
+            std::vector<Handle>& handles{ by_cardinality[cardinality] };
+            for (size_t i{ 0 }; i < handles.size();) {
+                Element& element{ elements[handles[i]] };
+                if ((signature & ~element.signature) == 0 && SetTraits::is_subset(set, get_set(handles[i]))) {
+                    element.is_alive = false;
+                    handles[i] = handles.back();
+                    handles.pop_back();
+                    ++num_of_removed;
+                } else {
+                    ++i;
+                }
+            }
+        }
+        num_of_alive -= num_of_removed;
+        return num_of_removed;
+    }
+
+    /**
+     * Insert element (@p bucket, @p set) with @p value. The antichain property is maintained by the caller, which
+     *  checks @c contains_subset_of() and calls @c remove_supersets_of() first.
+     * @return Handle of the inserted element.
+     */
+    Handle insert(const size_t bucket, const std::span<const Number> set, Value value) {
+        const Handle handle{ elements.size() };
+        elements.push_back({ bucket, numbers.size(), set.size(), SetTraits::signature(set), std::move(value), true });
+        numbers.insert(numbers.end(), set.begin(), set.end());
+        if (bucket >= buckets.size()) { buckets.resize(bucket + 1); }
+        std::vector<std::vector<Handle>>& by_cardinality{ buckets[bucket] };
+        const size_t cardinality{ SetTraits::cardinality(set) };
+        if (cardinality >= by_cardinality.size()) { by_cardinality.resize(cardinality + 1); }
+        by_cardinality[cardinality].push_back(handle);
+        ++num_of_alive;
+        return handle;
+    }
+
+    /**
+     * @return False iff the element @p handle has been removed.
+     */
+    bool is_alive(const Handle handle) const { return elements[handle].is_alive; }
+    size_t get_bucket(const Handle handle) const { return elements[handle].bucket; }
+    const Value& get_value(const Handle handle) const { return elements[handle].value; }
+    std::span<const Number> get_set(const Handle handle) const {
+        const Element& element{ elements[handle] };
+        return { numbers.data() + element.offset, element.size };
+    }
+
+    /**
+     * @return Number of elements in the antichain (not counting the removed ones).
+     */
+    size_t size() const { return num_of_alive; }
+    bool empty() const { return num_of_alive == 0; }
+
+    void clear() {
+        elements.clear();
+        numbers.clear();
+        buckets.clear();
+        num_of_alive = 0;
+    }
+
+private:
+    struct Element {
+        size_t bucket;
+        size_t offset; ///< Position of the first number of the set in @c numbers.
+        size_t size; ///< Length of the sequence of numbers of the set.
+        uint64_t signature;
+        Value value;
+        bool is_alive;
+    };
+
+    std::vector<Element> elements{}; ///< All inserted elements, indexed by handles.
+    std::vector<Number> numbers{}; ///< Numbers of sets of all inserted elements, one set after another.
+    /// Handles of alive elements of each bucket, by the cardinality of their sets.
+    std::vector<std::vector<std::vector<Handle>>> buckets{};
+    size_t num_of_alive{ 0 };
+}; // class Antichain.
+
+} // namespace Mata::Util.
+
+#endif // MATA_ANTICHAIN_HH
@@ -0,0 +1,152 @@
+/* bit-words.hh -- Operations on sets of numbers represented as arrays of 64-bit words.
+ *
+ * This file is a part of libmata.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#ifndef MATA_BIT_WORDS_HH
+#define MATA_BIT_WORDS_HH
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+/**
+ * Bit sets of a fixed width, stored as arrays of @c num_of_words 64-bit words, where number n is in the set iff bit
+ *  n % 64 of word n / 64 is set. The operations are vectorized with AVX2 or SSE2 when the compiler targets them and
+ *  fall back to plain word-wise loops otherwise.
+ */
+namespace Mata::Util::BitWords {
+
+constexpr size_t BITS_IN_WORD{ 64 };
+
+/**
+ * @return Number of words needed for a bit set of numbers smaller than @p domain_size.
+ */
+inline size_t num_of_words(size_t domain_size) { return (domain_size + BITS_IN_WORD - 1) / BITS_IN_WORD; }
+
+inline void set(uint64_t* words, size_t number) {
+    words[number / BITS_IN_WORD] |= uint64_t{ 1 } << (number % BITS_IN_WORD);
+}
+
+inline bool test(const uint64_t* words, size_t number) {
+    return (words[number / BITS_IN_WORD] >> (number % BITS_IN_WORD)) & 1;
+}
+
+/**
+ * Compute @p target := @p target | @p source.
+ */
+inline void unite(uint64_t* target, const uint64_t* source, size_t num_of_words) {
+    size_t i{ 0 };
+#if defined(__AVX2__)
+    for (; i + 4 <= num_of_words; i += 4) {
+        const __m256i lhs{ _mm256_loadu_si256(reinterpret_cast<const __m256i*>(target + i)) };
+        const __m256i rhs{ _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + i)) };
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(target + i), _mm256_or_si256(lhs, rhs));
+    }
+#elif defined(__SSE2__)
+    for (; i + 2 <= num_of_words; i += 2) {
+        const __m128i lhs{ _mm_loadu_si128(reinterpret_cast<const __m128i*>(target + i)) };
+        const __m128i rhs{ _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i)) };
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(target + i), _mm_or_si128(lhs, rhs));
+    }
+#endif
+    for (; i < num_of_words; ++i) { target[i] |= source[i]; }
+}
+
+/**
+ * @return True iff @p lhs is a subset of @p rhs, that is, (lhs & ~rhs) == 0.
+ */
+inline bool is_subset(const uint64_t* lhs, const uint64_t* rhs, size_t num_of_words) {
+    size_t i{ 0 };
+#if defined(__AVX2__)
+    for (; i + 4 <= num_of_words; i += 4) {
+        const __m256i lhs_words{ _mm256_loadu_si256(reinterpret_cast<const __m256i*>(lhs + i)) };
+        const __m256i rhs_words{ _mm256_loadu_si256(reinterpret_cast<const __m256i*>(rhs + i)) };
+        // testc(a, b) is 1 iff (~a & b) == 0.
+        if (!_mm256_testc_si256(rhs_words, lhs_words)) { return false; }
+    }
+#elif defined(__SSE2__)
+    for (; i + 2 <= num_of_words; i += 2) {
+        const __m128i lhs_words{ _mm_loadu_si128(reinterpret_cast<const __m128i*>(lhs + i)) };
+        const __m128i rhs_words{ _mm_loadu_si128(reinterpret_cast<const __m128i*>(rhs + i)) };
+        const __m128i outside{ _mm_andnot_si128(rhs_words, lhs_words) };
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(outside, _mm_setzero_si128())) != 0xFFFF) { return false; }
+    }
+#endif
+    for (; i < num_of_words; ++i) {
+        if ((lhs[i] & ~rhs[i]) != 0) { return false; }
+    }
+    return true;
+}
+
+/**
+ * @return True iff @p lhs and @p rhs have a common element.
+ */
+inline bool intersects(const uint64_t* lhs, const uint64_t* rhs, size_t num_of_words) {
+    size_t i{ 0 };
+#if defined(__AVX2__)
+    for (; i + 4 <= num_of_words; i += 4) {
+        const __m256i lhs_words{ _mm256_loadu_si256(reinterpret_cast<const __m256i*>(lhs + i)) };
+        const __m256i rhs_words{ _mm256_loadu_si256(reinterpret_cast<const __m256i*>(rhs + i)) };
+        if (!_mm256_testz_si256(lhs_words, rhs_words)) { return true; }
+    }
+#elif defined(__SSE2__)
+    for (; i + 2 <= num_of_words; i += 2) {
+        const __m128i lhs_words{ _mm_loadu_si128(reinterpret_cast<const __m128i*>(lhs + i)) };
+        const __m128i rhs_words{ _mm_loadu_si128(reinterpret_cast<const __m128i*>(rhs + i)) };
+        const __m128i common{ _mm_and_si128(lhs_words, rhs_words) };
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(common, _mm_setzero_si128())) != 0xFFFF) { return true; }
+    }
+#endif
+    for (; i < num_of_words; ++i) {
+        if ((lhs[i] & rhs[i]) != 0) { return true; }
+    }
+    return false;
+}
+
+inline bool is_empty(const uint64_t* words, size_t num_of_words) {
+    for (size_t i{ 0 }; i < num_of_words; ++i) {
+        if (words[i] != 0) { return false; }
+    }
+    return true;
+}
+
+inline size_t hash(const uint64_t* words, size_t num_of_words) {
+    size_t hash{ 0x9e3779b97f4a7c15ULL };
+    for (size_t i{ 0 }; i < num_of_words; ++i) {
+        hash ^= static_cast<size_t>(words[i]) + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2);
+    }
+    return hash;
+}
+
+/**
+ * Call @p function(number) for every number in the set, in the increasing order.
+ */
+template<typename Function>
+void for_each(const uint64_t* words, size_t num_of_words, Function function) {
+    for (size_t i{ 0 }; i < num_of_words; ++i) {
+        uint64_t word{ words[i] };
+        while (word != 0) {
+            function(i * BITS_IN_WORD + static_cast<size_t>(std::countr_zero(word)));
+            word &= word - 1;
+        }
+    }
+}
+
+} // namespace Mata::Util::BitWords.
+
+#endif // MATA_BIT_WORDS_HH
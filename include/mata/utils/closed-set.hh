@@ -401,7 +401,7 @@ ClosedSet<T> ClosedSet<T>::complement() const {
         // which will be then (possibly) removed.
         Node initialValues{};
         for(long unsigned i = 0; i <= max_val_; ++i) {
-            initialValues.insert(i);
+            initialValues.insert(static_cast<T>(i));
         }
         result.insert(initialValues);
 
@@ -0,0 +1,84 @@
+/* k-way-merge.hh -- Merging of many sorted ranges.
+ *
+ * This file is a part of libmata.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#ifndef MATA_K_WAY_MERGE_HH
+#define MATA_K_WAY_MERGE_HH
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+namespace Mata::Util {
+
+/**
+ * @brief Merge of k sorted ranges into one sorted sequence without duplicates.
+ *
+ * Ranges are added by add() and merged by merge() using a binary heap of the current heads of the ranges, in
+ *  O(n log k) for n elements in k ranges. Used for unions of target sets of many moves (for instance, in the subset
+ *  construction), where unions of pairs of sets would be O(n k). The heap is kept between merges, so a single merger
+ *  can be reused without allocating.
+ *
+ * @tparam T Type of elements of the ranges, ordered by @c operator<.
+ */
+template<typename T>
+class KWayMerger {
+public:
+    /**
+     * Add sorted range [@p first, @p last) without duplicates to be merged by the next call of merge().
+     */
+    void add(const T* first, const T* last) {
+        if (first != last) { heads.emplace_back(first, last); }
+    }
+
+    /**
+     * Merge all ranges added since the last merge into @p result, replacing its previous content.
+     */
+    void merge(std::vector<T>& result) {
+        result.clear();
+        if (heads.size() == 1) {
+            result.assign(heads.front().first, heads.front().second);
+            heads.clear();
+            return;
+        }
+
+        // Min-heap on the current heads of the ranges.
+        const auto greater_head = [](const Range& lhs, const Range& rhs) { return *rhs.first < *lhs.first; };
+        std::make_heap(heads.begin(), heads.end(), greater_head);
+        while (!heads.empty()) {
+            std::pop_heap(heads.begin(), heads.end(), greater_head);
+            Range& smallest{ heads.back() };
+            if (result.empty() || result.back() < *smallest.first) { result.push_back(*smallest.first); }
+            ++smallest.first;
+            if (smallest.first == smallest.second) {
+                heads.pop_back();
+            } else {
+                std::push_heap(heads.begin(), heads.end(), greater_head);
+            }
+        }
+    }
+
+    /**
+     * Forget all ranges added since the last merge.
+     */
+    void clear() { heads.clear(); }
+
+private:
+    using Range = std::pair<const T*, const T*>;
+    std::vector<Range> heads{}; ///< Remaining parts of the ranges to merge.
+}; // class KWayMerger.
+
+} // namespace Mata::Util.
+
+#endif // MATA_K_WAY_MERGE_HH
@@ -19,6 +19,9 @@
 #include <vector>
 #include <algorithm>
 #include <cassert>
+#include <concepts>
+#include <memory>
+#include <type_traits>
 
 #include "util.hh"
 
@@ -47,7 +50,7 @@ std::string ToString(const T& n) {
 
 namespace Mata::Util {
 
-template <class Key> class OrdVector;
+template <class Key, class Allocator = std::allocator<Key>> class OrdVector;
 
 template <class T>
 bool are_disjoint(const Util::OrdVector<T>& lhs, const Util::OrdVector<T>& rhs) {
@@ -61,8 +64,8 @@ bool are_disjoint(const Util::OrdVector<T>& lhs, const Util::OrdVector<T>& rhs)
     return true;
 }
 
-template <class Key>
-bool is_sorted(const std::vector<Key>& vec) {
+template <class Key, class Allocator>
+bool is_sorted(const std::vector<Key, Allocator>& vec) {
     for (auto itVec = vec.cbegin() + 1; itVec < vec.cend(); ++itVec) {
         if (!(*(itVec - 1) < *itVec)) {
             // In case there is an unordered pair (or there is one element twice).
@@ -80,12 +83,16 @@ bool is_sorted(const std::vector<Key>& vec) {
  *
  * @tparam  Key  Key type: type of the elements contained in the container.
  *               Each elements in a set is also its key.
+ * @tparam  Allocator  Allocator of the underlying vector. Ordered vectors created by the set operations (@c Union(),
+ *                     @c intersection(), ...) use a default-constructed allocator.
  */
-template<class Key> class OrdVector {
+template<class Key, class Allocator> class OrdVector {
 private:  // Private data types
-    using VectorType = std::vector<Key>;
+    using VectorType = std::vector<Key, Allocator>;
 
 public:   // Public data types
+    using value_type = Key;
+    using allocator_type = Allocator;
     using iterator = typename VectorType::iterator ;
     using const_iterator = typename VectorType::const_iterator;
     using const_reference = typename VectorType::const_reference;
@@ -97,16 +104,50 @@ private:  // Private data members
 private:  // Private methods
     bool vectorIsSorted() const { return(Mata::Util::is_sorted(vec_)); }
 
+    template<class K>
+    void insert_element(K&& x) {
+        assert(vectorIsSorted());
+
+        reserve_on_insert(vec_);
+
+        if (vec_.empty() || vec_.back() < x) {
+            // For the case which would be prevalent, that is, the added thing is larger than the largest thing and
+            //  can be just pushed back.
+            vec_.emplace_back(std::forward<K>(x));
+            return;
+        }
+
+        // Perform binary search (cannot use std::binary_search because it does not return the iterator to the
+        //  position of the desirable insertion in case the searched element is not present in the range).
+        const auto position{ std::lower_bound(vec_.begin(), vec_.end(), x) };
+        if (position != vec_.end() && *position == x) { return; }
+
+        // Shifts the larger elements by moving them, so elements owning memory are not reallocated.
+        vec_.insert(position, std::forward<K>(x));
+
+        assert(vectorIsSorted());
+    }
+
 public:
     OrdVector() : vec_() {}
+    explicit OrdVector(const Allocator& alloc) : vec_(alloc) {}
     explicit OrdVector(const VectorType& vec) : vec_(vec) { Util::sort_and_rmdupl(vec_); }
     explicit OrdVector(const std::set<Key>& set): vec_{ set.begin(), set.end() } { Util::sort_and_rmdupl(vec_); }
-    template <class T>
+    template <class T> requires requires(const T& set) { set.begin(); set.end(); }
     explicit OrdVector(const T & set) : vec_(set.begin(), set.end()) { Util::sort_and_rmdupl(vec_); }
-    OrdVector(std::initializer_list<Key> list) : vec_(list) { Util::sort_and_rmdupl(vec_); }
+    OrdVector(std::initializer_list<Key> list, const Allocator& alloc = Allocator())
+        : vec_(list, alloc) { Util::sort_and_rmdupl(vec_); }
     OrdVector(const OrdVector& rhs) = default;
     OrdVector(OrdVector&& other) noexcept : vec_{ std::move(other.vec_) } {}
-    explicit OrdVector(const Key& key) : vec_(1, key) { assert(vectorIsSorted()); }
+    explicit OrdVector(const Key& key, const Allocator& alloc = Allocator()) : vec_(1, key, alloc) {
+        assert(vectorIsSorted());
+    }
+    /// Move @p other, reallocating its elements by @p alloc if it is not equal to the allocator of @p other.
+    OrdVector(OrdVector&& other, const Allocator& alloc) : vec_(std::move(other.vec_), alloc) {}
+    /// Copy @p other, which may use another allocator, allocating the elements by @p alloc.
+    template<class OtherAllocator>
+    OrdVector(const OrdVector<Key, OtherAllocator>& other, const Allocator& alloc)
+        : vec_(other.cbegin(), other.cend(), alloc) {}
     template <class InputIterator>
     explicit OrdVector(InputIterator first, InputIterator last) : vec_(first, last) { Util::sort_and_rmdupl(vec_); }
 
@@ -115,11 +156,18 @@ public:
         return *this;
     }
 
-    OrdVector& operator=(OrdVector&& other) noexcept {
+    OrdVector& operator=(OrdVector&& other) noexcept(std::is_nothrow_move_assignable_v<VectorType>) {
         if (&other != this) { vec_ = std::move(other.vec_); }
         return *this;
     }
 
+    /// Copy the elements of @p other, which uses another allocator, keeping the allocator of @c this.
+    template<class OtherAllocator>
+    OrdVector& operator=(const OrdVector<Key, OtherAllocator>& other) {
+        vec_.assign(other.cbegin(), other.cend());
+        return *this;
+    }
+
     virtual ~OrdVector() = default;
 
     /**
@@ -146,54 +194,23 @@ public:
         vec_.emplace_back(x);
     }
 
-    virtual inline void reserve(size_t  size) { vec_.reserve(size); }
-
-    virtual inline void erase(const_iterator first, const_iterator last) { vec_.erase(first, last); }
-
-    virtual void insert(const Key& x) {
-        assert(vectorIsSorted());
-
+    virtual inline void push_back(Key&& x) {
         reserve_on_insert(vec_);
+        vec_.emplace_back(std::move(x));
+    }
 
-        // perform binary search (cannot use std::binary_search because it is
-        // ineffective due to not returning the iterator to the position of the
-        // desirable insertion in case the searched element is not present in the
-        // range)
-        size_t first = 0;
-        size_t last = vec_.size();
-
-        if ((last != 0) && (vec_.back() < x))
-        {	// for the case which would be prevalent
-            // that is, the added thing can is larger than the largest thing and can be just bushed back
-            vec_.push_back(x);
-            return;
-        }
-
-        while (first < last)
-        {	// while the pointers do not overlap
-            size_t middle = first + (last - first) / 2;
-            if (vec_[middle] == x)
-            {	// in case we found x
-                return;
-            }
-            else if (vec_[middle] < x)
-            {	// in case middle is less than x
-                first = middle + 1;
-            }
-            else
-            {	// in case middle is greater than x
-                last = middle;
-            }
-        }
+    virtual inline void reserve(size_t  size) { vec_.reserve(size); }
 
-        vec_.resize(vec_.size() + 1);
-        std::copy_backward(vec_.begin() + static_cast<long>(first), vec_.end() - 1, vec_.end());
+    virtual inline void erase(const_iterator first, const_iterator last) { vec_.erase(first, last); }
 
-        // insert the new element
-        vec_[first] = x;
+    virtual void insert(const Key& x) { insert_element(x); }
 
-        assert(vectorIsSorted());
-    }
+    /**
+     * Insert @p x, moving it into the vector instead of copying it.
+     *
+     * Preferable for elements owning heap memory (such as @c Move), for which a copy means another allocation.
+     */
+    virtual void insert(Key&& x) { insert_element(std::move(x)); }
 
     virtual void insert(const OrdVector& vec) {
         assert(vectorIsSorted());
@@ -204,8 +221,14 @@ public:
         assert(vectorIsSorted());
     }
 
+    /// Insert the elements of @p vec, which uses another allocator.
+    template<class OtherAllocator>
+    void insert(const OrdVector<Key, OtherAllocator>& vec) { insert(OrdVector(vec, vec_.get_allocator())); }
+
     inline void clear() { vec_.clear(); }
 
+    allocator_type get_allocator() const { return vec_.get_allocator(); }
+
     virtual inline size_t size() const { return vec_.size(); }
 
     inline size_t count(const Key& key) const {
@@ -334,6 +357,10 @@ public:
 		return (vec_ == rhs.vec_);
 	}
     bool operator!=(const OrdVector& rhs) const { return !(*this == rhs); }
+    template<class OtherAllocator> requires (!std::same_as<OtherAllocator, Allocator>)
+    bool operator==(const OrdVector<Key, OtherAllocator>& rhs) const {
+        return std::equal(cbegin(), cend(), rhs.cbegin(), rhs.cend());
+    }
 
     bool operator<(const OrdVector& rhs) const {
         assert(vectorIsSorted());
@@ -341,7 +368,11 @@ public:
         return std::lexicographical_compare(vec_.begin(), vec_.end(), rhs.vec_.begin(), rhs.vec_.end());
     }
 
-    const std::vector<Key>& ToVector() const { return vec_; }
+    const std::vector<Key>& ToVector() const requires std::same_as<Allocator, std::allocator<Key>> { return vec_; }
+    /// Copy of the elements in a @c std::vector, for ordered vectors with other allocators.
+    std::vector<Key> ToVector() const requires (!std::same_as<Allocator, std::allocator<Key>>) {
+        return { vec_.begin(), vec_.end() };
+    }
 
     bool IsSubsetOf(const OrdVector& bigger) const {
         return std::includes(bigger.cbegin(), bigger.cend(), this->cbegin(), this->cend());
@@ -16,6 +16,8 @@
 #ifndef MATA_SYNCHRONIZED_ITERATOR_HH
 #define MATA_SYNCHRONIZED_ITERATOR_HH
 
+#include <span>
+
 #include "ord-vector.hh"
 
 namespace Mata::Util {
@@ -134,6 +136,7 @@ public:
             if (this->positions[i] == this->ends[i]) { return false; }
 
             //  Advance position[i] and position[0] to the closest equal values.
+            bool moved_first = false;
             while (*this->positions[i] != *this->positions[0]) {
 
                 // Advance position[i] to or beyond position[0].
@@ -145,17 +148,14 @@ public:
                 // Advance position[0] to or beyond position[i].
                 while (*this->positions[i] > *this->positions[0]) {
                     ++this->positions[0];
+                    moved_first = true;
                     if (this->positions[0] == this->ends[0]) { return false; }
                 }
-
-                // If position[0] changed, start from position 1 again.
-                // (note that
-                // i gets incremented at the end of the for-loop body,
-                // and that,
-                // since we are inside the for, there are at least two positions
-                // as the for starts with i=1.)
-                if (this->positions[0] > this->positions[1]) { i=0; }
             }
+
+            // If position[0] changed, positions 1, ..., i-1 are no longer synchronized with it, start from position 1
+            // again. (Note that i gets incremented at the end of the for-loop body.)
+            if (moved_first) { i = 0; }
         }
         this->synchronized_at_current_minimum = true;
         return true;
@@ -169,6 +169,12 @@ public:
         return this->positions;
     };
 
+    /**
+     * Set @p current to a view of the current positions, without copying them.
+     * The view is invalidated by the next call of advance(), push_back() or reset().
+     */
+    void get_current(std::span<const Iterator>& current) const { current = this->positions; }
+
     explicit SynchronizedUniversalIterator(const size_t size=0) : SynchronizedIterator<Iterator>(size) {};
 
     void reset(const size_t size = 0) {
@@ -252,6 +258,12 @@ public:
      */
     std::vector<Iterator> get_current() { return this->currently_synchronized; };
 
+    /**
+     * Set @p current to a view of the current still active positions, without copying them.
+     * The view is invalidated by the next call of advance(), push_back() or reset().
+     */
+    void get_current(std::span<const Iterator>& current) const { current = this->currently_synchronized; }
+
     void push_back (const Iterator &begin, const Iterator &end) {
 
         // Empty vector would not have any effect (unlike in the case of the universal iterator).
@@ -0,0 +1,68 @@
+/* threads.hh -- Starting threads of parallel algorithms.
+ *
+ * This file is a part of libmata.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#ifndef MATA_THREADS_HH
+#define MATA_THREADS_HH
+
+#include <algorithm>
+#include <barrier>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+namespace Mata::Util {
+
+/// More threads than this many per hardware thread only add contention, larger numbers of threads are capped.
+constexpr size_t MAX_THREADS_PER_HARDWARE_THREAD{ 4 };
+
+/**
+ * Number of threads to use when @p num_of_threads threads are requested: 0 means the number of hardware threads,
+ *  numbers above @c MAX_THREADS_PER_HARDWARE_THREAD times the number of hardware threads are capped.
+ */
+inline size_t get_num_of_threads(const size_t num_of_threads) {
+    const size_t num_of_hardware_threads{ std::max(std::thread::hardware_concurrency(), 1U) };
+    if (num_of_threads == 0) { return num_of_hardware_threads; }
+    return std::min(num_of_threads, MAX_THREADS_PER_HARDWARE_THREAD * num_of_hardware_threads);
+}
+
+/**
+ * @brief Run @p work in @p num_of_threads threads taking part in @p barrier, and wait for all of them to finish.
+ *
+ * @p work is called with the index of the thread: 0 in the calling thread, 1, ..., num_of_threads - 1 in new threads.
+ *  When a thread cannot be started, the threads with this and higher indices drop out of @p barrier, so that the
+ *  started threads do not wait for them, and their work is not run. Therefore, @p work has to split the work
+ *  dynamically between the threads which actually run.
+ *
+ * @param[in] num_of_threads Number of threads @p barrier was constructed for, at least 1.
+ * @param[in] barrier Barrier synchronizing the threads.
+ * @param[in] work Work of each thread, called as work(index).
+ */
+template<class CompletionFunction, class Work>
+void run_threads(const size_t num_of_threads, std::barrier<CompletionFunction>& barrier, const Work& work) {
+    std::vector<std::thread> threads{};
+    threads.reserve(num_of_threads - 1);
+    try {
+        for (size_t thread{ 1 }; thread < num_of_threads; ++thread) { threads.emplace_back(work, thread); }
+    } catch (...) {
+        // The started threads have not passed the first phase yet, since the calling thread has not arrived.
+        for (size_t thread{ threads.size() + 1 }; thread < num_of_threads; ++thread) { barrier.arrive_and_drop(); }
+    }
+    work(size_t{ 0 });
+    for (std::thread& thread: threads) { thread.join(); }
+}
+
+} // namespace Mata::Util.
+
+#endif // MATA_THREADS_HH.
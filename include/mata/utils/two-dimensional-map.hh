@@ -0,0 +1,219 @@
+/* two-dimensional-map.hh -- Map from pairs of non-negative numbers to values.
+ *
+ * This file is a part of libmata.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#ifndef MATA_TWO_DIMENSIONAL_MAP_HH
+#define MATA_TWO_DIMENSIONAL_MAP_HH
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace Mata::Util {
+
+/**
+ * @brief Map from pairs (first, second) of non-negative numbers with known upper bounds to values.
+ *
+ * Meant for product constructions, mapping pairs of states of the operands to the product states. A pair is packed
+ *  into a single 64-bit key first * second_size + second. When the number of all possible pairs fits into the given
+ *  budget, the map is a dense matrix indexed directly by the packed key. The matrix is allocated lazily by pages of
+ *  cells, so that a map which gets only a few pairs (for instance, in a product construction stopping early) does not
+ *  pay for the whole matrix. Otherwise, it is a flat open-addressing hash table with robin-hood probing, storing keys
+ *  and values inline without any per-entry allocations.
+ *
+ * @tparam Number Type of both components of the pairs.
+ * @tparam Value Type of mapped values. Value @c Empty is reserved to mark missing entries and cannot be stored.
+ */
+template<typename Number, typename Value, Value Empty = std::numeric_limits<Value>::max()>
+class TwoDimensionalMap {
+    static_assert(std::is_unsigned<Number>::value, "TwoDimensionalMap is indexed by unsigned integers");
+
+public:
+    /// Maximal number of cells of the dense matrix used when the constructor is not given an explicit budget.
+    static constexpr size_t DEFAULT_MATRIX_BUDGET{ 1 << 20 };
+
+    /**
+     * Create an empty map for pairs (first, second) where first < @p first_size and second < @p second_size.
+     * @param[in] matrix_budget Maximal number of cells of the dense matrix. If there are more possible pairs, the hash
+     *  table is used.
+     */
+    TwoDimensionalMap(size_t first_size, size_t second_size, size_t matrix_budget = DEFAULT_MATRIX_BUDGET)
+        : first_size_{ first_size }, second_size_{ second_size },
+          is_matrix_{ second_size == 0 || first_size <= matrix_budget / second_size } {
+        assert(second_size == 0 || first_size <= std::numeric_limits<uint64_t>::max() / second_size);
+        if (is_matrix_) {
+            matrix_pages_.resize((first_size * second_size + MATRIX_PAGE_SIZE - 1) / MATRIX_PAGE_SIZE);
+        } else {
+            table_.resize(INITIAL_TABLE_SIZE);
+        }
+    }
+
+    /**
+     * @return Value mapped to (@p first, @p second), or @c Empty if there is none.
+     */
+    Value get(Number first, Number second) const {
+        const uint64_t key{ pack(first, second) };
+        if (is_matrix_) {
+            const std::unique_ptr<Value[]>& page{ matrix_pages_[key / MATRIX_PAGE_SIZE] };
+            return page ? page[key % MATRIX_PAGE_SIZE] : Empty;
+        }
+
+        const size_t mask{ table_.size() - 1 };
+        size_t index{ hash(key) & mask };
+        for (uint32_t distance{ 1 }; distance <= table_[index].distance; ++distance) {
+            if (table_[index].key == key) { return table_[index].value; }
+            index = (index + 1) & mask;
+        }
+        return Empty;
+    }
+
+    bool contains(Number first, Number second) const { return get(first, second) != Empty; }
+
+    /**
+     * Map (@p first, @p second) to @p value, overwriting the previous value if there was any.
+     */
+    void insert(Number first, Number second, Value value) {
+        assert(value != Empty);
+        const uint64_t key{ pack(first, second) };
+        if (is_matrix_) {
+            std::unique_ptr<Value[]>& page{ matrix_pages_[key / MATRIX_PAGE_SIZE] };
+            if (!page) {
+                page = std::make_unique_for_overwrite<Value[]>(MATRIX_PAGE_SIZE);
+                std::fill(page.get(), page.get() + MATRIX_PAGE_SIZE, Empty);
+            }
+            Value& cell{ page[key % MATRIX_PAGE_SIZE] };
+            if (cell == Empty) { ++size_; }
+            cell = value;
+            return;
+        }
+
+        if ((size_ + 1) * MAX_LOAD_DENOMINATOR > table_.size() * MAX_LOAD_NUMERATOR) { grow(); }
+        if (insert_into_table(Slot{ key, value, 1 })) { ++size_; }
+    }
+
+    /**
+     * @return Number of stored pairs.
+     */
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+    /**
+     * @return True if the map is stored as a dense matrix, false if as a hash table.
+     */
+    bool is_matrix() const { return is_matrix_; }
+
+    /**
+     * Call @p function(first, second, value) for every stored pair, in an unspecified order.
+     */
+    template<typename Function>
+    void for_each(Function function) const {
+        if (is_matrix_) {
+            for (size_t page_index{ 0 }; page_index < matrix_pages_.size(); ++page_index) {
+                const Value* page{ matrix_pages_[page_index].get() };
+                if (page == nullptr) { continue; }
+                for (size_t cell{ 0 }; cell < MATRIX_PAGE_SIZE; ++cell) {
+                    if (page[cell] == Empty) { continue; }
+                    const uint64_t key{ page_index * MATRIX_PAGE_SIZE + cell };
+                    function(unpack_first(key), unpack_second(key), page[cell]);
+                }
+            }
+        } else {
+            for (const Slot& slot: table_) {
+                if (slot.distance != 0) { function(unpack_first(slot.key), unpack_second(slot.key), slot.value); }
+            }
+        }
+    }
+
+private:
+    /// Slot of the hash table. Distance is the length of the probe sequence leading to the slot plus one; zero
+    ///  denotes an empty slot.
+    struct Slot {
+        uint64_t key{ 0 };
+        Value value{ Empty };
+        uint32_t distance{ 0 };
+    };
+
+    static constexpr size_t MATRIX_PAGE_SIZE{ 1 << 12 }; ///< Number of cells of a page of the matrix.
+    static constexpr size_t INITIAL_TABLE_SIZE{ 16 }; ///< Must be a power of two.
+    static constexpr size_t MAX_LOAD_NUMERATOR{ 7 }; ///< Maximal load factor of the hash table is 7/8.
+    static constexpr size_t MAX_LOAD_DENOMINATOR{ 8 };
+
+    size_t first_size_;
+    size_t second_size_;
+    bool is_matrix_;
+    size_t size_{ 0 };
+    /// Pages of the matrix, null until a pair is inserted into them.
+    std::vector<std::unique_ptr<Value[]>> matrix_pages_{};
+    std::vector<Slot> table_{};
+
+    uint64_t pack(Number first, Number second) const {
+        assert(first < first_size_ && second < second_size_);
+        return static_cast<uint64_t>(first) * second_size_ + second;
+    }
+    Number unpack_first(uint64_t key) const { return static_cast<Number>(key / second_size_); }
+    Number unpack_second(uint64_t key) const { return static_cast<Number>(key % second_size_); }
+
+    /// Mix the bits of @p key (finalizer of SplitMix64), so that consecutive keys do not fill consecutive slots.
+    static size_t hash(uint64_t key) {
+        key ^= key >> 30;
+        key *= 0xbf58476d1ce4e5b9ULL;
+        key ^= key >> 27;
+        key *= 0x94d049bb133111ebULL;
+        key ^= key >> 31;
+        return static_cast<size_t>(key);
+    }
+
+    /**
+     * Robin-hood insertion: an inserted slot takes the place of any slot closer to its home position.
+     * @return True if a new key was inserted, false if the value of an existing key was overwritten.
+     */
+    bool insert_into_table(Slot slot) {
+        const size_t mask{ table_.size() - 1 };
+        size_t index{ hash(slot.key) & mask };
+        while (true) {
+            Slot& current{ table_[index] };
+            if (current.distance == 0) {
+                current = slot;
+                return true;
+            }
+            if (current.key == slot.key) {
+                current.value = slot.value;
+                return false;
+            }
+            if (current.distance < slot.distance) { std::swap(current, slot); }
+            ++slot.distance;
+            index = (index + 1) & mask;
+        }
+    }
+
+    void grow() {
+        std::vector<Slot> old_table(table_.size() * 2);
+        std::swap(old_table, table_);
+        for (Slot& slot: old_table) {
+            if (slot.distance != 0) {
+                slot.distance = 1;
+                insert_into_table(slot);
+            }
+        }
+    }
+}; // class TwoDimensionalMap.
+
+} // namespace Mata::Util.
+
+#endif // MATA_TWO_DIMENSIONAL_MAP_HH
@@ -0,0 +1,79 @@
+/* union-find.hh -- Disjoint sets of numbers.
+ *
+ * This file is a part of libmata.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#ifndef MATA_UNION_FIND_HH
+#define MATA_UNION_FIND_HH
+
+#include <numeric>
+#include <utility>
+#include <vector>
+
+namespace Mata::Util {
+
+/**
+ * @brief Partition of numbers 0, 1, ... into disjoint sets, merged by @c unite().
+ *
+ * Union by size with path compression, so that any sequence of operations runs in almost linear time. The domain
+ *  grows on demand: numbers not seen before are singletons.
+ *
+ * @tparam Number Unsigned type of the numbers.
+ */
+template<typename Number>
+class UnionFind {
+public:
+    /**
+     * @return Representative of the set of @p number.
+     */
+    Number find(Number number) {
+        grow(number);
+        Number root{ number };
+        while (parent[root] != root) { root = parent[root]; }
+        // Path compression: link all numbers on the path directly to the root.
+        while (parent[number] != root) { number = std::exchange(parent[number], root); }
+        return root;
+    }
+
+    /**
+     * Merge the sets of @p lhs and @p rhs.
+     * @return False iff @p lhs and @p rhs have already been in the same set.
+     */
+    bool unite(Number lhs, Number rhs) {
+        lhs = find(lhs);
+        rhs = find(rhs);
+        if (lhs == rhs) { return false; }
+        if (set_size[lhs] < set_size[rhs]) { std::swap(lhs, rhs); }
+        parent[rhs] = lhs;
+        set_size[lhs] += set_size[rhs];
+        return true;
+    }
+
+    bool are_together(const Number lhs, const Number rhs) { return find(lhs) == find(rhs); }
+
+private:
+    std::vector<Number> parent{};
+    std::vector<size_t> set_size{};
+
+    void grow(const Number number) {
+        if (number < parent.size()) { return; }
+        const size_t old_size{ parent.size() };
+        parent.resize(static_cast<size_t>(number) + 1);
+        std::iota(parent.begin() + static_cast<long>(old_size), parent.end(), static_cast<Number>(old_size));
+        set_size.resize(parent.size(), 1);
+    }
+}; // class UnionFind.
+
+} // namespace Mata::Util.
+
+#endif // MATA_UNION_FIND_HH
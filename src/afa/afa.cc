@@ -66,7 +66,7 @@ void Afa::add_trans(const Trans& trans)
 			// Before the dst nodes are added to the transition, we want to get rid
 			// of redundant clauses. For example, in context of the formula
 			// (1 || (1 && 2)), the clause (1 && 2) could be deleted
-			auto cl = StateClosedSet(ClosedSetType::upward_closed_set, 0, transitionrelation.size()-1, transVec.dst);
+			auto cl = StateClosedSet(ClosedSetType::upward_closed_set, 0, static_cast<State>(transitionrelation.size() - 1), transVec.dst);
 			cl.insert(trans.dst);
 			transVec.dst = cl.antichain();
 			return;
@@ -212,7 +212,7 @@ void Afa::add_inverse_trans(const Trans& trans)
 State Afa::add_new_state() {
     transitionrelation.emplace_back();
     inverseTransRelation.emplace_back();
-    return transitionrelation.size() - 1;
+    return static_cast<State>(transitionrelation.size() - 1);
 }
 
 //***************************************************
@@ -232,7 +232,7 @@ State Afa::add_new_state() {
 * @return closed set of nodes
 */
 StateClosedSet Afa::post(const State state, const Symbol symb) const {
-	return { ClosedSetType::upward_closed_set, 0, transitionrelation.size()-1, get_trans_from_state(state, symb).dst };
+	return { ClosedSetType::upward_closed_set, 0, static_cast<State>(transitionrelation.size() - 1), get_trans_from_state(state, symb).dst };
 }
 
 /** This function takes a single node and a symbol and returns all the nodes
@@ -248,7 +248,7 @@ StateClosedSet Afa::post(const State state, const Symbol symb) const {
 StateClosedSet Afa::post(const Node& node, const Symbol symb) const
 {
 	// initially, the result is empty
-	StateClosedSet result = StateClosedSet(ClosedSetType::upward_closed_set, 0, transitionrelation.size()-1);
+	StateClosedSet result = StateClosedSet(ClosedSetType::upward_closed_set, 0, static_cast<State>(transitionrelation.size()-1));
 	if(node.empty())
 	{
 		result.insert(node);
@@ -284,7 +284,7 @@ StateClosedSet Afa::post(const Node& node, const Symbol symb) const
 StateClosedSet Afa::post(const Nodes& nodes, const Symbol symb) const
 {
 	// initially, the result is empty
-	StateClosedSet result = StateClosedSet{ ClosedSetType::upward_closed_set, 0, transitionrelation.size()-1 };
+	StateClosedSet result = StateClosedSet{ ClosedSetType::upward_closed_set, 0, static_cast<State>(transitionrelation.size() - 1) };
 	for(const auto& node : nodes)
 	{
 		result.insert(post(node, symb).antichain());
@@ -322,9 +322,9 @@ StateClosedSet Afa::post(const Node& node) const
 {
 	if(node.empty())
 	{
-		return StateClosedSet(ClosedSetType::upward_closed_set, 0, transitionrelation.size()-1, Nodes{Node{}});
+		return StateClosedSet(ClosedSetType::upward_closed_set, 0, static_cast<State>(transitionrelation.size() - 1), Nodes{Node{}});
 	}
-	StateClosedSet result = StateClosedSet(ClosedSetType::upward_closed_set, 0, transitionrelation.size()-1);
+	StateClosedSet result = StateClosedSet(ClosedSetType::upward_closed_set, 0, static_cast<State>(transitionrelation.size()-1));
 
 	// It is sufficient to access the first element of the node
 	// to collect all required symbols of the alphabet. If there is another symbol used
@@ -349,7 +349,7 @@ StateClosedSet Afa::post(const Node& node) const
 */
 StateClosedSet Afa::post(const Nodes& nodes) const
 {
-	StateClosedSet result(ClosedSetType::upward_closed_set, 0, transitionrelation.size()-1);
+	StateClosedSet result(ClosedSetType::upward_closed_set, 0, static_cast<State>(transitionrelation.size()-1));
 	for(const auto& node : nodes)
 	{
 		result.insert(post(node).antichain());
@@ -447,7 +447,7 @@ StateClosedSet Afa::pre(const Node& node, Symbol symb) const
 			}
 		}
 	}
-	return { ClosedSetType::downward_closed_set, 0, transitionrelation.size()-1, result };
+	return { ClosedSetType::downward_closed_set, 0, static_cast<State>(transitionrelation.size() - 1), result };
 } // pre }}}
 
 /** This function takes a set of nodes and a symbol and returns all the nodes
@@ -460,7 +460,7 @@ StateClosedSet Afa::pre(const Node& node, Symbol symb) const
 */
 StateClosedSet Afa::pre(const Nodes& nodes, Symbol symb) const
 {
-	StateClosedSet result(ClosedSetType::downward_closed_set, 0, transitionrelation.size()-1);
+	StateClosedSet result(ClosedSetType::downward_closed_set, 0, static_cast<State>(transitionrelation.size()-1));
 	for(const auto& node : nodes)
 	{
 		result = result.Union(pre(node, symb));
@@ -491,9 +491,9 @@ StateClosedSet Afa::pre(const Node& node) const
 {
 	if(node.empty())
 	{
-		return StateClosedSet(ClosedSetType::downward_closed_set, 0, transitionrelation.size()-1, Nodes{Node{}});
+		return StateClosedSet(ClosedSetType::downward_closed_set, 0, static_cast<State>(transitionrelation.size() - 1), Nodes{Node{}});
 	}
-	StateClosedSet result(ClosedSetType::downward_closed_set, 0, transitionrelation.size()-1);
+	StateClosedSet result(ClosedSetType::downward_closed_set, 0, static_cast<State>(transitionrelation.size()-1));
 
 	// It is sufficient to access the first element of the node
 	// to collect all required symbols of the alphabet. If there is another symbol used
@@ -514,7 +514,7 @@ StateClosedSet Afa::pre(const Node& node) const
 * @return closed set of nodes
 */
 StateClosedSet Afa::pre(const Nodes& nodes) const {
-	StateClosedSet result{ ClosedSetType::downward_closed_set, 0, transitionrelation.size() - 1 };
+	StateClosedSet result{ ClosedSetType::downward_closed_set, 0, static_cast<State>(transitionrelation.size() - 1) };
 	for(const auto& node : nodes) { result.insert(pre(node).antichain()); }
 	return result;
 } // pre }}}
@@ -544,7 +544,7 @@ size_t Afa::trans_size() const
 } // trans_size() }}}
 
 StateClosedSet Afa::get_non_final_nodes() const {
-	StateClosedSet result(ClosedSetType::upward_closed_set, 0, transitionrelation.size()-1);
+	StateClosedSet result(ClosedSetType::upward_closed_set, 0, static_cast<State>(transitionrelation.size()-1));
 	auto transSize = transitionrelation.size();
 	for(State state = 0; state < transSize; ++state)
 	{
@@ -557,7 +557,7 @@ StateClosedSet Afa::get_non_final_nodes() const {
 }
 
 StateClosedSet Afa::get_initial_nodes() const {
-    StateClosedSet result = StateClosedSet(ClosedSetType::upward_closed_set, 0, transitionrelation.size()-1);
+    StateClosedSet result = StateClosedSet(ClosedSetType::upward_closed_set, 0, static_cast<State>(transitionrelation.size()-1));
     for(const auto& node : initialstates)
     {
         result.insert(node);
@@ -648,7 +648,7 @@ bool Mata::Afa::antichain_concrete_forward_emptiness_test_old(const Afa& aut)
     // We will perform each operation directly over antichains.
     // Note that the fixed point always exists so the while loop always terminates.
     StateClosedSet goal = aut.get_non_final_nodes();
-    StateClosedSet current = StateClosedSet(ClosedSetType::upward_closed_set, 0, aut.get_num_of_states()-1);
+    StateClosedSet current = StateClosedSet(ClosedSetType::upward_closed_set, 0, static_cast<State>(aut.get_num_of_states()-1));
     StateClosedSet next = aut.get_initial_nodes();
 
     while(current != next)
@@ -721,7 +721,7 @@ bool Mata::Afa::antichain_concrete_backward_emptiness_test_old(const Afa& aut)
 	// We will perform each operation directly over antichains
 	// Note that the fixed point always exists so the while loop always terminates
 	StateClosedSet goal = aut.get_non_initial_nodes();
-	StateClosedSet current = StateClosedSet(ClosedSetType::downward_closed_set, 0, aut.get_num_of_states()-1);
+	StateClosedSet current = StateClosedSet(ClosedSetType::downward_closed_set, 0, static_cast<State>(aut.get_num_of_states()-1));
 	StateClosedSet next = aut.get_final_nodes();
 
 	while(current != next)
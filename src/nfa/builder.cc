@@ -38,6 +38,8 @@ Nfa Builder::construct(const Mata::Parser::ParsedSection& parsec, Mata::Alphabet
     };
 
 
+    aut.delta.start_bulk();
+
     auto it = parsec.dict.find("Initial");
     if (parsec.dict.end() != it)
     {
@@ -82,9 +84,11 @@ Nfa Builder::construct(const Mata::Parser::ParsedSection& parsec, Mata::Alphabet
         Symbol symbol = alphabet->translate_symb(body_line[1]);
         State tgt_state = get_state_name(body_line[2]);
 
-        aut.delta.add(src_state, symbol, tgt_state);
+        aut.delta.add_unsorted(src_state, symbol, tgt_state);
     }
 
+    aut.delta.finalize();
+
     // do the dishes and take out garbage
     clean_up();
 
@@ -122,6 +126,7 @@ Nfa Builder::construct(const Mata::IntermediateAut& inter_aut, Mata::Alphabet* a
         aut.initial.insert(state);
     }
 
+    aut.delta.start_bulk();
     for (const auto& trans : inter_aut.transitions)
     {
         if (trans.second.children.size() != 2)
@@ -140,8 +145,9 @@ Nfa Builder::construct(const Mata::IntermediateAut& inter_aut, Mata::Alphabet* a
         Symbol symbol = alphabet->translate_symb(trans.second.children[0].node.name);
         State tgt_state = get_state_name(trans.second.children[1].node.name);
 
-        aut.delta.add(src_state, symbol, tgt_state);
+        aut.delta.add_unsorted(src_state, symbol, tgt_state);
     }
+    aut.delta.finalize();
 
     std::unordered_set<std::string> final_formula_nodes;
     if (!(inter_aut.final_formula.node.is_constant())) {
@@ -172,7 +178,7 @@ Nfa Builder::construct(const Mata::IntermediateAut& inter_aut, Mata::Alphabet* a
 
 Nfa Builder::create_single_word_nfa(const std::vector<Symbol>& word) {
     const size_t word_size{ word.size() };
-    Nfa nfa{ word_size + 1, { 0 }, { word_size } };
+    Nfa nfa{ word_size + 1, { 0 }, { static_cast<State>(word_size) } };
 
     for (State state{ 0 }; state < word_size; ++state) {
         nfa.delta.add(state, word[state], state + 1);
@@ -185,7 +191,7 @@ Nfa Builder::create_single_word_nfa(const std::vector<std::string>& word, Mata::
         alphabet = new OnTheFlyAlphabet{ word };
     }
     const size_t word_size{ word.size() };
-    Nfa nfa{ word_size + 1, { 0 }, { word_size }, alphabet };
+    Nfa nfa{ word_size + 1, { 0 }, { static_cast<State>(word_size) }, alphabet };
 
     for (State state{ 0 }; state < word_size; ++state) {
         nfa.delta.add(state, alphabet->translate_symb(word[state]), state + 1);
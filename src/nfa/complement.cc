@@ -18,39 +18,44 @@
 // MATA headers
 #include "mata/nfa/nfa.hh"
 #include "mata/nfa/algorithms.hh"
+#include "mata/nfa/symbol-classes.hh"
 
 using namespace Mata::Nfa;
 using namespace Mata::Util;
 
 Nfa Mata::Nfa::Algorithms::complement_classical(const Nfa& aut, const OrdVector<Symbol>& symbols,
                                                 bool minimize_during_determinization) {
+    // Determinize and complete the automaton over classes of symbols with the same transitions, so that each class
+    //  is handled once instead of once for each of its symbols.
+    const SymbolClasses classes{ compute_symbol_classes(aut, symbols) };
+    const Nfa aut_over_classes{ to_symbol_classes(aut, classes) };
     Nfa result;
     State sink_state;
     if (minimize_during_determinization) {
-        result = minimize_brzozowski(aut); // brzozowski minimization makes it deterministic
+        result = minimize(aut_over_classes); // minimization makes it deterministic
         if (result.final.empty() && !result.initial.empty()) {
             assert(result.initial.size() == 1);
             // if automaton does not accept anything, then there is only one (initial) state
             // which can be the sink state (so we do not create unnecessary one)
             sink_state = *result.initial.begin();
         } else {
-            sink_state = result.size();
+            sink_state = static_cast<State>(result.size());
         }
     } else {
-        std::unordered_map<StateSet, State> subset_map;
-        result = determinize(aut, &subset_map);
+        MacrostateStore macrostates{};
+        result = determinize(aut_over_classes, macrostates);
         // check if a sink state was not created during determinization
-        auto sink_state_iter = subset_map.find({});
-        if (sink_state_iter != subset_map.end()) {
-            sink_state = sink_state_iter->second;
+        const MacrostateStore::Id sink_state_id{ macrostates.find(StateSet{}) };
+        if (sink_state_id != MacrostateStore::NO_ID) {
+            sink_state = sink_state_id;
         } else {
-            sink_state = result.size();
+            sink_state = static_cast<State>(result.size());
         }
     }
 
-    make_complete(result, symbols, sink_state);
-    result.final.complement(result.size());
-    return result;
+    make_complete(result, classes.get_classes_of(symbols), sink_state);
+    result.final.complement(static_cast<State>(result.size()));
+    return from_symbol_classes(result, classes);
 }
 
 Nfa Mata::Nfa::complement(const Nfa& aut, const Alphabet& alphabet, const StringMap& params) {
@@ -27,7 +27,7 @@ Nfa concatenate(const Nfa& lhs, const Nfa& rhs, bool use_epsilon,
 }
 
 Nfa& Nfa::concatenate(const Nfa& aut) {
-    size_t n = this->size();
+    State n = static_cast<State>(this->size());
     auto upd_fnc = [&](State st) {
         return st + n;
     };
@@ -36,7 +36,7 @@ Nfa& Nfa::concatenate(const Nfa& aut) {
 
     // set accepting states
     Util::SparseSet<State> new_fin{};
-    new_fin.reserve(n+aut.size());
+    new_fin.reserve(static_cast<State>(n+aut.size()));
     for(const State& aut_fin : aut.final) {
         new_fin.insert(upd_fnc(aut_fin));
     }
@@ -99,7 +99,7 @@ Nfa Algorithms::concatenate_eps(const Nfa& lhs, const Nfa& rhs, const Symbol& ep
     result = Nfa();
     result.delta = lhs.delta;
     result.initial = lhs.initial;
-    result.add_state(result_num_of_states-1);
+    result.add_state(static_cast<State>(result_num_of_states-1));
 
     // Add epsilon transitions connecting lhs and rhs automata.
     // The epsilon transitions lead from lhs original final states to rhs original initial states.
@@ -9,6 +9,7 @@
 #include <algorithm>
 #include <list>
 #include <iterator>
+#include <unordered_map>
 
 using std::tie;
 
@@ -19,8 +20,8 @@ using Mata::BoolVector;
 
 using StateBoolArray = std::vector<bool>; ///< Bool array for states in the automaton.
 
-Move& Move::operator=(Move&& rhs) noexcept {
-    if (*this != rhs) {
+Move& Move::operator=(Move&& rhs) noexcept(std::is_nothrow_move_assignable_v<Targets>) {
+    if (this != &rhs) {
         symbol = rhs.symbol;
         targets = std::move(rhs.targets);
     }
@@ -40,12 +41,29 @@ void Move::insert(State s) {
     }
 }
 
-void Move::insert(const StateSet& states) {
-    for (State s : states) {
-        insert(s);
+namespace {
+    template<class States>
+    void insert_states(Move::Targets& targets, const States& states) {
+        if (states.empty()) { return; }
+        if (targets.empty() || targets.back() < *states.cbegin()) {
+            // Appending a strictly larger block keeps the targets sorted; no merge needed.
+            targets.reserve(targets.size() + states.size());
+            for (const State s: states) { targets.push_back(s); }
+            return;
+        }
+        // Single linear merge instead of a binary search and a shift per inserted state. The merged targets are
+        //  allocated from the memory resource of the move.
+        Move::Targets merged{ targets.get_allocator() };
+        merged.reserve(targets.size() + states.size());
+        std::set_union(targets.cbegin(), targets.cend(), states.cbegin(), states.cend(), std::back_inserter(merged));
+        targets = std::move(merged);
     }
 }
 
+void Move::insert(const StateSet& states) { insert_states(targets, states); }
+
+void Move::insert(const Targets& states) { insert_states(targets, states); }
+
 Post::const_iterator Nfa::Nfa::get_epsilon_transitions(const State state, const Symbol epsilon) const {
     assert(is_state(state));
     return get_epsilon_transitions(get_moves_from(state), epsilon);
@@ -77,6 +95,8 @@ size_t Delta::size() const
 }
 
 void Delta::add(State state_from, Symbol symbol, State state_to) {
+    reverse.reset();
+    if (changes) { changes->added.emplace_back(state_from, symbol, state_to); }
     const State max_state{ std::max(state_from, state_to) };
     if (max_state >= posts.size()) {
         reserve_on_insert(posts, max_state);
@@ -85,24 +105,26 @@ void Delta::add(State state_from, Symbol symbol, State state_to) {
 
     Post& state_transitions{ posts[state_from] };
 
-    if (state_transitions.empty()) {
-        state_transitions.insert({ symbol, state_to });
-    } else if (state_transitions.back().symbol < symbol) {
-        state_transitions.insert({ symbol, state_to });
+    // New moves are created in the memory resource of the post, so that moving them into the post does not copy them.
+    if (state_transitions.empty() || state_transitions.back().symbol < symbol) {
+        state_transitions.push_back(Move{ symbol, state_to, state_transitions.get_allocator() });
     } else {
-        const auto symbol_transitions{ state_transitions.find(Move{ symbol }) };
+        const auto symbol_transitions{ state_transitions.find(symbol) };
         if (symbol_transitions != state_transitions.end()) {
             // Add transition with symbol already used on transitions from state_from.
             symbol_transitions->insert(state_to);
         } else {
             // Add transition to a new Move struct with symbol yet unused on transitions from state_from.
-            const Move new_symbol_transitions{ symbol, state_to };
-            state_transitions.insert(new_symbol_transitions);
+            state_transitions.insert(Move{ symbol, state_to, state_transitions.get_allocator() });
         }
     }
 }
 
 void Delta::add(const State state_from, const Symbol symbol, const StateSet& states) {
+    reverse.reset();
+    if (changes) {
+        for (const State state_to: states) { changes->added.emplace_back(state_from, symbol, state_to); }
+    }
     if(states.empty()) {
         return;
     }
@@ -115,10 +137,8 @@ void Delta::add(const State state_from, const Symbol symbol, const StateSet& sta
 
     Post& state_transitions{ posts[state_from] };
 
-    if (state_transitions.empty()) {
-        state_transitions.insert({ symbol, states });
-    } else if (state_transitions.back().symbol < symbol) {
-        state_transitions.insert({ symbol, states });
+    if (state_transitions.empty() || state_transitions.back().symbol < symbol) {
+        state_transitions.push_back(Move{ symbol, states, state_transitions.get_allocator() });
     } else {
         const auto symbol_transitions{ state_transitions.find(symbol) };
         if (symbol_transitions != state_transitions.end()) {
@@ -127,13 +147,79 @@ void Delta::add(const State state_from, const Symbol symbol, const StateSet& sta
 
         } else {
             // Add transition to a new Move struct with symbol yet unused on transitions from state_from.
-            // Move new_symbol_transitions{ symbol, states };
-            state_transitions.insert(Move{symbol, states});
+            state_transitions.insert(Move{ symbol, states, state_transitions.get_allocator() });
+        }
+    }
+}
+
+void Delta::finalize() {
+    bulk_mode = false;
+    reverse.reset();
+    if (bulk_transitions.empty()) { return; }
+    if (changes) {
+        changes->added.insert(changes->added.end(), bulk_transitions.begin(), bulk_transitions.end());
+    }
+
+    State max_state{ 0 };
+    for (const Trans& trans: bulk_transitions) { max_state = std::max({ max_state, trans.src, trans.tgt }); }
+    if (max_state >= posts.size()) {
+        posts.resize(max_state + 1);
+    }
+
+    // Counting sort of the transitions by their source states.
+    std::vector<size_t> src_offsets(posts.size() + 1, 0);
+    for (const Trans& trans: bulk_transitions) { ++src_offsets[trans.src + 1]; }
+    for (size_t i{ 1 }; i < src_offsets.size(); ++i) { src_offsets[i] += src_offsets[i - 1]; }
+    std::vector<Trans> sorted(bulk_transitions.size());
+    {
+        std::vector<size_t> insert_position{ src_offsets.begin(), src_offsets.end() - 1 };
+        for (const Trans& trans: bulk_transitions) { sorted[insert_position[trans.src]++] = trans; }
+    }
+    bulk_transitions.clear();
+    bulk_transitions.shrink_to_fit();
+
+    const auto symbol_target_less = [](const Trans& lhs, const Trans& rhs) {
+        return lhs.symb < rhs.symb || (lhs.symb == rhs.symb && lhs.tgt < rhs.tgt);
+    };
+
+    const size_t num_of_states{ posts.size() };
+    for (State src{ 0 }; src < num_of_states; ++src) {
+        const auto first{ sorted.begin() + static_cast<long>(src_offsets[src]) };
+        const auto last{ sorted.begin() + static_cast<long>(src_offsets[src + 1]) };
+        if (first == last) { continue; }
+        std::sort(first, last, symbol_target_less);
+
+        // Build the new moves of src from the sorted slice, skipping duplicate transitions.
+        Post new_post{ posts.get_allocator() };
+        for (auto trans_it{ first }; trans_it != last;) {
+            const Symbol symbol{ trans_it->symb };
+            Move move{ symbol, new_post.get_allocator() };
+            for (; trans_it != last && trans_it->symb == symbol; ++trans_it) {
+                if (move.targets.empty() || move.targets.back() != trans_it->tgt) {
+                    move.targets.push_back(trans_it->tgt);
+                }
+            }
+            new_post.push_back(std::move(move));
+        }
+
+        Post& post{ posts[src] };
+        if (post.empty()) {
+            post = std::move(new_post);
+            continue;
+        }
+        for (Move& move: new_post) {
+            const auto existing_move{ post.find(move.symbol) };
+            if (existing_move == post.end()) {
+                post.insert(std::move(move));
+            } else {
+                existing_move->insert(move.targets);
+            }
         }
     }
 }
 
 void Delta::remove(State src, Symbol symb, State tgt) {
+    reverse.reset();
     if (src >= posts.size()) {
         return;
     }
@@ -158,6 +244,7 @@ void Delta::remove(State src, Symbol symb, State tgt) {
             if (symbol_transitions->empty()) {
                 posts[src].remove(*symbol_transitions);
             }
+            if (changes) { changes->removed.emplace_back(src, symb, tgt); }
         }
     }
 }
@@ -188,7 +275,7 @@ bool Delta::empty() const
     return this->begin() == this->end();
 }
 
-Delta::const_iterator::const_iterator(const std::vector<Post>& post_p, bool ise) :
+Delta::const_iterator::const_iterator(const std::pmr::vector<Post>& post_p, bool ise) :
     post(post_p), current_state(0), is_end{ ise }
 {
     const size_t post_size = post.size();
@@ -260,7 +347,7 @@ bool Mata::Nfa::operator==(const Delta::const_iterator& a, const Delta::const_it
 }
 
 State Delta::find_max_state() {
-    size_t max = 0;
+    State max = 0;
     State src = 0;
     for (Post & p: posts) {
         if (src > max)
@@ -294,7 +381,13 @@ std::vector<Post> Delta::transform(const std::function<State(State)>& lambda) co
     return cp_post_vector;
 }
 
+Delta::Delta(const Delta& other, std::pmr::memory_resource* const resource)
+    : posts(other.posts, resource), bulk_transitions{ other.bulk_transitions }, bulk_mode{ other.bulk_mode },
+      reverse{ other.reverse }, changes{ other.changes } {}
+
 Post& Delta::get_mutable_post(State q) {
+    reverse.reset();
+    set_untracked();
     if (q >= posts.size()) {
         Util::reserve_on_insert(posts, q);
         const size_t new_size{ q + 1 };
@@ -305,6 +398,8 @@ Post& Delta::get_mutable_post(State q) {
 }
 
 void Delta::defragment(const BoolVector& is_staying, const std::vector<State>& renaming) {
+    reverse.reset();
+    set_untracked();
     //TODO: this function seems to be unreadable, should be refactored, maybe into several functions with a clear functionality?
 
     //first, indexes of post are filtered (places of to be removed states are taken by states on their right)
@@ -319,7 +414,7 @@ void Delta::defragment(const BoolVector& is_staying, const std::vector<State>& r
 
     //this iterates through every post and every move, filters and renames states,
     //and then removes moves that became empty.
-    for (State q=0,size=posts.size(); q < size; ++q) {
+    for (State q=0,size=static_cast<State>(posts.size()); q < size; ++q) {
         Post & p = get_mutable_post(q);
         for (auto move = p.begin(); move < p.end(); ++move) {
             move->targets.erase(
@@ -345,3 +440,134 @@ const Post& Delta::operator[](State q) const {
     }
     return posts[q];
 }
+
+const ReverseDelta& LazyReverseDelta::get(const Delta& delta) const {
+    std::shared_ptr<const ReverseDelta> current{ index.load() };
+    if (current == nullptr) {
+        // Threads building the index at the same time keep the index of the first of them to store it.
+        std::shared_ptr<const ReverseDelta> built{ std::make_shared<const ReverseDelta>(delta) };
+        if (index.compare_exchange_strong(current, built)) { current = std::move(built); }
+    }
+    // The index keeps the reverse delta alive until it is reset by a modification of the delta.
+    return *current;
+}
+
+ReverseDelta::ReverseDelta(const Delta& delta) {
+    // Rank the distinct symbols, so that the transitions can be counting sorted by their symbols without allocating
+    //  anything indexed by the symbols themselves.
+    const size_t num_of_states{ delta.num_of_states() };
+    std::unordered_map<Symbol, size_t> symbol_ranks{};
+    size_t num_of_transitions{ 0 };
+    for (State source{ 0 }; source < num_of_states; ++source) {
+        for (const Move& move: delta[source]) {
+            symbol_ranks.emplace(move.symbol, 0);
+            num_of_transitions += move.size();
+        }
+    }
+    std::vector<Symbol> symbols{};
+    symbols.reserve(symbol_ranks.size());
+    for (const auto& [symbol, rank]: symbol_ranks) { symbols.push_back(symbol); }
+    std::sort(symbols.begin(), symbols.end());
+    for (size_t rank{ 0 }; rank < symbols.size(); ++rank) { symbol_ranks[symbols[rank]] = rank; }
+
+    // Counting sort of the transitions by their symbols. Sources are visited in the increasing order, so the
+    //  transitions over each symbol are ordered by their sources.
+    std::vector<size_t> symbol_offsets(symbols.size() + 1, 0);
+    offsets.assign(num_of_states + 1, 0);
+    for (State source{ 0 }; source < num_of_states; ++source) {
+        for (const Move& move: delta[source]) {
+            symbol_offsets[symbol_ranks[move.symbol] + 1] += move.size();
+            for (const State target: move.targets) { ++offsets[target + 1]; }
+        }
+    }
+    for (size_t i{ 1 }; i < symbol_offsets.size(); ++i) { symbol_offsets[i] += symbol_offsets[i - 1]; }
+    std::vector<Trans> transitions_by_symbol(num_of_transitions);
+    for (State source{ 0 }; source < num_of_states; ++source) {
+        for (const Move& move: delta[source]) {
+            size_t& insert_position{ symbol_offsets[symbol_ranks[move.symbol]] };
+            for (const State target: move.targets) {
+                transitions_by_symbol[insert_position++] = { source, move.symbol, target };
+            }
+        }
+    }
+
+    // Stable counting sort of the transitions by their targets keeps the transitions incoming to each state ordered
+    //  by their symbols and sources.
+    for (size_t i{ 1 }; i < offsets.size(); ++i) { offsets[i] += offsets[i - 1]; }
+    in_transitions.resize(num_of_transitions);
+    std::vector<size_t> insert_position{ offsets.begin(), offsets.end() - 1 };
+    for (const Trans& trans: transitions_by_symbol) {
+        in_transitions[insert_position[trans.tgt]++] = { trans.symb, trans.src };
+    }
+}
+
+std::span<const ReverseDelta::InTransition> ReverseDelta::pre(const State q, const Symbol symbol) const {
+    const std::span<const InTransition> in_transitions_of_q{ pre(q) };
+    const auto [first, last]{ std::equal_range(
+        in_transitions_of_q.begin(), in_transitions_of_q.end(), InTransition{ symbol, 0 },
+        [](const InTransition& lhs, const InTransition& rhs) { return lhs.symbol < rhs.symbol; }) };
+    return { first, last };
+}
+
+void ReverseDelta::get_reverted_post(const State q, Post& post) const {
+    post.clear();
+    for (const InTransition& in_transition: pre(q)) {
+        if (post.empty() || post.back().symbol != in_transition.symbol) {
+            post.push_back(Move{ in_transition.symbol });
+        }
+        post.back().targets.push_back(in_transition.source);
+    }
+}
+
+FrozenPost::const_iterator FrozenPost::find(const Symbol symbol) const {
+    const auto move_it{ std::lower_bound(first_, last_, FrozenMove{ symbol, {} }) };
+    if (move_it == last_ || move_it->symbol != symbol) { return last_; }
+    return move_it;
+}
+
+FrozenDelta::FrozenDelta(const Delta& delta) {
+    const size_t num_of_states{ delta.num_of_states() };
+    size_t num_of_moves{ 0 };
+    size_t num_of_targets{ 0 };
+    for (State q{ 0 }; q < num_of_states; ++q) {
+        const Post& post{ delta[q] };
+        num_of_moves += post.size();
+        for (const Move& move: post) { num_of_targets += move.size(); }
+    }
+
+    // Reserve everything up-front: the target ranges of moves point into 'targets', which must not be reallocated.
+    post_offsets.reserve(num_of_states + 1);
+    moves.reserve(num_of_moves);
+    targets.reserve(num_of_targets);
+    for (State q{ 0 }; q < num_of_states; ++q) {
+        post_offsets.push_back(moves.size());
+        for (const Move& move: delta[q]) {
+            const size_t first_target{ targets.size() };
+            targets.insert(targets.end(), move.targets.begin(), move.targets.end());
+            moves.push_back({ move.symbol, { targets.data() + first_target, move.targets.size() } });
+        }
+    }
+    post_offsets.push_back(moves.size());
+}
+
+FrozenDelta::FrozenDelta(const FrozenDelta& other)
+    : post_offsets{ other.post_offsets }, moves{ other.moves }, targets{ other.targets } {
+    rebase_moves(other);
+}
+
+FrozenDelta& FrozenDelta::operator=(const FrozenDelta& other) {
+    if (this != &other) {
+        post_offsets = other.post_offsets;
+        moves = other.moves;
+        targets = other.targets;
+        rebase_moves(other);
+    }
+    return *this;
+}
+
+void FrozenDelta::rebase_moves(const FrozenDelta& other) {
+    for (FrozenMove& move: moves) {
+        const auto offset{ move.targets.data() - other.targets.data() };
+        move.targets = { targets.data() + offset, move.targets.size() };
+    }
+}
@@ -0,0 +1,67 @@
+/* dense-dfa.cc -- Deterministic automata with dense transition tables for fast matching.
+ *
+ * This file is a part of libmata.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include <limits>
+
+#include "mata/nfa/dense-dfa.hh"
+
+using namespace Mata::Nfa;
+
+DenseDfa::DenseDfa(const Nfa& aut, const Symbol first_symbol, const size_t alphabet_size)
+    : first_symbol_{ first_symbol }, alphabet_size_{ static_cast<Symbol>(alphabet_size) },
+      dead_state{ static_cast<StateId>(aut.size()) }, initial_state{ dead_state } {
+    if (alphabet_size == 0 || alphabet_size > std::numeric_limits<Symbol>::max()
+        || first_symbol > std::numeric_limits<Symbol>::max() - (alphabet_size - 1)) {
+        throw std::runtime_error(std::to_string(__func__) + " received an invalid range of symbols starting at "
+                                 + std::to_string(first_symbol) + " of size " + std::to_string(alphabet_size));
+    }
+    const size_t num_of_states{ aut.size() };
+    // The dead state takes the identifier following the states of the automaton.
+    if (num_of_states >= std::numeric_limits<StateId>::max()) {
+        throw std::runtime_error(std::to_string(__func__) + " received an automaton with too many states: "
+                                 + std::to_string(num_of_states));
+    }
+    if (aut.initial.size() > 1) {
+        throw std::runtime_error(std::to_string(__func__) + " received an automaton with multiple initial states");
+    }
+
+    if (!aut.initial.empty()) { initial_state = static_cast<StateId>(*aut.initial.begin()); }
+    transitions.assign((num_of_states + 1) * alphabet_size, dead_state);
+    for (State source{ 0 }; source < aut.delta.num_of_states(); ++source) {
+        StateId* const row{ transitions.data() + source * alphabet_size };
+        for (const Move& move: aut.delta[source]) {
+            if (move.targets.size() > 1) {
+                throw std::runtime_error(std::to_string(__func__) + " received a nondeterministic automaton: state "
+                                         + std::to_string(source) + " has multiple targets over symbol "
+                                         + std::to_string(move.symbol));
+            }
+            const Symbol column{ move.symbol - first_symbol };
+            if (column >= alphabet_size || move.targets.empty()) { continue; }
+            row[column] = static_cast<StateId>(*move.targets.begin());
+        }
+    }
+
+    accepting.assign(num_of_states / 64 + 1, 0);
+    for (const State state: aut.final) { accepting[state / 64] |= uint64_t{ 1 } << (state % 64); }
+}
+
+bool DenseDfa::match(const std::vector<Symbol>& word) const {
+    StateId state{ initial_state };
+    for (const Symbol symbol: word) {
+        state = step(state, symbol);
+        if (state == dead_state) { return false; }
+    }
+    return is_accepting(state);
+}
@@ -0,0 +1,204 @@
+/* determinize-parallel.cc -- Subset construction computed by multiple threads.
+ *
+ * This file is a part of libmata.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <barrier>
+#include <limits>
+#include <mutex>
+#include <thread>
+
+// MATA headers
+#include "mata/nfa/nfa.hh"
+#include "mata/nfa/algorithms.hh"
+#include "mata/utils/k-way-merge.hh"
+#include "mata/utils/threads.hh"
+
+using namespace Mata::Nfa;
+using Mata::Symbol;
+
+namespace {
+
+/**
+ * Store of macrostates shared by the threads of the parallel subset construction.
+ *
+ * Macrostates are split by their hashes into shards, each a MacrostateStore with its own lock. A macrostate is
+ *  identified by a key encoding its shard and its id in the shard. Each macrostate also keeps the state of the result
+ *  it stands for, which is assigned only between the levels of the construction, when no thread inserts.
+ */
+class ShardedMacrostateStore {
+public:
+    using Key = uint64_t;
+    static constexpr State NO_STATE{ Limits::max_state };
+
+    explicit ShardedMacrostateStore(const Nfa& aut) : aut{ aut } {}
+
+    /**
+     * Insert sorted @p macrostate.
+     * @return Key of the macrostate and a flag which is true iff the macrostate has just been inserted.
+     */
+    std::pair<Key, bool> insert(const std::span<const State> macrostate) {
+        size_t hash{ 0 };
+        for (const State q: macrostate) { hash = Mata::Util::hash_combine(hash, q); }
+        // Fibonacci hashing of the hash to a shard, MacrostateStore hashes the macrostate again for itself.
+        const size_t shard_index{ (static_cast<uint64_t>(hash) * 0x9e3779b97f4a7c15ULL) >> (64 - SHARD_BITS) };
+        const bool is_final{ std::any_of(macrostate.begin(), macrostate.end(),
+                                         [this](const State q) { return aut.final[q]; }) };
+
+        Shard& shard{ shards[shard_index] };
+        const std::lock_guard<std::mutex> lock{ shard.mutex };
+        const auto [id, is_new]{ shard.macrostates.insert(macrostate) };
+        if (is_new) {
+            shard.is_final.push_back(is_final);
+            shard.result_states.push_back(NO_STATE);
+        }
+        return { (Key{ id } << SHARD_BITS) | shard_index, is_new };
+    }
+
+    /// Copy macrostate @p key to @p states.
+    void get(const Key key, std::vector<State>& states) {
+        Shard& shard{ shards[key & SHARD_MASK] };
+        const std::lock_guard<std::mutex> lock{ shard.mutex };
+        const std::span<const State> macrostate{ shard.macrostates[id_of(key)] };
+        states.assign(macrostate.begin(), macrostate.end());
+    }
+
+    // Not synchronized, only used between the levels of the construction.
+    bool is_final(const Key key) const { return shards[key & SHARD_MASK].is_final[id_of(key)]; }
+    State& result_state(const Key key) { return shards[key & SHARD_MASK].result_states[id_of(key)]; }
+
+    void to_subset_map(std::unordered_map<StateSet, State>& subset_map) const {
+        for (const Shard& shard: shards) {
+            for (MacrostateStore::Id id{ 0 }; id < shard.macrostates.size(); ++id) {
+                subset_map[shard.macrostates.get_state_set(id)] = shard.result_states[id];
+            }
+        }
+    }
+
+private:
+    static constexpr size_t SHARD_BITS{ 6 };
+    static constexpr Key SHARD_MASK{ (Key{ 1 } << SHARD_BITS) - 1 };
+
+    struct Shard {
+        std::mutex mutex{};
+        MacrostateStore macrostates{};
+        std::vector<bool> is_final{};
+        std::vector<State> result_states{};
+    };
+
+    const Nfa& aut;
+    std::array<Shard, size_t{ 1 } << SHARD_BITS> shards{};
+
+    static MacrostateStore::Id id_of(const Key key) { return static_cast<MacrostateStore::Id>(key >> SHARD_BITS); }
+}; // class ShardedMacrostateStore.
+
+/// Macrostate of the current level with the state of the result it stands for.
+struct LevelMacrostate {
+    ShardedMacrostateStore::Key key;
+    State state;
+};
+
+/// Buffers of a single thread of the parallel subset construction.
+struct Worker {
+    std::vector<State> macrostate{};
+    Mata::Util::SynchronizedExistentialIterator<FrozenPost::const_iterator> synchronized_iterator{};
+    std::span<const FrozenPost::const_iterator> moves{};
+    Mata::Util::KWayMerger<State> targets_merger{};
+    std::vector<State> targets_union{};
+};
+
+} // Anonymous namespace.
+
+Nfa Mata::Nfa::Algorithms::determinize_parallel(const Nfa& aut, size_t num_of_threads,
+                                                std::unordered_map<StateSet, State>* subset_map) {
+    num_of_threads = Mata::Util::get_num_of_threads(num_of_threads);
+
+    Nfa result{};
+    ShardedMacrostateStore macrostates{ aut };
+    const ShardedMacrostateStore::Key S0key{ macrostates.insert(StateSet(aut.initial).ToVector()).first };
+    result.add_state();
+    result.initial.insert(0);
+    if (macrostates.is_final(S0key)) { result.final.insert(0); }
+    macrostates.result_state(S0key) = 0;
+
+    // Macrostates are explored breadth-first. Threads claim chunks of the current level from next_chunk and store
+    //  the successors of each macrostate of the level. The states of the result are assigned to the successors in
+    //  a single thread after the whole level is processed, in the order of the level and of the symbols, so the
+    //  result does not depend on the scheduling of the threads.
+    constexpr size_t CHUNK_SIZE{ 16 };
+    const FrozenDelta frozen_delta{ aut.delta };
+    std::vector<LevelMacrostate> level{ { S0key, 0 } };
+    std::vector<LevelMacrostate> next_level{};
+    std::vector<std::vector<std::pair<Symbol, ShardedMacrostateStore::Key>>> successors(1);
+    std::atomic<size_t> next_chunk{ 0 };
+    bool is_done{ frozen_delta.empty() };
+
+    // Runs in a single thread when all threads have finished the level.
+    const auto start_next_level = [&]() noexcept {
+        next_level.clear();
+        for (size_t index{ 0 }; index < level.size(); ++index) {
+            for (const auto& [symbol, key]: successors[index]) {
+                State& target{ macrostates.result_state(key) };
+                if (target == ShardedMacrostateStore::NO_STATE) {
+                    target = result.add_state();
+                    if (macrostates.is_final(key)) { result.final.insert(target); }
+                    next_level.push_back({ key, target });
+                }
+                result.delta.get_mutable_post(level[index].state).push_back(Move(symbol, target));
+            }
+            successors[index].clear();
+        }
+        std::swap(level, next_level);
+        if (successors.size() < level.size()) { successors.resize(level.size()); }
+        next_chunk.store(0);
+        is_done = level.empty();
+    };
+    std::barrier level_barrier{ static_cast<std::ptrdiff_t>(num_of_threads), start_next_level };
+
+    const auto process = [&](Worker& worker, const size_t index) {
+        macrostates.get(level[index].key, worker.macrostate);
+        worker.synchronized_iterator.reset();
+        for (const State q: worker.macrostate) {
+            Mata::Util::push_back(worker.synchronized_iterator, frozen_delta[q]);
+        }
+        while (worker.synchronized_iterator.advance()) {
+            worker.synchronized_iterator.get_current(worker.moves);
+            const Symbol symbol{ (*worker.moves.begin())->symbol };
+            for (const FrozenPost::const_iterator& move: worker.moves) {
+                worker.targets_merger.add(move->begin(), move->end());
+            }
+            worker.targets_merger.merge(worker.targets_union);
+            successors[index].emplace_back(symbol, macrostates.insert(worker.targets_union).first);
+        }
+    };
+    std::vector<Worker> workers(num_of_threads);
+    const auto work = [&](const size_t thread) {
+        Worker& worker{ workers[thread] };
+        while (!is_done) {
+            for (size_t begin{ next_chunk.fetch_add(CHUNK_SIZE) }; begin < level.size();
+                 begin = next_chunk.fetch_add(CHUNK_SIZE)) {
+                const size_t end{ std::min(begin + CHUNK_SIZE, level.size()) };
+                for (size_t index{ begin }; index < end; ++index) { process(worker, index); }
+            }
+            level_barrier.arrive_and_wait();
+        }
+    };
+
+    Mata::Util::run_threads(num_of_threads, level_barrier, work);
+
+    if (subset_map != nullptr) { macrostates.to_subset_map(*subset_map); }
+    return result;
+}
@@ -18,10 +18,15 @@
 // MATA headers
 #include "mata/nfa/nfa.hh"
 #include "mata/nfa/algorithms.hh"
+#include "mata/nfa/lazy-dfa.hh"
 #include "mata/utils/sparse-set.hh"
+#include "mata/utils/k-way-merge.hh"
+#include "mata/utils/antichain.hh"
+#include "mata/utils/union-find.hh"
 
 using namespace Mata::Nfa;
 using namespace Mata::Util;
+using Mata::Symbol;
 
 /// naive language inclusion check (complementation + intersection + emptiness)
 bool Mata::Nfa::Algorithms::is_included_naive(
@@ -35,48 +40,34 @@ bool Mata::Nfa::Algorithms::is_included_naive(
     } else {
         bigger_cmpl = complement(bigger, *alphabet);
     }
-    Nfa nfa_isect = intersection(smaller, bigger_cmpl, false, nullptr);
-
-    return is_lang_empty(nfa_isect, cex);
+    return is_intersection_empty(smaller, bigger_cmpl, cex);
 } // is_included_naive }}}
 
 
-/// language inclusion check using Antichains
+namespace {
+
+/// language inclusion check using Antichains. With @p simulated_states of bigger (see
+///  Algorithms::get_simulated_states()), macrostates of bigger are closed downward under simulation, so that the
+///  subsumption by set inclusion of the closed macrostates is the subsumption by simulation of the original ones.
 // TODO, what about to construct the separator from this?
-bool Mata::Nfa::Algorithms::is_included_antichains(
-    const Nfa&             smaller,
-    const Nfa&             bigger,
-    const Alphabet* const  alphabet, //TODO: this parameter is not used
-    Run*                   cex)
+bool is_included_antichains_impl(
+    const Nfa&                              smaller,
+    const Nfa&                              bigger,
+    Run*                                    cex,
+    const Algorithms::SimulatedStates*      simulated_states)
 { // {{{
-    //TODO: what does this do?
-    (void)alphabet;
-
-    using ProdStateType = std::pair<State, StateSet>;
-    using WorklistType = std::deque<ProdStateType>;
-    using ProcessedType = std::deque<ProdStateType>;
-
-    //TODO: This is used in a container (a deque) of pairs, where every new pair means iterating through the entire list,
-    // and testing subsumption with everybody.
-    // Rewrite this as a deque (vector?) indexed by the first component (state) of vectors of the second components.
-    // We will go to the vector of the first component and test subsumption of the second components there.
-    // It may need some more fiddling if we still want to implement pure dfs/bfs however.
-    auto subsumes = [](const ProdStateType& lhs, const ProdStateType& rhs) {
-        if (lhs.first != rhs.first) {
-            return false;
-        }
-
-        const StateSet& lhs_bigger = lhs.second;
-        const StateSet& rhs_bigger = rhs.second;
-        if (lhs_bigger.size() > rhs_bigger.size()) { // bigger set cannot be subset
-            return false;
-        }
-
-        //TODO: Can this be done faster using more heuristics? E.g., compare the last elements first ...
-        //TODO: Try BDDs! What about some abstractions?
-        return std::includes(rhs_bigger.begin(), rhs_bigger.end(),
-            lhs_bigger.begin(), lhs_bigger.end());
-    };
+    using Id = MacrostateStore::Id;
+    // Product state is a state of smaller with an id of a macrostate of bigger.
+    using ProdStateType = std::pair<State, Id>;
+    // Processed product states, bucketed by the state of smaller, with the macrostate of bigger as the set. A product
+    //  state subsumes another one if it has the same state of smaller and a subset of its macrostate of bigger.
+    using ProcessedType = Antichain<State, Id>;
+    // Product states to process. The worklist is always a subset of processed, it refers to processed product states
+    //  by handles, and handles of product states removed from processed are skipped.
+    using WorklistType = std::deque<ProcessedType::Handle>;
+
+    // All explored macrostates of bigger, each stored once.
+    MacrostateStore macrostates{};
 
     // process parameters
     // TODO: set correctly!!!!
@@ -90,6 +81,23 @@ bool Mata::Nfa::Algorithms::is_included_antichains(
     // 'paths[s] == s' means that 's' is an initial state
     std::map<ProdStateType, std::pair<ProdStateType, Symbol>> paths;
 
+    std::vector<State> bigger_succ_union{};
+    Mata::Util::KWayMerger<State> bigger_succ_union_merger{};
+    // Close the macrostate of bigger in bigger_succ_union under simulation.
+    auto close_bigger_succ_union = [&]() {
+        if (simulated_states == nullptr) { return; }
+        for (const State q : bigger_succ_union) {
+            bigger_succ_union_merger.add((*simulated_states)[q].data(),
+                                         (*simulated_states)[q].data() + (*simulated_states)[q].size());
+        }
+        bigger_succ_union_merger.merge(bigger_succ_union);
+    };
+
+    bigger_succ_union.assign(bigger.initial.begin(), bigger.initial.end());
+    std::sort(bigger_succ_union.begin(), bigger_succ_union.end());
+    close_bigger_succ_union();
+    const Id bigger_initial_id{ macrostates.insert(bigger_succ_union.begin(), bigger_succ_union.end()).first };
+
     // check initial states first // TODO: this would be done in the main loop as the first thing anyway?
     for (const auto& state : smaller.initial) {
         if (smaller.final[state] &&
@@ -99,39 +107,46 @@ bool Mata::Nfa::Algorithms::is_included_antichains(
             return false;
         }
 
-        const ProdStateType st = std::make_pair(state, StateSet(bigger.initial));
-        worklist.push_back(st);
-        processed.push_back(st);
+        const ProdStateType st = std::make_pair(state, bigger_initial_id);
+        if (processed.contains_subset_of(state, macrostates[bigger_initial_id])) { continue; }
+        worklist.push_back(processed.insert(state, macrostates[bigger_initial_id], bigger_initial_id));
 
         if (cex != nullptr)
             paths.insert({ st, {st, 0}});
     }
 
+    // The antichain exploration only reads the transitions, traverse their contiguous frozen copies.
+    const FrozenDelta smaller_delta{ smaller.delta };
+    const FrozenDelta bigger_delta{ bigger.delta };
+
     //For synchronised iteration over the set of states
-    using Iterator = Mata::Util::OrdVector<Move>::const_iterator;
+    using Iterator = FrozenPost::const_iterator;
     Mata::Util::SynchronizedExistentialIterator<Iterator> sync_iterator;
+    std::span<const Iterator> bigger_moves{};
 
     while (!worklist.empty()) {
         // get a next product state
-        ProdStateType prod_state;
+        ProcessedType::Handle handle;
         if (is_dfs) {
-            prod_state = *worklist.rbegin();
+            handle = *worklist.rbegin();
             worklist.pop_back();
         } else { // BFS
-            prod_state = *worklist.begin();
+            handle = *worklist.begin();
             worklist.pop_front();
         }
+        // Skip product states subsumed by product states processed later.
+        if (!processed.is_alive(handle)) { continue; }
+        const ProdStateType prod_state{ static_cast<State>(processed.get_bucket(handle)), processed.get_value(handle) };
 
         const State& smaller_state = prod_state.first;
-        const StateSet& bigger_set = prod_state.second;
 
         sync_iterator.reset();
-        for (State q: bigger_set) {
-            Mata::Util::push_back(sync_iterator, bigger.delta[q]);
+        for (State q: macrostates[prod_state.second]) {
+            Mata::Util::push_back(sync_iterator, bigger_delta[q]);
         }
 
         // process transitions leaving smaller_state
-        for (const auto& smaller_move : smaller.delta[smaller_state]) {
+        for (const auto& smaller_move : smaller_delta[smaller_state]) {
             const Symbol& smaller_symbol = smaller_move.symbol;
 
             do {
@@ -144,19 +159,24 @@ bool Mata::Nfa::Algorithms::is_included_antichains(
             } while (sync_iterator.advance());
 
             // TODO: this is ugly, the interface of the sync iterator should be redesigned so that this looks ok
-            StateSet bigger_succ = {};
+            bigger_succ_union.clear();
             if(sync_iterator.is_synchronized() && *sync_iterator.get_current_minimum() == smaller_move) {
-                std::vector<Iterator> bigger_moves = sync_iterator.get_current();
-                for (auto m: bigger_moves) {
-                    bigger_succ = bigger_succ.Union(m->targets);
+                sync_iterator.get_current(bigger_moves);
+                for (const Iterator& m: bigger_moves) {
+                    bigger_succ_union_merger.add(m->begin(), m->end());
                 }
+                bigger_succ_union_merger.merge(bigger_succ_union);
+                close_bigger_succ_union();
             }
+            const bool is_bigger_succ_final{
+                std::any_of(bigger_succ_union.begin(), bigger_succ_union.end(),
+                            [&bigger](const State q) { return bigger.final[q]; }) };
+            const Id bigger_succ{ macrostates.insert(bigger_succ_union.begin(), bigger_succ_union.end()).first };
 
             for (const State& smaller_succ : smaller_move.targets) {
                 const ProdStateType succ = {smaller_succ, bigger_succ};
 
-                if (smaller.final[smaller_succ] &&
-                    !bigger.final.intersects_with(bigger_succ))
+                if (smaller.final[smaller_succ] && !is_bigger_succ_final)
                 {
                     if (cex  != nullptr) {
                         cex->word.clear();
@@ -174,42 +194,291 @@ bool Mata::Nfa::Algorithms::is_included_antichains(
                     return false;
                 }
 
-                bool is_subsumed = false;
-                for (const auto& anti_state : processed)
-                { // trying to find a smaller state in processed
-                    if (subsumes(anti_state, succ)) {
-                        is_subsumed = true;
-                        break;
-                    }
+                // trying to find a smaller state in processed
+                const std::span<const State> bigger_succ_states{ macrostates[bigger_succ] };
+                if (processed.contains_subset_of(smaller_succ, bigger_succ_states)) { continue; }
+
+                // prune processed (and thus the worklist) and insert succ inside
+                processed.remove_supersets_of(smaller_succ, bigger_succ_states);
+                // TODO: set pushing strategy
+                worklist.push_back(processed.insert(smaller_succ, bigger_succ_states, bigger_succ));
+
+                // also set that succ was accessed from state
+                paths[succ] = {prod_state, smaller_symbol};
+            }
+        }
+    }
+
+    return true;
+} // }}}
+
+} // Anonymous namespace.
+
+/// language inclusion check using Antichains
+bool Mata::Nfa::Algorithms::is_included_antichains(
+    const Nfa&             smaller,
+    const Nfa&             bigger,
+    const Alphabet* const  alphabet, //TODO: this parameter is not used
+    Run*                   cex)
+{ // {{{
+    (void)alphabet;
+    return is_included_antichains_impl(smaller, bigger, cex, nullptr);
+} // }}}
+
+/// language inclusion check using Antichains with subsumption by simulation
+bool Mata::Nfa::Algorithms::is_included_antichains_sim(
+    const Nfa&             smaller,
+    const Nfa&             bigger,
+    const Alphabet* const  alphabet,
+    Run*                   cex)
+{ // {{{
+    (void)alphabet;
+    const SimulatedStates simulated_states{ get_simulated_states(bigger) };
+    return is_included_antichains_impl(smaller, bigger, cex, &simulated_states);
+} // }}}
+
+bool Mata::Nfa::Algorithms::is_included_antichains_sim(
+    const Nfa&              smaller,
+    const Nfa&              bigger,
+    const SimulatedStates&  simulated_states,
+    Run*                    cex)
+{ // {{{
+    assert(simulated_states.size() == bigger.size());
+    return is_included_antichains_impl(smaller, bigger, cex, &simulated_states);
+} // }}}
+
+/// language inclusion check on the product of smaller with the lazily determinized bigger
+bool Mata::Nfa::Algorithms::is_included_lazy_dfa(
+    const Nfa&             smaller,
+    const Nfa&             bigger,
+    const Alphabet* const  alphabet,
+    Run*                   cex)
+{ // {{{
+    (void)alphabet;
+
+    // Product state is a state of smaller with a state of the lazy DFA of bigger.
+    using ProdStateType = std::pair<State, State>;
+
+    LazyDfa bigger_dfa{ bigger };
+    // 'paths[s] == (t, a)' denotes that state 's' was accessed from state 't' over 'a',
+    // 'paths[s] == (s, 0)' means that 's' is an initial state
+    std::unordered_map<ProdStateType, std::pair<ProdStateType, Symbol>> paths;
+    // Breadth-first search, so that the counterexample is a shortest one.
+    std::deque<ProdStateType> worklist;
+
+    auto get_cex = [&](ProdStateType trav) {
+        cex->word.clear();
+        while (paths[trav].first != trav) { // go back until initial state
+            cex->word.push_back(paths[trav].second);
+            trav = paths[trav].first;
+        }
+        std::reverse(cex->word.begin(), cex->word.end());
+    };
+
+    const State bigger_initial{ bigger_dfa.initial_state() };
+    for (const State state : smaller.initial) {
+        const ProdStateType prod_state{ state, bigger_initial };
+        if (!paths.emplace(prod_state, std::make_pair(prod_state, Symbol{ 0 })).second) { continue; }
+        if (smaller.final[state] && !bigger_dfa.is_final(bigger_initial)) {
+            if (cex != nullptr) { cex->word.clear(); }
+            return false;
+        }
+        worklist.push_back(prod_state);
+    }
+
+    const FrozenDelta smaller_delta{ smaller.delta };
+    while (!worklist.empty()) {
+        const ProdStateType prod_state{ worklist.front() };
+        worklist.pop_front();
+
+        for (const FrozenMove& smaller_move : smaller_delta[prod_state.first]) {
+            const State bigger_succ{ bigger_dfa.post(prod_state.second, smaller_move.symbol) };
+            for (const State smaller_succ : smaller_move.targets) {
+                const ProdStateType succ{ smaller_succ, bigger_succ };
+                if (!paths.emplace(succ, std::make_pair(prod_state, smaller_move.symbol)).second) { continue; }
+
+                if (smaller.final[smaller_succ] && !bigger_dfa.is_final(bigger_succ)) {
+                    if (cex != nullptr) { get_cex(succ); }
+                    return false;
                 }
+                worklist.push_back(succ);
+            }
+        }
+    }
 
-                if (is_subsumed) { continue; }
-
-                for (std::deque<ProdStateType>* ds : {&processed, &worklist}) {
-                    for (size_t it = 0; it < ds->size(); ++it) {
-                        if (subsumes(succ, ds->at(it))) {
-                            //Removal though replacement by the last element and removal pob_back.
-                            //Because calling erase would invalidate iterator it (in deque).
-                            ds->at(it) = ds->back(); //does it coppy stuff?
-                            ds->pop_back();
-                        } else {
-                            ++it;
-                        }
-                    }
+    return true;
+} // }}}
+
+namespace {
+
+/// Automaton with the states of @p lhs followed by the states of @p rhs, renumbered by @p rhs_offset.
+Nfa get_disjoint_union(const Nfa& lhs, const Nfa& rhs, const State rhs_offset) {
+    Nfa result{};
+    result.delta.start_bulk();
+    for (const Trans& trans : lhs.delta) { result.delta.add_unsorted(trans); }
+    for (const Trans& trans : rhs.delta) {
+        result.delta.add_unsorted(trans.src + rhs_offset, trans.symb, trans.tgt + rhs_offset);
+    }
+    result.delta.finalize();
+    for (const State q : lhs.final) { result.final.insert(q); }
+    for (const State q : rhs.final) { result.final.insert(q + rhs_offset); }
+    return result;
+}
+
+/// Equivalence check of macrostates @p lhs_initial and @p rhs_initial of @p aut by bisimulation up to congruence
+///  (Bonchi, Pous: Checking NFA equivalence with bisimulations up to congruence, 2013).
+/// Pairs of macrostates are explored breadth-first, so the counterexample is a shortest one. A pair is skipped when
+///  its macrostates are already related by the equivalence closure of the checked pairs (kept in a union-find) or,
+///  failing that, by the congruence closure (macrostates with the same normal form under the rewriting by the checked
+///  pairs).
+bool are_macrostates_equivalent_hkc(const Nfa& aut, const StateSet& lhs_initial, const StateSet& rhs_initial, Run* cex)
+{ // {{{
+    using Id = MacrostateStore::Id;
+    struct PairOfMacrostates {
+        Id lhs;
+        Id rhs;
+        size_t parent; ///< Index of the pair this pair was reached from.
+        Symbol symbol; ///< Symbol this pair was reached over.
+    };
+
+    MacrostateStore macrostates{};
+    const FrozenDelta delta{ aut.delta };
+    auto is_final = [&](const Id id) {
+        const std::span<const State> macrostate{ macrostates[id] };
+        return std::any_of(macrostate.begin(), macrostate.end(), [&aut](const State q) { return aut.final[q]; });
+    };
 
-                    // TODO: set pushing strategy
-                    ds->push_back(succ);
+    // Checked pairs: related by the relation which is being built to be a bisimulation up to congruence.
+    std::vector<std::pair<Id, Id>> relation{};
+    UnionFind<Id> equivalence_classes{};
+
+    // Normal form of a macrostate: the largest macrostate reachable by rewriting Z to Z u B if A is a subset of Z,
+    //  and Z to Z u A if B is a subset of Z, for related pairs (A, B). Related macrostates have the same normal form.
+    std::vector<State> lhs_form{};
+    std::vector<State> rhs_form{};
+    std::vector<State> form_buffer{};
+    auto compute_normal_form = [&](const Id id, std::vector<State>& form) {
+        form.assign(macrostates[id].begin(), macrostates[id].end());
+        for (bool is_changed{ true }; is_changed;) {
+            is_changed = false;
+            for (const auto& [a, b] : relation) {
+                const std::span<const State> a_states{ macrostates[a] };
+                const std::span<const State> b_states{ macrostates[b] };
+                const bool has_a{ std::includes(form.begin(), form.end(), a_states.begin(), a_states.end()) };
+                const bool has_b{ std::includes(form.begin(), form.end(), b_states.begin(), b_states.end()) };
+                if (has_a == has_b) { continue; }
+                const std::span<const State> added{ has_a ? b_states : a_states };
+                form_buffer.clear();
+                std::set_union(form.begin(), form.end(), added.begin(), added.end(), std::back_inserter(form_buffer));
+                std::swap(form, form_buffer);
+                is_changed = true;
+            }
+        }
+    };
+
+    constexpr size_t NO_PARENT{ std::numeric_limits<size_t>::max() };
+    std::vector<PairOfMacrostates> pairs{
+        { macrostates.insert(lhs_initial).first, macrostates.insert(rhs_initial).first, NO_PARENT, 0 } };
+    std::deque<size_t> worklist{ 0 };
+
+    std::vector<State> lhs_states{};
+    std::vector<State> rhs_states{};
+    std::vector<Symbol> symbols{};
+    std::vector<State> succ_states{};
+    KWayMerger<State> succ_states_merger{};
+    // Get the id of the successor of macrostate @p states over @p symbol.
+    auto get_succ = [&](const std::vector<State>& states, const Symbol symbol) {
+        for (const State q : states) {
+            const FrozenPost post{ delta[q] };
+            const auto move{ post.find(symbol) };
+            if (move != post.end()) { succ_states_merger.add(move->begin(), move->end()); }
+        }
+        succ_states_merger.merge(succ_states);
+        return macrostates.insert(succ_states).first;
+    };
+
+    while (!worklist.empty()) {
+        const size_t pair_index{ worklist.front() };
+        worklist.pop_front();
+        const PairOfMacrostates pair{ pairs[pair_index] };
+
+        if (equivalence_classes.are_together(pair.lhs, pair.rhs)) { continue; }
+        compute_normal_form(pair.lhs, lhs_form);
+        compute_normal_form(pair.rhs, rhs_form);
+        if (lhs_form == rhs_form) { continue; }
+
+        if (is_final(pair.lhs) != is_final(pair.rhs)) {
+            if (cex != nullptr) {
+                cex->word.clear();
+                for (size_t trav{ pair_index }; pairs[trav].parent != NO_PARENT; trav = pairs[trav].parent) {
+                    cex->word.push_back(pairs[trav].symbol);
                 }
+                std::reverse(cex->word.begin(), cex->word.end());
+            }
+            return false;
+        }
 
-                // also set that succ was accessed from state
-                paths[succ] = {prod_state, smaller_symbol};
+        equivalence_classes.unite(pair.lhs, pair.rhs);
+        relation.emplace_back(pair.lhs, pair.rhs);
+
+        // The views of the macrostates are not used after the successors are inserted.
+        lhs_states.assign(macrostates[pair.lhs].begin(), macrostates[pair.lhs].end());
+        rhs_states.assign(macrostates[pair.rhs].begin(), macrostates[pair.rhs].end());
+        symbols.clear();
+        for (const std::vector<State>* states : { &lhs_states, &rhs_states }) {
+            for (const State q : *states) {
+                for (const FrozenMove& move : delta[q]) { symbols.push_back(move.symbol); }
             }
         }
+        std::sort(symbols.begin(), symbols.end());
+        symbols.erase(std::unique(symbols.begin(), symbols.end()), symbols.end());
+
+        for (const Symbol symbol : symbols) {
+            const Id lhs_succ{ get_succ(lhs_states, symbol) };
+            const Id rhs_succ{ get_succ(rhs_states, symbol) };
+            worklist.push_back(pairs.size());
+            pairs.push_back({ lhs_succ, rhs_succ, pair_index, symbol });
+        }
     }
 
     return true;
 } // }}}
 
+} // Anonymous namespace.
+
+/// language inclusion check by bisimulation up to congruence: L(smaller) <= L(bigger) iff
+///  L(smaller u bigger) == L(bigger)
+bool Mata::Nfa::Algorithms::is_included_hkc(
+    const Nfa&             smaller,
+    const Nfa&             bigger,
+    const Alphabet* const  alphabet,
+    Run*                   cex)
+{ // {{{
+    (void)alphabet;
+    const auto offset{ static_cast<State>(smaller.size()) };
+    const Nfa united{ get_disjoint_union(smaller, bigger, offset) };
+    StateSet bigger_initial{};
+    for (const State q : bigger.initial) { bigger_initial.insert(q + offset); }
+    StateSet united_initial{ smaller.initial };
+    united_initial.insert(bigger_initial);
+    return are_macrostates_equivalent_hkc(united, united_initial, bigger_initial, cex);
+} // }}}
+
+/// language equivalence check by bisimulation up to congruence
+bool Mata::Nfa::Algorithms::are_equivalent_hkc(
+    const Nfa&             lhs,
+    const Nfa&             rhs,
+    const Alphabet* const  alphabet,
+    Run*                   cex)
+{ // {{{
+    (void)alphabet;
+    const auto offset{ static_cast<State>(lhs.size()) };
+    const Nfa united{ get_disjoint_union(lhs, rhs, offset) };
+    StateSet rhs_initial{};
+    for (const State q : rhs.initial) { rhs_initial.insert(q + offset); }
+    return are_macrostates_equivalent_hkc(united, StateSet{ lhs.initial }, rhs_initial, cex);
+} // }}}
+
 namespace {
     using AlgoType = decltype(Algorithms::is_included_naive)*;
 
@@ -237,6 +506,12 @@ namespace {
             algo = Algorithms::is_included_naive;
         } else if ("antichains" == str_algo) {
             algo = Algorithms::is_included_antichains;
+        } else if ("antichains-sim" == str_algo) {
+            algo = Algorithms::is_included_antichains_sim;
+        } else if ("lazy_dfa" == str_algo) {
+            algo = Algorithms::is_included_lazy_dfa;
+        } else if ("hkc" == str_algo) {
+            algo = Algorithms::is_included_hkc;
         } else {
             throw std::runtime_error(std::to_string(__func__) +
                                      " received an unknown value of the \"algo\" key: " + str_algo);
@@ -263,6 +538,11 @@ bool Mata::Nfa::are_equivalent(const Nfa& lhs, const Nfa& rhs, const Alphabet *a
     //TODO: add comment on what this is doing, what is __func__ ...
     AlgoType algo{ set_algorithm(std::to_string(__func__), params) };
 
+    // Bisimulation up to congruence checks the equivalence at once, not as two inclusions.
+    if (params.at("algorithm") == "hkc") {
+        return Algorithms::are_equivalent_hkc(lhs, rhs, alphabet);
+    }
+
     if (params.at("algorithm") == "naive") {
         if (alphabet == nullptr) {
             const auto computed_alphabet{create_alphabet(lhs, rhs) };
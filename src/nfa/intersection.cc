@@ -13,30 +13,40 @@
  * GNU General Public License for more details.
  */
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <barrier>
+#include <limits>
+#include <mutex>
+#include <thread>
+
 // MATA headers
 #include "mata/nfa/nfa.hh"
 #include "mata/nfa/algorithms.hh"
+#include "mata/utils/two-dimensional-map.hh"
+#include "mata/utils/threads.hh"
 
 using namespace Mata::Nfa;
+using Mata::Symbol;
 
 namespace {
 
+using ProductMap = Mata::Util::TwoDimensionalMap<State, State>;
+
 /**
  * Add transition to the product.
  * @param[out] product Created product automaton.
- * @param[out] product_map Created product map.
- * @param[in] pair_to_process Currently processed pair of original states.
+ * @param[in] product_source Product state currently being processed.
  * @param[in] intersection_transition State transitions to add to the product.
  */
-void add_product_transition(Nfa& product, std::unordered_map<std::pair<State,State>, State>& product_map,
-                            const std::pair<State,State>& pair_to_process,
-                            Move& intersection_transition) {
+void add_product_transition(Nfa& product, const State product_source, Move& intersection_transition) {
     if (intersection_transition.empty()) { return; }
 
-    auto& intersect_state_transitions{ product.delta.get_mutable_post(product_map[pair_to_process]) };
+    auto& intersect_state_transitions{ product.delta.get_mutable_post(product_source) };
     auto intersection_move_iter{ intersect_state_transitions.find(intersection_transition) };
     if (intersection_move_iter == intersect_state_transitions.end()) {
-        intersect_state_transitions.insert(intersection_transition);
+        intersect_state_transitions.insert(std::move(intersection_transition));
     } else {
         // Product already has some target states for the given symbol from the current product state.
         intersection_move_iter->insert(intersection_transition.targets);
@@ -47,37 +57,154 @@ void add_product_transition(Nfa& product, std::unordered_map<std::pair<State,Sta
  * Create product state and its transitions.
  * @param[out] product Created product automaton.
  * @param[out] product_map Created product map.
- * @param[out] pairs_to_process Set of product states to process
+ * @param[out] pairs_to_process Worklist of product states to process
  * @param[in] lhs_state_to Target state in NFA @c lhs.
  * @param[in] rhs_state_to Target state in NFA @c rhs.
  * @param[out] intersect_transitions Transitions of the product state.
  */
 void create_product_state_and_trans(
             Nfa& product,
-            std::unordered_map<std::pair<State,State>, State>& product_map,
+            ProductMap& product_map,
             const Nfa& lhs,
             const Nfa& rhs,
-            std::unordered_set<std::pair<State,State>>& pairs_to_process,
+            std::vector<std::pair<State,State>>& pairs_to_process,
             const State lhs_state_to,
             const State rhs_state_to,
             Move& intersect_transitions
 ) {
-    const std::pair<State,State> intersect_state_pair_to(lhs_state_to, rhs_state_to);
-    State intersect_state_to;
-    if (product_map.find(intersect_state_pair_to) == product_map.end()) {
+    State intersect_state_to{ product_map.get(lhs_state_to, rhs_state_to) };
+    if (intersect_state_to == Limits::max_state) {
         intersect_state_to = product.add_state();
-        product_map[intersect_state_pair_to] = intersect_state_to;
-        pairs_to_process.insert(intersect_state_pair_to);
+        product_map.insert(lhs_state_to, rhs_state_to, intersect_state_to);
+        pairs_to_process.emplace_back(lhs_state_to, rhs_state_to);
 
         if (lhs.final[lhs_state_to] && rhs.final[rhs_state_to]) {
             product.final.insert(intersect_state_to);
         }
-    } else {
-        intersect_state_to = product_map[intersect_state_pair_to];
     }
     intersect_transitions.insert(intersect_state_to);
 }
 
+/**
+ * Product map shared by the threads of the parallel product construction.
+ *
+ * Pairs are split by their hashes into shards, each with its own lock, so that threads inserting different pairs
+ *  rarely wait for each other. Product states are numbered consecutively from 0 in the order of insertion.
+ */
+class ShardedProductMap {
+public:
+    /**
+     * @return Product state of the pair (@p lhs_state, @p rhs_state) and whether it has been created by this call.
+     */
+    std::pair<State, bool> get_or_insert(const State lhs_state, const State rhs_state) {
+        const std::pair<State, State> pair{ lhs_state, rhs_state };
+        const size_t hash{ std::hash<std::pair<State, State>>{}(pair) };
+        // Fibonacci hashing of the hash to a shard, the low bits of the hash are used by the map of the shard.
+        Shard& shard{ shards[(static_cast<uint64_t>(hash) * 0x9e3779b97f4a7c15ULL) >> (64 - SHARD_BITS)] };
+        const std::lock_guard<std::mutex> lock{ shard.mutex };
+        const auto [iter, is_new]{ shard.map.try_emplace(pair, 0) };
+        if (is_new) { iter->second = next_state.fetch_add(1, std::memory_order_relaxed); }
+        return { iter->second, is_new };
+    }
+
+    /// @return Number of created product states.
+    State size() const { return next_state.load(); }
+
+    template<class Callback>
+    void for_each(const Callback& callback) const {
+        for (const Shard& shard: shards) {
+            for (const auto& [pair, product_state]: shard.map) { callback(pair.first, pair.second, product_state); }
+        }
+    }
+
+private:
+    static constexpr size_t SHARD_BITS{ 6 };
+
+    struct Shard {
+        std::mutex mutex{};
+        std::unordered_map<std::pair<State, State>, State> map{};
+    };
+
+    std::array<Shard, size_t{ 1 } << SHARD_BITS> shards{};
+    std::atomic<State> next_state{ 0 };
+}; // class ShardedProductMap.
+
+/// Product state with the pair of original states it stands for.
+struct ProductState {
+    State lhs_state;
+    State rhs_state;
+    State product_state;
+};
+
+/**
+ * Part of the product created by a single thread of the parallel product construction.
+ */
+struct ProductFragment {
+    std::vector<Trans> transitions{};
+    std::vector<State> final_states{};
+    std::vector<ProductState> created_states{}; ///< Product states created in the current level, to process next.
+    Mata::Util::SynchronizedUniversalIterator<FrozenPost::const_iterator> sync_iterator{ 2 };
+    std::span<const FrozenPost::const_iterator> moves{};
+};
+
+/// Parent of the pairs and tuples of initial states in the emptiness checks.
+constexpr size_t NO_PARENT{ std::numeric_limits<size_t>::max() };
+
+/**
+ * Fill @p cex with the word over which the product state @p reached was reached from an initial product state.
+ * @param[in] parents Product state from which each product state was reached first and the symbol it was reached over.
+ */
+void fill_counterexample(const std::vector<std::pair<size_t, Symbol>>& parents, size_t reached, Run* cex) {
+    if (cex == nullptr) { return; }
+    cex->word.clear();
+    cex->path.clear();
+    for (; parents[reached].first != NO_PARENT; reached = parents[reached].first) {
+        cex->word.push_back(parents[reached].second);
+    }
+    std::reverse(cex->word.begin(), cex->word.end());
+}
+
+/**
+ * Enumeration of the tuples of states in the product of sets of states, one set for each automaton.
+ */
+class TupleEnumerator {
+public:
+    explicit TupleEnumerator(const size_t num_of_sets) : sets(num_of_sets), tuple(num_of_sets), positions(num_of_sets) {}
+
+    /// Sets of states to enumerate the product of, set by the user before each enumeration.
+    std::vector<std::span<const State>> sets;
+
+    /**
+     * Call @p callback for each tuple in the product of @c sets, available by @c get_tuple() in the callback.
+     * @return True iff the enumeration has been stopped by @p callback returning true.
+     */
+    template<class Callback>
+    bool for_each(const Callback& callback) {
+        const size_t num_of_sets{ sets.size() };
+        for (size_t set{ 0 }; set < num_of_sets; ++set) {
+            if (sets[set].empty()) { return false; }
+            tuple[set] = sets[set][0];
+            positions[set] = 0;
+        }
+        while (true) {
+            if (callback()) { return true; }
+            size_t set{ 0 };
+            for (; set < num_of_sets && ++positions[set] == sets[set].size(); ++set) {
+                positions[set] = 0;
+                tuple[set] = sets[set][0];
+            }
+            if (set == num_of_sets) { return false; }
+            tuple[set] = sets[set][positions[set]];
+        }
+    }
+
+    const std::vector<State>& get_tuple() const { return tuple; }
+
+private:
+    std::vector<State> tuple;
+    std::vector<size_t> positions;
+}; // class TupleEnumerator.
+
 } // Anonymous namespace.
 
 namespace Mata {
@@ -91,23 +218,299 @@ Nfa intersection(const Nfa& lhs, const Nfa& rhs, bool preserve_epsilon,
     return Algorithms::intersection_eps(lhs, rhs, preserve_epsilon, epsilons, prod_map);
 }
 
+bool is_intersection_empty(const Nfa& lhs, const Nfa& rhs, Run* cex) {
+    // Explored pairs in the breadth-first order, which is also the order in which they are processed.
+    std::vector<std::pair<State, State>> pairs{};
+    std::vector<std::pair<size_t, Symbol>> parents{};
+    ProductMap pair_ids{ lhs.size(), rhs.size() };
+
+    /// Explore pair (@p lhs_state, @p rhs_state) reached from @p parent. @return True iff the pair is accepting.
+    const auto explore = [&](const State lhs_state, const State rhs_state, const size_t parent, const Symbol symbol) {
+        if (pair_ids.get(lhs_state, rhs_state) != Limits::max_state) { return false; }
+        pair_ids.insert(lhs_state, rhs_state, static_cast<State>(pairs.size()));
+        pairs.emplace_back(lhs_state, rhs_state);
+        parents.emplace_back(parent, symbol);
+        if (lhs.final[lhs_state] && rhs.final[rhs_state]) {
+            fill_counterexample(parents, pairs.size() - 1, cex);
+            return true;
+        }
+        return false;
+    };
+
+    for (const State lhs_initial_state: lhs.initial) {
+        for (const State rhs_initial_state: rhs.initial) {
+            if (explore(lhs_initial_state, rhs_initial_state, NO_PARENT, 0)) { return false; }
+        }
+    }
+
+    const FrozenDelta lhs_delta{ lhs.delta };
+    const FrozenDelta rhs_delta{ rhs.delta };
+    Mata::Util::SynchronizedUniversalIterator<FrozenPost::const_iterator> sync_iterator(2);
+    std::span<const FrozenPost::const_iterator> moves{};
+    for (size_t processed{ 0 }; processed < pairs.size(); ++processed) {
+        const auto [lhs_state, rhs_state]{ pairs[processed] };
+        sync_iterator.reset();
+        Mata::Util::push_back(sync_iterator, lhs_delta[lhs_state]);
+        Mata::Util::push_back(sync_iterator, rhs_delta[rhs_state]);
+        while (sync_iterator.advance()) {
+            sync_iterator.get_current(moves);
+            for (const State lhs_target: moves[0]->targets) {
+                for (const State rhs_target: moves[1]->targets) {
+                    if (explore(lhs_target, rhs_target, processed, moves[0]->symbol)) { return false; }
+                }
+            }
+        }
+    }
+    return true;
+} // is_intersection_empty().
+
+bool is_intersection_empty(const ConstAutRefSequence& nfas, Run* cex) {
+    if (nfas.size() == 2) { return is_intersection_empty(nfas[0], nfas[1], cex); }
+    const size_t num_of_nfas{ nfas.size() };
+
+    // Explored tuples of states of the automata, their ids index parents.
+    TupleStore tuples{ num_of_nfas };
+    std::vector<std::pair<size_t, Symbol>> parents{};
+    TupleEnumerator enumerator{ num_of_nfas };
+
+    /// Explore the current tuple of @c enumerator reached from @p parent. @return True iff the tuple is accepting.
+    const auto explore = [&](const size_t parent, const Symbol symbol) {
+        const std::vector<State>& tuple{ enumerator.get_tuple() };
+        const auto [id, is_new]{ tuples.insert(tuple) };
+        if (!is_new) { return false; }
+        parents.emplace_back(parent, symbol);
+        for (size_t nfa{ 0 }; nfa < num_of_nfas; ++nfa) {
+            if (!nfas[nfa].get().final[tuple[nfa]]) { return false; }
+        }
+        fill_counterexample(parents, id, cex);
+        return true;
+    };
+
+    std::vector<std::vector<State>> initial_states{};
+    for (const Nfa& nfa: nfas) { initial_states.push_back(StateSet(nfa.initial).ToVector()); }
+    for (size_t nfa{ 0 }; nfa < num_of_nfas; ++nfa) { enumerator.sets[nfa] = initial_states[nfa]; }
+    if (enumerator.for_each([&]() { return explore(NO_PARENT, 0); })) { return false; }
+
+    std::vector<FrozenDelta> deltas{};
+    deltas.reserve(num_of_nfas);
+    for (const Nfa& nfa: nfas) { deltas.emplace_back(nfa.delta); }
+    Mata::Util::SynchronizedUniversalIterator<FrozenPost::const_iterator> sync_iterator(num_of_nfas);
+    std::span<const FrozenPost::const_iterator> moves{};
+    std::vector<State> source(num_of_nfas);
+    for (size_t processed{ 0 }; processed < tuples.size(); ++processed) {
+        const std::span<const State> stored_source{ tuples[static_cast<TupleStore::Id>(processed)] };
+        source.assign(stored_source.begin(), stored_source.end()); // The view is invalidated by insertions.
+        sync_iterator.reset();
+        for (size_t nfa{ 0 }; nfa < num_of_nfas; ++nfa) { Mata::Util::push_back(sync_iterator, deltas[nfa][source[nfa]]); }
+        while (sync_iterator.advance()) {
+            sync_iterator.get_current(moves);
+            const Symbol symbol{ moves[0]->symbol };
+            for (size_t nfa{ 0 }; nfa < num_of_nfas; ++nfa) { enumerator.sets[nfa] = moves[nfa]->targets; }
+            if (enumerator.for_each([&]() { return explore(processed, symbol); })) { return false; }
+        }
+    }
+    return true;
+} // is_intersection_empty(n-ary).
+
+Nfa intersection(const ConstAutRefSequence& nfas) {
+    if (nfas.empty()) {
+        throw std::runtime_error(std::to_string(__func__) + " requires at least one automaton");
+    }
+    const size_t num_of_nfas{ nfas.size() };
+
+    // A tuple with a useless state of some automaton cannot be useful in the product, such tuples are not explored.
+    std::vector<BoolVector> is_useful{};
+    for (const Nfa& nfa: nfas) { is_useful.push_back(nfa.get_useful_states()); }
+    // Useful targets of the current moves of each automaton.
+    std::vector<std::vector<State>> useful_states(num_of_nfas);
+    const auto set_useful_states = [&](const size_t nfa, const auto& states) {
+        useful_states[nfa].clear();
+        for (const State state: states) {
+            if (is_useful[nfa][state]) { useful_states[nfa].push_back(state); }
+        }
+    };
+
+    // Explored tuples of states of the automata, the ids of the tuples are the product states.
+    TupleStore tuples{ num_of_nfas };
+    TupleEnumerator enumerator{ num_of_nfas };
+    for (size_t nfa{ 0 }; nfa < num_of_nfas; ++nfa) {
+        set_useful_states(nfa, StateSet(nfas[nfa].get().initial));
+        enumerator.sets[nfa] = useful_states[nfa];
+    }
+    Nfa product{};
+    enumerator.for_each([&]() {
+        product.initial.insert(tuples.insert(enumerator.get_tuple()).first);
+        return false;
+    });
+
+    std::vector<FrozenDelta> deltas{};
+    deltas.reserve(num_of_nfas);
+    for (const Nfa& nfa: nfas) { deltas.emplace_back(nfa.delta); }
+    Mata::Util::SynchronizedUniversalIterator<FrozenPost::const_iterator> sync_iterator(num_of_nfas);
+    std::span<const FrozenPost::const_iterator> moves{};
+    std::vector<State> source(num_of_nfas);
+    product.delta.start_bulk();
+    for (size_t processed{ 0 }; processed < tuples.size(); ++processed) {
+        const std::span<const State> stored_source{ tuples[static_cast<TupleStore::Id>(processed)] };
+        source.assign(stored_source.begin(), stored_source.end()); // The view is invalidated by insertions.
+        const State product_source{ static_cast<State>(processed) };
+        bool is_final{ true };
+        for (size_t nfa{ 0 }; nfa < num_of_nfas && is_final; ++nfa) { is_final = nfas[nfa].get().final[source[nfa]]; }
+        if (is_final) { product.final.insert(product_source); }
+
+        sync_iterator.reset();
+        for (size_t nfa{ 0 }; nfa < num_of_nfas; ++nfa) { Mata::Util::push_back(sync_iterator, deltas[nfa][source[nfa]]); }
+        while (sync_iterator.advance()) {
+            sync_iterator.get_current(moves);
+            const Symbol symbol{ moves[0]->symbol };
+            for (size_t nfa{ 0 }; nfa < num_of_nfas; ++nfa) {
+                set_useful_states(nfa, moves[nfa]->targets);
+                enumerator.sets[nfa] = useful_states[nfa];
+            }
+            enumerator.for_each([&]() {
+                product.delta.add_unsorted(product_source, symbol, tuples.insert(enumerator.get_tuple()).first);
+                return false;
+            });
+        }
+    }
+    product.delta.finalize();
+    if (!tuples.empty()) { product.add_state(static_cast<State>(tuples.size() - 1)); }
+    return product;
+} // intersection(n-ary).
+
+Nfa intersection(const Nfa& lhs, const Nfa& rhs, const ParallelOptions& options,
+                 std::unordered_map<std::pair<State, State>, State> *prod_map) {
+    const size_t num_of_threads{ Mata::Util::get_num_of_threads(options.threads) };
+    if (num_of_threads <= 1) { return intersection(lhs, rhs, false, prod_map); }
+
+    // Product states of the current level of the breadth-first exploration. Threads of a level claim chunks of the
+    //  level from next_chunk, the states they create form the next level.
+    constexpr size_t CHUNK_SIZE{ 64 };
+    ShardedProductMap product_map{};
+    std::vector<ProductState> level{};
+    std::vector<State> initial_states{};
+    std::vector<ProductFragment> fragments(num_of_threads);
+    for (const State lhs_initial_state: lhs.initial) {
+        for (const State rhs_initial_state: rhs.initial) {
+            const State product_state{ product_map.get_or_insert(lhs_initial_state, rhs_initial_state).first };
+            level.push_back({ lhs_initial_state, rhs_initial_state, product_state });
+            initial_states.push_back(product_state);
+            if (lhs.final[lhs_initial_state] && rhs.final[rhs_initial_state]) {
+                fragments[0].final_states.push_back(product_state);
+            }
+        }
+    }
+
+    const FrozenDelta lhs_delta{ lhs.delta };
+    const FrozenDelta rhs_delta{ rhs.delta };
+    std::atomic<size_t> next_chunk{ 0 };
+    bool is_done{ level.empty() };
+    // Runs in a single thread when all threads have finished the level.
+    const auto start_next_level = [&]() noexcept {
+        level.clear();
+        for (ProductFragment& fragment: fragments) {
+            level.insert(level.end(), fragment.created_states.begin(), fragment.created_states.end());
+            fragment.created_states.clear();
+        }
+        next_chunk.store(0);
+        is_done = level.empty();
+    };
+    std::barrier level_barrier{ static_cast<std::ptrdiff_t>(num_of_threads), start_next_level };
+
+    const auto process = [&](ProductFragment& fragment, const ProductState& source) {
+        fragment.sync_iterator.reset();
+        Mata::Util::push_back(fragment.sync_iterator, lhs_delta[source.lhs_state]);
+        Mata::Util::push_back(fragment.sync_iterator, rhs_delta[source.rhs_state]);
+        while (fragment.sync_iterator.advance()) {
+            fragment.sync_iterator.get_current(fragment.moves);
+            const Symbol symbol{ fragment.moves[0]->symbol };
+            for (const State lhs_target: fragment.moves[0]->targets) {
+                for (const State rhs_target: fragment.moves[1]->targets) {
+                    const auto [product_target, is_new]{ product_map.get_or_insert(lhs_target, rhs_target) };
+                    if (is_new) {
+                        fragment.created_states.push_back({ lhs_target, rhs_target, product_target });
+                        if (lhs.final[lhs_target] && rhs.final[rhs_target]) {
+                            fragment.final_states.push_back(product_target);
+                        }
+                    }
+                    fragment.transitions.emplace_back(source.product_state, symbol, product_target);
+                }
+            }
+        }
+    };
+    const auto work = [&](const size_t thread) {
+        ProductFragment& fragment{ fragments[thread] };
+        while (!is_done) {
+            for (size_t begin{ next_chunk.fetch_add(CHUNK_SIZE) }; begin < level.size();
+                 begin = next_chunk.fetch_add(CHUNK_SIZE)) {
+                const size_t end{ std::min(begin + CHUNK_SIZE, level.size()) };
+                for (size_t index{ begin }; index < end; ++index) { process(fragment, level[index]); }
+            }
+            level_barrier.arrive_and_wait();
+        }
+    };
+
+    Mata::Util::run_threads(num_of_threads, level_barrier, work);
+
+    // Merge the fragments into the product.
+    Nfa product{};
+    if (product_map.size() > 0) { product.add_state(product_map.size() - 1); }
+    for (const State initial_state: initial_states) { product.initial.insert(initial_state); }
+    product.delta.start_bulk();
+    for (ProductFragment& fragment: fragments) {
+        for (const State final_state: fragment.final_states) { product.final.insert(final_state); }
+        for (const Trans& transition: fragment.transitions) { product.delta.add_unsorted(transition); }
+        fragment.transitions = {};
+    }
+    product.delta.finalize();
+
+    if (prod_map != nullptr) {
+        prod_map->clear();
+        product_map.for_each([prod_map](const State lhs_state, const State rhs_state, const State product_state) {
+            (*prod_map)[{ lhs_state, rhs_state }] = product_state;
+        });
+    }
+    return product;
+} // intersection(ParallelOptions).
+
+Nfa intersection(const Nfa& lhs, const Nfa& rhs, const StringMap& params,
+                 std::unordered_map<std::pair<State, State>, State> *prod_map) {
+    bool preserve_epsilon{ false };
+    if (Util::haskey(params, "preserve_epsilon")) {
+        const std::string& str_preserve_epsilon = params.at("preserve_epsilon");
+        if ("true" == str_preserve_epsilon) {
+            preserve_epsilon = true;
+        } else if ("false" != str_preserve_epsilon) {
+            throw std::runtime_error(std::to_string(__func__) +
+                                     " received an invalid value of the \"preserve_epsilon\" key: " +
+                                     str_preserve_epsilon);
+        }
+    }
+
+    Nfa product{ intersection(lhs, rhs, preserve_epsilon, prod_map) };
+    const std::vector<State> renaming{ Algorithms::reorder(product, params) };
+    if (prod_map != nullptr && !renaming.empty()) {
+        for (auto& [state_pair, product_state]: *prod_map) { product_state = renaming[product_state]; }
+    }
+    return product;
+} // intersection(params).
+
 Nfa Mata::Nfa::Algorithms::intersection_eps(const Nfa& lhs, const Nfa& rhs, bool preserve_epsilon, const std::set<Symbol>& epsilons,
-                 std::unordered_map<std::pair<State,State>, State> *prod_map) {
+                 std::unordered_map<std::pair<State,State>, State> *prod_map, const size_t product_matrix_budget) {
     Nfa product{}; // Product of the intersection.
     // Product map for the generated intersection mapping original state pairs to new product states.
-    std::unordered_map<std::pair<State,State>, State> product_map{};
+    ProductMap product_map{ lhs.size(), rhs.size(), product_matrix_budget };
     std::pair<State,State> pair_to_process{}; // State pair of original states currently being processed.
-    std::unordered_set<std::pair<State,State>> pairs_to_process{}; // Set of state pairs of original states to process.
+    std::vector<std::pair<State,State>> pairs_to_process{}; // Worklist of state pairs of original states to process.
 
     // Initialize pairs to process with initial state pairs.
     for (const State lhs_initial_state : lhs.initial) {
         for (const State rhs_initial_state : rhs.initial) {
             // Update product with initial state pairs.
-            const std::pair<State,State> this_and_other_initial_state_pair(lhs_initial_state, rhs_initial_state);
             const State new_intersection_state = product.add_state();
 
-            product_map[this_and_other_initial_state_pair] = new_intersection_state;
-            pairs_to_process.insert(this_and_other_initial_state_pair);
+            product_map.insert(lhs_initial_state, rhs_initial_state, new_intersection_state);
+            pairs_to_process.emplace_back(lhs_initial_state, rhs_initial_state);
 
             product.initial.insert(new_intersection_state);
             if (lhs.final[lhs_initial_state] && rhs.final[rhs_initial_state]) {
@@ -116,17 +519,24 @@ Nfa Mata::Nfa::Algorithms::intersection_eps(const Nfa& lhs, const Nfa& rhs, bool
         }
     }
 
+    // The product construction only reads the transitions of the operands, traverse their contiguous frozen copies.
+    const FrozenDelta lhs_delta{ lhs.delta };
+    const FrozenDelta rhs_delta{ rhs.delta };
+    Mata::Util::SynchronizedUniversalIterator<FrozenPost::const_iterator> sync_iterator(2);
+    std::span<const FrozenPost::const_iterator> moves{};
+
     while (!pairs_to_process.empty()) {
-        pair_to_process = *pairs_to_process.cbegin();
-        pairs_to_process.erase(pair_to_process);
+        pair_to_process = pairs_to_process.back();
+        pairs_to_process.pop_back();
+        const State product_source{ product_map.get(pair_to_process.first, pair_to_process.second) };
         // Compute classic product for current state pair.
 
-        Mata::Util::SynchronizedUniversalIterator<Mata::Util::OrdVector<Move>::const_iterator> sync_iterator(2);
-        Mata::Util::push_back(sync_iterator,lhs.delta[pair_to_process.first]);
-        Mata::Util::push_back(sync_iterator,rhs.delta[pair_to_process.second]);
+        sync_iterator.reset();
+        Mata::Util::push_back(sync_iterator, lhs_delta[pair_to_process.first]);
+        Mata::Util::push_back(sync_iterator, rhs_delta[pair_to_process.second]);
 
         while (sync_iterator.advance()) {
-            std::vector<Post::const_iterator> moves = sync_iterator.get_current();
+            sync_iterator.get_current(moves);
             assert(moves.size() == 2); // One move per state in the pair.
 
             // Compute product for state transitions with same symbols.
@@ -144,14 +554,14 @@ Nfa Mata::Nfa::Algorithms::intersection_eps(const Nfa& lhs, const Nfa& rhs, bool
                     );
                 }
             }
-            add_product_transition(product, product_map, pair_to_process, intersection_transition);
+            add_product_transition(product, product_source, intersection_transition);
         }
 
         if (preserve_epsilon) {
             // Add transitions of the current state pair for an epsilon preserving product.
 
             // Check for lhs epsilon transitions.
-            const Post& lhs_post{ lhs.delta[pair_to_process.first] };
+            const FrozenPost lhs_post{ lhs_delta[pair_to_process.first] };
             if (!lhs_post.empty()) {
                 const auto& lhs_state_last_transitions{ lhs_post.back() };
                 if (epsilons.find(lhs_state_last_transitions.symbol) != epsilons.end()) {
@@ -164,12 +574,12 @@ Nfa Mata::Nfa::Algorithms::intersection_eps(const Nfa& lhs, const Nfa& rhs, bool
                                                        lhs_state_to, pair_to_process.second,
                                                        intersection_transition);
                     }
-                    add_product_transition(product, product_map, pair_to_process, intersection_transition);
+                    add_product_transition(product, product_source, intersection_transition);
                 }
             }
 
             // Check for rhs epsilon transitions in case only rhs has any transitions and add them.
-            const Post& rhs_post{ rhs.delta[pair_to_process.second]};
+            const FrozenPost rhs_post{ rhs_delta[pair_to_process.second] };
             if (!rhs_post.empty()) {
                 const auto& rhs_state_last_transitions{ rhs_post.back()};
                 if (epsilons.find(rhs_state_last_transitions.symbol) != epsilons.end()) {
@@ -182,13 +592,19 @@ Nfa Mata::Nfa::Algorithms::intersection_eps(const Nfa& lhs, const Nfa& rhs, bool
                                                        pair_to_process.first, rhs_state_to,
                                                        intersection_transition);
                     }
-                    add_product_transition(product, product_map, pair_to_process, intersection_transition);
+                    add_product_transition(product, product_source, intersection_transition);
                 }
             }
         }
     }
 
-    if (prod_map != nullptr) { *prod_map = product_map; }
+    if (prod_map != nullptr) {
+        prod_map->clear();
+        prod_map->reserve(product_map.size());
+        product_map.for_each([prod_map](const State lhs_state, const State rhs_state, const State product_state) {
+            (*prod_map)[{ lhs_state, rhs_state }] = product_state;
+        });
+    }
     return product;
 } // intersection().
 
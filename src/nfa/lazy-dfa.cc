@@ -0,0 +1,65 @@
+/* lazy-dfa.cc -- Determinized automaton constructed on demand.
+ *
+ * This file is a part of libmata.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include <algorithm>
+
+#include "mata/nfa/lazy-dfa.hh"
+
+using namespace Mata::Nfa;
+using Mata::Symbol;
+
+LazyDfa::LazyDfa(const Nfa& aut, const size_t max_cached_transitions)
+    : aut{ aut }, delta{ aut.delta }, max_cached_transitions_{ max_cached_transitions },
+      initial_state_{ get_or_insert(StateSet(aut.initial).ToVector()) } {}
+
+State LazyDfa::get_or_insert(const std::span<const State> macrostate) {
+    const auto [id, is_new]{ macrostates.insert(macrostate) };
+    if (is_new) {
+        is_final_.push_back(std::any_of(macrostate.begin(), macrostate.end(),
+                                        [this](const State q) { return aut.final[q]; }));
+    }
+    return static_cast<State>(id);
+}
+
+State LazyDfa::post(const State dfa_state, const Symbol symbol) {
+    const std::pair<State, Symbol> transition{ dfa_state, symbol };
+    const auto cached{ transitions.find(transition) };
+    if (cached != transitions.end()) { return cached->second; }
+
+    const State target{ compute_post(dfa_state, symbol) };
+    if (transitions.size() >= max_cached_transitions_) { transitions.clear(); }
+    if (max_cached_transitions_ > 0) { transitions.emplace(transition, target); }
+    return target;
+}
+
+State LazyDfa::compute_post(const State dfa_state, const Symbol symbol) {
+    // The view of the macrostate is not used after the successor is inserted.
+    for (const State q: macrostates[static_cast<MacrostateStore::Id>(dfa_state)]) {
+        const FrozenPost post{ delta[q] };
+        const auto move{ post.find(symbol) };
+        if (move != post.end()) { targets_merger.add(move->begin(), move->end()); }
+    }
+    targets_merger.merge(targets_union);
+    return get_or_insert(targets_union);
+}
+
+bool Mata::Nfa::is_in_lang(LazyDfa& dfa, const Run& word) {
+    State current{ dfa.initial_state() };
+    for (const Symbol symbol: word.word) {
+        current = dfa.post(current, symbol);
+        if (dfa.is_empty(current)) { return false; }
+    }
+    return dfa.is_final(current);
+}
@@ -0,0 +1,224 @@
+/* macrostate-store.cc -- Store of interned sets of states for subset constructions.
+ *
+ * This file is a part of libmata.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include <algorithm>
+#include <cassert>
+#include <stdexcept>
+
+#include "mata/nfa/macrostate-store.hh"
+
+using namespace Mata::Nfa;
+
+size_t MacrostateStore::hash_of(std::span<const State> macrostate) {
+    size_t hash{ HASH_SEED };
+    for (const State state: macrostate) { hash = combine_hash(hash, state); }
+    return hash;
+}
+
+size_t MacrostateStore::find_slot(std::span<const State> macrostate, size_t hash) const {
+    const size_t mask{ table.size() - 1 };
+    size_t slot{ hash & mask };
+    while (table[slot] != NO_ID) {
+        const Id id{ table[slot] };
+        if (hashes[id] == hash && std::ranges::equal((*this)[id], macrostate)) { return slot; }
+        slot = (slot + 1) & mask;
+    }
+    return slot;
+}
+
+MacrostateStore::Id MacrostateStore::find(std::span<const State> macrostate) const {
+    return table[find_slot(macrostate, hash_of(macrostate))];
+}
+
+std::pair<MacrostateStore::Id, bool> MacrostateStore::insert_appended(const size_t start, const size_t hash) {
+    const std::span<const State> appended{ states.data() + start, states.data() + states.size() };
+    const size_t slot{ find_slot(appended, hash) };
+    if (table[slot] != NO_ID) {
+        states.resize(start);
+        return { table[slot], false };
+    }
+
+    if (size() >= NO_ID) {
+        throw std::runtime_error("MacrostateStore: the number of macrostates exceeds the range of macrostate ids");
+    }
+    const auto id{ static_cast<Id>(size()) };
+    table[slot] = id;
+    offsets.push_back(states.size());
+    hashes.push_back(hash);
+    // Keep the load factor of the table at most 1/2.
+    if (2 * size() > table.size()) { grow_table(); }
+    return { id, true };
+}
+
+void MacrostateStore::grow_table() {
+    table.assign(table.size() * 2, NO_ID);
+    const size_t mask{ table.size() - 1 };
+    for (Id id{ 0 }; id < size(); ++id) {
+        size_t slot{ hashes[id] & mask };
+        while (table[slot] != NO_ID) { slot = (slot + 1) & mask; }
+        table[slot] = id;
+    }
+}
+
+StateSet MacrostateStore::get_state_set(const Id id) const {
+    const std::span<const State> macrostate{ (*this)[id] };
+    StateSet result{ StateSet::with_reserved(macrostate.size()) };
+    // The stored macrostates are sorted, pushing back keeps the set sorted.
+    for (const State state: macrostate) { result.push_back(state); }
+    return result;
+}
+
+void MacrostateStore::clear() {
+    states.clear();
+    offsets.assign(1, 0);
+    hashes.clear();
+    table.assign(INITIAL_TABLE_SIZE, NO_ID);
+}
+
+void MacrostateStore::to_subset_map(std::unordered_map<StateSet, State>& subset_map) const {
+    subset_map.reserve(subset_map.size() + size());
+    for (Id id{ 0 }; id < size(); ++id) {
+        subset_map[get_state_set(id)] = id;
+    }
+}
+
+BitMacrostateStore::BitMacrostateStore(const size_t num_of_states)
+    : num_of_words_{ Util::BitWords::num_of_words(num_of_states) } {}
+
+std::vector<uint64_t> BitMacrostateStore::get_move_targets(const FrozenDelta& delta) const {
+    std::vector<uint64_t> move_targets(delta.num_of_moves() * num_of_words_, 0);
+    for (State state{ 0 }; state < delta.num_of_states(); ++state) {
+        const FrozenPost post{ delta[state] };
+        for (auto move{ post.cbegin() }; move != post.cend(); ++move) {
+            uint64_t* const targets{ move_targets.data() + delta.index_of(move) * num_of_words_ };
+            for (const State target: move->targets) { Util::BitWords::set(targets, target); }
+        }
+    }
+    return move_targets;
+}
+
+size_t BitMacrostateStore::find_slot(const uint64_t* words, const size_t hash) const {
+    const size_t mask{ table.size() - 1 };
+    size_t slot{ hash & mask };
+    while (table[slot] != NO_ID) {
+        const Id id{ table[slot] };
+        if (hashes[id] == hash && std::equal(words, words + num_of_words_, (*this)[id])) { return slot; }
+        slot = (slot + 1) & mask;
+    }
+    return slot;
+}
+
+BitMacrostateStore::Id BitMacrostateStore::find(const uint64_t* words) const {
+    return table[find_slot(words, Util::BitWords::hash(words, num_of_words_))];
+}
+
+std::pair<BitMacrostateStore::Id, bool> BitMacrostateStore::insert(const uint64_t* words) {
+    const size_t hash{ Util::BitWords::hash(words, num_of_words_) };
+    const size_t slot{ find_slot(words, hash) };
+    if (table[slot] != NO_ID) { return { table[slot], false }; }
+
+    if (size() >= NO_ID) {
+        throw std::runtime_error("BitMacrostateStore: the number of macrostates exceeds the range of macrostate ids");
+    }
+    const auto id{ static_cast<Id>(size()) };
+    table[slot] = id;
+    words_.insert(words_.end(), words, words + num_of_words_);
+    hashes.push_back(hash);
+    // Keep the load factor of the table at most 1/2.
+    if (2 * size() > table.size()) { grow_table(); }
+    return { id, true };
+}
+
+void BitMacrostateStore::grow_table() {
+    table.assign(table.size() * 2, NO_ID);
+    const size_t mask{ table.size() - 1 };
+    for (Id id{ 0 }; id < size(); ++id) {
+        size_t slot{ hashes[id] & mask };
+        while (table[slot] != NO_ID) { slot = (slot + 1) & mask; }
+        table[slot] = id;
+    }
+}
+
+StateSet BitMacrostateStore::get_state_set(const Id id) const {
+    StateSet result{};
+    Util::BitWords::for_each((*this)[id], num_of_words_, [&result](const size_t state) {
+        result.push_back(static_cast<State>(state));
+    });
+    return result;
+}
+
+void BitMacrostateStore::clear() {
+    words_.clear();
+    hashes.clear();
+    table.assign(INITIAL_TABLE_SIZE, NO_ID);
+}
+
+size_t TupleStore::hash_of(const std::span<const State> tuple) {
+    size_t hash{ 0x9e3779b97f4a7c15ULL };
+    for (const State state: tuple) {
+        hash ^= static_cast<size_t>(state) + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2);
+    }
+    return hash;
+}
+
+size_t TupleStore::find_slot(const std::span<const State> tuple, const size_t hash) const {
+    const size_t mask{ table.size() - 1 };
+    size_t slot{ hash & mask };
+    while (table[slot] != NO_ID) {
+        const Id id{ table[slot] };
+        if (hashes[id] == hash && std::ranges::equal((*this)[id], tuple)) { return slot; }
+        slot = (slot + 1) & mask;
+    }
+    return slot;
+}
+
+TupleStore::Id TupleStore::find(const std::span<const State> tuple) const {
+    assert(tuple.size() == arity_);
+    return table[find_slot(tuple, hash_of(tuple))];
+}
+
+std::pair<TupleStore::Id, bool> TupleStore::insert(const std::span<const State> tuple) {
+    assert(tuple.size() == arity_);
+    const size_t hash{ hash_of(tuple) };
+    const size_t slot{ find_slot(tuple, hash) };
+    if (table[slot] != NO_ID) { return { table[slot], false }; }
+
+    if (size() >= NO_ID) {
+        throw std::runtime_error("TupleStore: the number of tuples exceeds the range of tuple ids");
+    }
+    const auto id{ static_cast<Id>(size()) };
+    table[slot] = id;
+    states.insert(states.end(), tuple.begin(), tuple.end());
+    hashes.push_back(hash);
+    // Keep the load factor of the table at most 1/2.
+    if (2 * size() > table.size()) { grow_table(); }
+    return { id, true };
+}
+
+void TupleStore::grow_table() {
+    table.assign(table.size() * 2, NO_ID);
+    const size_t mask{ table.size() - 1 };
+    for (Id id{ 0 }; id < size(); ++id) {
+        size_t slot{ hashes[id] & mask };
+        while (table[slot] != NO_ID) { slot = (slot + 1) & mask; }
+        table[slot] = id;
+    }
+}
+
+void TupleStore::clear() {
+    states.clear();
+    hashes.clear();
+    table.assign(INITIAL_TABLE_SIZE, NO_ID);
+}
@@ -0,0 +1,232 @@
+/* minimize.cc -- Minimization of deterministic automata by partition refinement
+ *
+ * This file is a part of libmata.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+
+// MATA headers
+#include "mata/nfa/nfa.hh"
+#include "mata/nfa/algorithms.hh"
+
+using namespace Mata::Nfa;
+using Mata::Symbol;
+
+namespace {
+
+/**
+ * Refinable partition of elements 0, ..., n - 1 into sets (Valmari, Lehtinen: Efficient minimization of DFAs with
+ *  partial transition functions, 2008).
+ *
+ * Elements of each set are stored contiguously in @c elems, set s occupying elems[first[s]] to elems[past[s] - 1].
+ *  Elements are marked by moving them to the beginning of their set, split() then splits every touched set into its
+ *  marked and unmarked part. The smaller part gets a new set index, which makes the refinement O(m log n).
+ */
+class RefinablePartition {
+public:
+    explicit RefinablePartition(const size_t num_of_elements)
+        : elems(num_of_elements), locations(num_of_elements), set_of(num_of_elements, 0),
+          first(num_of_elements + 1, 0), past(num_of_elements + 1, 0), marked(num_of_elements + 1, 0) {
+        std::iota(elems.begin(), elems.end(), 0);
+        std::iota(locations.begin(), locations.end(), 0);
+        if (num_of_elements > 0) {
+            num_of_sets = 1;
+            past[0] = num_of_elements;
+        }
+        touched.reserve(num_of_elements);
+    }
+
+    size_t size() const { return num_of_sets; }
+    size_t set_of_element(const size_t element) const { return set_of[element]; }
+    size_t first_of_set(const size_t set) const { return first[set]; }
+    size_t past_of_set(const size_t set) const { return past[set]; }
+    size_t element_at(const size_t location) const { return elems[location]; }
+
+    void mark(const size_t element) {
+        const size_t set{ set_of[element] };
+        const size_t location{ locations[element] };
+        const size_t marked_end{ first[set] + marked[set] };
+        elems[location] = elems[marked_end];
+        locations[elems[location]] = location;
+        elems[marked_end] = element;
+        locations[element] = marked_end;
+        if (marked[set]++ == 0) { touched.push_back(set); }
+    }
+
+    void split() {
+        while (!touched.empty()) {
+            const size_t set{ touched.back() };
+            touched.pop_back();
+            const size_t marked_end{ first[set] + marked[set] };
+            if (marked_end == past[set]) {
+                marked[set] = 0;
+                continue;
+            }
+
+            // The smaller part becomes the new set.
+            if (marked[set] <= past[set] - marked_end) {
+                first[num_of_sets] = first[set];
+                past[num_of_sets] = first[set] = marked_end;
+            } else {
+                past[num_of_sets] = past[set];
+                first[num_of_sets] = past[set] = marked_end;
+            }
+            for (size_t location{ first[num_of_sets] }; location < past[num_of_sets]; ++location) {
+                set_of[elems[location]] = num_of_sets;
+            }
+            marked[set] = 0;
+            marked[num_of_sets] = 0;
+            ++num_of_sets;
+        }
+    }
+
+    /**
+     * Make each run of elements at consecutive locations with the same @p key a separate set. Used for the initial
+     *  partition, when elems are sorted by the key and there is only a single set.
+     */
+    template<class Key>
+    void split_sorted_by(const Key& key) {
+        for (size_t location{ 1 }; location < elems.size(); ++location) {
+            if (key(elems[location]) != key(elems[location - 1])) {
+                past[num_of_sets - 1] = location;
+                first[num_of_sets] = location;
+                past[num_of_sets] = elems.size();
+                ++num_of_sets;
+            }
+            set_of[elems[location]] = num_of_sets - 1;
+        }
+    }
+
+    /// Reorder elements of the only set by @p compare, before split_sorted_by().
+    template<class Compare>
+    void sort(const Compare& compare) {
+        std::sort(elems.begin(), elems.end(), compare);
+        for (size_t location{ 0 }; location < elems.size(); ++location) { locations[elems[location]] = location; }
+    }
+
+private:
+    size_t num_of_sets{ 0 };
+    std::vector<size_t> elems; ///< Elements ordered by sets.
+    std::vector<size_t> locations; ///< Location of each element in elems.
+    std::vector<size_t> set_of; ///< Set of each element.
+    std::vector<size_t> first; ///< First location of each set.
+    std::vector<size_t> past; ///< Location after the last location of each set.
+    std::vector<size_t> marked; ///< Number of marked elements of each set.
+    std::vector<size_t> touched{}; ///< Sets with marked elements.
+}; // class RefinablePartition.
+
+} // Anonymous namespace.
+
+Nfa Mata::Nfa::Algorithms::minimize_hopcroft(const Nfa& aut) {
+    if (!is_deterministic(aut)) { return minimize_hopcroft(determinize(aut)); }
+
+    // Keep only useful states, i.e., states reachable from the initial state from which a final state is reachable.
+    const BoolVector is_useful{ aut.get_useful_states() };
+    std::vector<State> useful{};
+    for (State state{ 0 }; state < is_useful.size(); ++state) {
+        if (is_useful[state]) { useful.push_back(state); }
+    }
+    Nfa result{};
+    result.add_state();
+    result.initial.insert(0);
+    if (useful.empty()) { return result; }
+
+    // Number the useful states consecutively and collect the transitions among them.
+    constexpr size_t NOT_USEFUL{ std::numeric_limits<size_t>::max() };
+    std::vector<size_t> state_index(aut.size(), NOT_USEFUL);
+    for (size_t index{ 0 }; index < useful.size(); ++index) { state_index[useful[index]] = index; }
+    const size_t num_of_states{ useful.size() };
+    std::vector<size_t> sources{};
+    std::vector<Symbol> symbols{};
+    std::vector<size_t> targets{};
+    for (const State state: useful) {
+        for (const Move& move: aut.delta[state]) {
+            const State target{ *move.targets.begin() };
+            if (state_index[target] == NOT_USEFUL) { continue; }
+            sources.push_back(state_index[state]);
+            symbols.push_back(move.symbol);
+            targets.push_back(state_index[target]);
+        }
+    }
+    const size_t num_of_transitions{ sources.size() };
+
+    // Blocks partition states, initially into final and non-final states. Cords partition transitions, initially by
+    //  their symbols.
+    RefinablePartition blocks{ num_of_states };
+    for (const State state: useful) {
+        if (aut.final[state]) { blocks.mark(state_index[state]); }
+    }
+    blocks.split();
+
+    RefinablePartition cords{ num_of_transitions };
+    cords.sort([&symbols](const size_t lhs, const size_t rhs) { return symbols[lhs] < symbols[rhs]; });
+    cords.split_sorted_by([&symbols](const size_t transition) { return symbols[transition]; });
+
+    // Transitions incoming to each state: in_transitions[in_offsets[q]] to in_transitions[in_offsets[q + 1] - 1].
+    std::vector<size_t> in_offsets(num_of_states + 1, 0);
+    for (const size_t target: targets) { ++in_offsets[target + 1]; }
+    std::partial_sum(in_offsets.begin(), in_offsets.end(), in_offsets.begin());
+    std::vector<size_t> in_transitions(num_of_transitions);
+    {
+        std::vector<size_t> positions(in_offsets.begin(), in_offsets.end() - 1);
+        for (size_t transition{ 0 }; transition < num_of_transitions; ++transition) {
+            in_transitions[positions[targets[transition]]++] = transition;
+        }
+    }
+
+    // Split blocks by sources of cords and cords by targets in blocks until both partitions are stable.
+    size_t block{ 1 };
+    size_t cord{ 0 };
+    while (cord < cords.size()) {
+        for (size_t location{ cords.first_of_set(cord) }; location < cords.past_of_set(cord); ++location) {
+            blocks.mark(sources[cords.element_at(location)]);
+        }
+        blocks.split();
+        ++cord;
+        while (block < blocks.size()) {
+            for (size_t location{ blocks.first_of_set(block) }; location < blocks.past_of_set(block); ++location) {
+                const size_t state{ blocks.element_at(location) };
+                for (size_t in{ in_offsets[state] }; in < in_offsets[state + 1]; ++in) {
+                    cords.mark(in_transitions[in]);
+                }
+            }
+            cords.split();
+            ++block;
+        }
+    }
+
+    // Blocks are the states of the result. The block of the initial state is renumbered to 0.
+    const size_t initial_block{ blocks.set_of_element(state_index[*aut.initial.begin()]) };
+    const auto block_state = [initial_block](const size_t block) {
+        if (block == initial_block) { return State{ 0 }; }
+        return static_cast<State>(block == 0 ? initial_block : block);
+    };
+    for (size_t block_index{ 1 }; block_index < blocks.size(); ++block_index) { result.add_state(); }
+    for (const State state: useful) {
+        if (aut.final[state]) { result.final.insert(block_state(blocks.set_of_element(state_index[state]))); }
+    }
+    // Transitions of each block are the transitions of its first state.
+    result.delta.start_bulk();
+    for (size_t transition{ 0 }; transition < num_of_transitions; ++transition) {
+        const size_t source{ sources[transition] };
+        const size_t source_block{ blocks.set_of_element(source) };
+        if (blocks.element_at(blocks.first_of_set(source_block)) == source) {
+            result.delta.add_unsorted(block_state(source_block), symbols[transition],
+                                      block_state(blocks.set_of_element(targets[transition])));
+        }
+    }
+    result.delta.finalize();
+    return result;
+}
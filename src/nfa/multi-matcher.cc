@@ -0,0 +1,105 @@
+/* multi-matcher.cc -- Matching words against many automata at once.
+ *
+ * This file is a part of libmata.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include <span>
+
+#include "mata/nfa/multi-matcher.hh"
+
+using namespace Mata::Nfa;
+using Mata::Symbol;
+
+namespace {
+
+/**
+ * Create the union of @p patterns with the states of each pattern shifted after the states of the previous patterns,
+ *  recording the pattern of each state of the union in @p pattern_of. Epsilon transitions are removed.
+ */
+Nfa create_tagged_union(const ConstAutRefSequence& patterns, std::vector<MultiMatcher::PatternId>& pattern_of) {
+    size_t num_of_states{ 0 };
+    for (const Nfa& pattern: patterns) { num_of_states += pattern.size(); }
+    Nfa result{ num_of_states };
+    pattern_of.reserve(num_of_states);
+
+    bool has_epsilon{ false };
+    std::vector<State> targets{};
+    for (MultiMatcher::PatternId pattern_id{ 0 }; pattern_id < patterns.size(); ++pattern_id) {
+        const Nfa& pattern{ patterns[pattern_id] };
+        const State offset{ static_cast<State>(pattern_of.size()) };
+        pattern_of.resize(pattern_of.size() + pattern.size(), pattern_id);
+        for (const State state: pattern.initial) { result.initial.insert(offset + state); }
+        for (const State state: pattern.final) { result.final.insert(offset + state); }
+        for (State state{ 0 }; state < pattern.delta.num_of_states(); ++state) {
+            Post& post{ result.delta.get_mutable_post(offset + state) };
+            post.reserve(pattern.delta[state].size());
+            for (const Move& move: pattern.delta[state]) {
+                // Shifting keeps the targets sorted.
+                targets.clear();
+                for (const State target: move.targets) { targets.push_back(offset + target); }
+                post.push_back(Move{ move.symbol, StateSet(targets) });
+                has_epsilon = has_epsilon || move.symbol == EPSILON;
+            }
+        }
+    }
+    if (has_epsilon) { result.remove_epsilon(); }
+    return result;
+}
+
+} // Anonymous namespace.
+
+MultiMatcher::MultiMatcher(const ConstAutRefSequence& patterns, const size_t max_cached_transitions)
+    : num_of_patterns_{ patterns.size() }, union_aut{ create_tagged_union(patterns, pattern_of_) },
+      lazy_dfa{ union_aut, max_cached_transitions } {}
+
+template<class Symbols>
+State MultiMatcher::run(const Symbols& symbols) {
+    State dfa_state{ lazy_dfa.initial_state() };
+    for (const auto symbol: symbols) {
+        dfa_state = lazy_dfa.post(dfa_state, static_cast<Symbol>(symbol));
+        if (lazy_dfa.is_empty(dfa_state)) { break; }
+    }
+    return dfa_state;
+}
+
+const std::vector<MultiMatcher::PatternId>& MultiMatcher::get_accepted_patterns(const State dfa_state) {
+    if (dfa_state >= accepted_patterns.size()) {
+        accepted_patterns.resize(lazy_dfa.num_of_explored_states());
+        is_accepted_computed.resize(lazy_dfa.num_of_explored_states(), false);
+    }
+    std::vector<PatternId>& patterns{ accepted_patterns[dfa_state] };
+    if (!is_accepted_computed[dfa_state]) {
+        is_accepted_computed[dfa_state] = true;
+        if (lazy_dfa.is_final(dfa_state)) {
+            // States of the macrostate are sorted, so are their patterns.
+            for (const State state: lazy_dfa.get_macrostate(dfa_state)) {
+                if (union_aut.final[state] && (patterns.empty() || patterns.back() != pattern_of_[state])) {
+                    patterns.push_back(pattern_of_[state]);
+                }
+            }
+        }
+    }
+    return patterns;
+}
+
+std::vector<MultiMatcher::PatternId> MultiMatcher::match(const std::vector<Symbol>& word) {
+    return get_accepted_patterns(run(word));
+}
+
+std::vector<MultiMatcher::PatternId> MultiMatcher::match(const uint8_t* const data, const size_t length) {
+    return get_accepted_patterns(run(std::span<const uint8_t>{ data, length }));
+}
+
+bool MultiMatcher::matches_any(const std::vector<Symbol>& word) {
+    return lazy_dfa.is_final(run(word));
+}
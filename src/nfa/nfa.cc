@@ -180,7 +180,7 @@ namespace {
      * @param[out] digraph Digraph to add computed transitions to.
      */
     void collect_directed_transitions(const Nfa& nfa, const Symbol abstract_symbol, Nfa& digraph) {
-        const State num_of_states{nfa.size() };
+        const State num_of_states{ static_cast<State>(nfa.size()) };
         for (State src_state{ 0 }; src_state < num_of_states; ++src_state) {
             for (const Move& move: nfa.delta[src_state]) {
                 for (const State tgt_state: move.targets) {
@@ -193,11 +193,53 @@ namespace {
             }
         }
     }
+
+    /**
+     * Remove states of @p nfa which are not staying and renumber the staying states keeping their order.
+     * @param[in] is_staying Bool array for states staying in the automaton, at least as large as its delta.
+     * @param[out] state_map Mapping of staying states to their new numbers.
+     */
+    void remove_states(Nfa& nfa, const BoolVector& is_staying, StateToStateMap* state_map) {
+        std::vector<State> renaming(is_staying.size());
+
+        State j=0;
+        for(State i = 0; i<is_staying.size(); i++) {
+            if (is_staying[i]) {
+                renaming[i] = j;
+                j++;
+            }
+        }
+
+        nfa.delta.defragment(is_staying, renaming);
+
+        auto is_state_staying = [&is_staying](State q){return q < is_staying.size() && is_staying[q];};
+        nfa.initial.filter(is_state_staying);
+        nfa.final.filter(is_state_staying);
+        auto rename_state = [&renaming](State q){return renaming[q];};
+        nfa.initial.rename(rename_state);
+        nfa.final.rename(rename_state);
+        nfa.initial.truncate();
+        nfa.final.truncate();
+
+        // TODO : this is actually only used in one test, remove state map?
+        if (state_map) {
+            state_map->clear();
+            state_map->reserve(is_staying.size());
+            for (State q=0;q<is_staying.size();q++)
+                if (is_staying[q])
+                    (*state_map)[q] = renaming[q];
+        }
+    }
 }
 
-void Nfa::remove_epsilon(const Symbol epsilon)
-{
-    *this = Mata::Nfa::remove_epsilon(*this, epsilon);
+void Nfa::revert_inplace() {
+    // The reverse index is a copy of the transitions, so the posts can be overwritten by the reverted ones. Clearing a
+    //  post frees the target sets of its moves, only the move array itself is reused.
+    const ReverseDelta reverse{ delta };
+    for (State state{ 0 }; state < reverse.num_of_states(); ++state) {
+        reverse.get_reverted_post(state, delta.get_mutable_post(state));
+    }
+    std::swap(initial, final);
 }
 
 StateSet Nfa::get_reachable_states() const
@@ -219,7 +261,30 @@ StateSet Nfa::get_reachable_states() const
 
 StateSet Nfa::get_terminating_states() const
 {
-    return revert(*this).get_reachable_states();
+    // Search backward from the final states over the transitions incoming to the visited states.
+    const ReverseDelta reverse{ delta };
+    BoolVector is_terminating(size(), false);
+    std::vector<State> worklist{};
+    for (const State final_state: final) {
+        is_terminating[final_state] = true;
+        worklist.push_back(final_state);
+    }
+    while (!worklist.empty()) {
+        const State state{ worklist.back() };
+        worklist.pop_back();
+        for (const ReverseDelta::InTransition& in_transition: reverse.pre(state)) {
+            if (!is_terminating[in_transition.source]) {
+                is_terminating[in_transition.source] = true;
+                worklist.push_back(in_transition.source);
+            }
+        }
+    }
+
+    StateSet terminating_states{};
+    for (State state{ 0 }; state < is_terminating.size(); ++state) {
+        if (is_terminating[state]) { terminating_states.push_back(state); }
+    }
+    return terminating_states;
 }
 
 //TODO: probably can be removed, trim_inplace is faster.
@@ -244,35 +309,192 @@ void Nfa::trim_inplace(StateToStateMap* state_map)
     BoolVector useful_states{ get_useful_states() };
 #endif
 
-    std::vector<State> renaming(useful_states.size());
+    remove_states(*this, useful_states, state_map);
+}
 
-    State j=0;
-    for(State i = 0; i<useful_states.size(); i++) {
-        if (useful_states[i]) {
-            renaming[i] = j;
-            j++;
+void Nfa::incremental_trim(StateToStateMap* state_map, const double defragment_threshold) {
+    IncrementalTrimState& trim_state{ incremental_trim_state };
+    // All states are useful after a full trim or a compaction of the tombstones.
+    const auto restart_from_useful_states = [&]() {
+        const size_t num_of_states{ size() };
+        trim_state.is_reachable.assign(num_of_states, true);
+        trim_state.is_terminating.assign(num_of_states, true);
+        trim_state.is_tombstone.assign(num_of_states, false);
+        trim_state.num_of_tombstones = 0;
+        trim_state.predecessors.assign(num_of_states, {});
+        for (State source{ 0 }; source < delta.num_of_states(); ++source) {
+            for (const Move& move: delta[source]) {
+                for (const State target: move.targets) { trim_state.predecessors[target].push_back(source); }
+            }
         }
+    };
+    const auto start_tracking = [&]() {
+        trim_state.initial.assign(initial.begin(), initial.end());
+        trim_state.final.assign(final.begin(), final.end());
+        trim_state.is_active = true;
+        delta.track_changes();
+    };
+
+    const DeltaChanges* changes{ delta.get_changes() };
+    if (!trim_state.is_active || changes == nullptr || changes->is_untracked) {
+        trim_inplace(state_map);
+        restart_from_useful_states();
+        start_tracking();
+        return;
     }
 
-    delta.defragment(useful_states, renaming);
+    const size_t num_of_states{ size() };
+    const size_t num_of_old_states{ trim_state.is_reachable.size() };
+    BoolVector& is_reachable{ trim_state.is_reachable };
+    BoolVector& is_terminating{ trim_state.is_terminating };
+    BoolVector& is_tombstone{ trim_state.is_tombstone };
+    std::vector<std::vector<State>>& predecessors{ trim_state.predecessors };
+    is_reachable.resize(num_of_states, false);
+    is_terminating.resize(num_of_states, false);
+    is_tombstone.resize(num_of_states, false);
+    predecessors.resize(num_of_states);
+    for (const Trans& trans: changes->added) { predecessors[trans.tgt].push_back(trans.src); }
+
+    const auto has_transition = [this](const State source, const State target) {
+        const Post& post{ delta[source] };
+        return std::any_of(post.begin(), post.end(), [target](const Move& move) { return move.targets.count(target) > 0; });
+    };
+    // Predecessors of target, from which the sources of transitions no longer present are dropped.
+    const auto get_predecessors = [&](const State target) -> const std::vector<State>& {
+        std::vector<State>& sources{ predecessors[target] };
+        std::sort(sources.begin(), sources.end());
+        sources.erase(std::unique(sources.begin(), sources.end()), sources.end());
+        std::erase_if(sources, [&](const State source) { return !has_transition(source, target); });
+        return sources;
+    };
+
+    std::vector<State> worklist{};
+    std::vector<State> changed_states{}; // States whose reachability or termination may have changed.
+    std::vector<State> region{};
+    const auto set_flag = [&](BoolVector& flags, const State state, const bool value) {
+        if (state < num_of_states && flags[state] != value) {
+            flags[state] = value;
+            worklist.push_back(state);
+            changed_states.push_back(state);
+            if (!value) { region.push_back(state); }
+        }
+    };
 
-    auto is_state_useful = [&useful_states](State q){return q < useful_states.size() && useful_states[q];};
-    initial.filter(is_state_useful);
-    final.filter(is_state_useful);
-    auto rename_state = [&renaming](State q){return renaming[q];};
-    initial.rename(rename_state);
-    final.rename(rename_state);
-    initial.truncate();
-    final.truncate();
+    // Only states reachable from the targets of removed transitions and from removed initial states may have become
+    //  unreachable. Their reachability is recomputed from their predecessors outside of the region.
+    for (const Trans& trans: changes->removed) { set_flag(is_reachable, trans.tgt, false); }
+    for (const State state: trim_state.initial) {
+        if (!initial[state]) { set_flag(is_reachable, state, false); }
+    }
+    while (!worklist.empty()) {
+        const State state{ worklist.back() };
+        worklist.pop_back();
+        for (const Move& move: delta[state]) {
+            for (const State target: move.targets) { set_flag(is_reachable, target, false); }
+        }
+    }
+    for (const State state: region) {
+        const std::vector<State>& sources{ get_predecessors(state) };
+        if (initial[state] || std::any_of(sources.begin(), sources.end(),
+                                          [&](const State source) { return is_reachable[source]; })) {
+            set_flag(is_reachable, state, true);
+        }
+    }
+    for (const State state: initial) { set_flag(is_reachable, state, true); }
+    for (const Trans& trans: changes->added) {
+        if (is_reachable[trans.src] && delta.contains(trans.src, trans.symb, trans.tgt)) {
+            set_flag(is_reachable, trans.tgt, true);
+        }
+    }
+    while (!worklist.empty()) {
+        const State state{ worklist.back() };
+        worklist.pop_back();
+        for (const Move& move: delta[state]) {
+            for (const State target: move.targets) { set_flag(is_reachable, target, true); }
+        }
+    }
 
-    // TODO : this is actually only used in one test, remove state map?
-    if (state_map) {
+    // Symmetrically, only states reaching the sources of removed transitions and removed final states may have become
+    //  non-terminating.
+    region.clear();
+    for (const Trans& trans: changes->removed) { set_flag(is_terminating, trans.src, false); }
+    for (const State state: trim_state.final) {
+        if (!final[state]) { set_flag(is_terminating, state, false); }
+    }
+    while (!worklist.empty()) {
+        const State state{ worklist.back() };
+        worklist.pop_back();
+        for (const State source: get_predecessors(state)) { set_flag(is_terminating, source, false); }
+    }
+    for (const State state: region) {
+        const Post& post{ delta[state] };
+        if (final[state] || std::any_of(post.begin(), post.end(), [&](const Move& move) {
+                return std::any_of(move.targets.begin(), move.targets.end(),
+                                   [&](const State target) { return is_terminating[target]; });
+            })) {
+            set_flag(is_terminating, state, true);
+        }
+    }
+    for (const State state: final) { set_flag(is_terminating, state, true); }
+    for (const Trans& trans: changes->added) {
+        if (is_terminating[trans.tgt] && delta.contains(trans.src, trans.symb, trans.tgt)) {
+            set_flag(is_terminating, trans.src, true);
+        }
+    }
+    while (!worklist.empty()) {
+        const State state{ worklist.back() };
+        worklist.pop_back();
+        for (const State source: get_predecessors(state)) { set_flag(is_terminating, source, true); }
+    }
+
+    // Turn useless states into tombstones and revive tombstones which became useful. Other states did not change.
+    for (const Trans& trans: changes->added) {
+        changed_states.push_back(trans.src);
+        changed_states.push_back(trans.tgt);
+    }
+    for (State state{ static_cast<State>(num_of_old_states) }; state < num_of_states; ++state) {
+        changed_states.push_back(state);
+    }
+    std::sort(changed_states.begin(), changed_states.end());
+    changed_states.erase(std::unique(changed_states.begin(), changed_states.end()), changed_states.end());
+    const auto is_useful = [&](const State state) { return is_reachable[state] && is_terminating[state]; };
+    for (const State state: changed_states) {
+        if (is_useful(state) == !is_tombstone[state]) { continue; }
+        is_tombstone[state] = !is_useful(state);
+        if (is_tombstone[state]) { ++trim_state.num_of_tombstones; } else { --trim_state.num_of_tombstones; }
+    }
+    for (const State state: changed_states) {
+        if (!is_tombstone[state]) { continue; }
+        for (const State source: get_predecessors(state)) {
+            if (!is_useful(source)) { continue; }
+            Post& post{ delta.get_mutable_post(source) };
+            for (Move& move: post) {
+                if (move.targets.count(state) > 0) { move.targets.remove(state); }
+            }
+            post.erase(std::remove_if(post.begin(), post.end(), [](const Move& move) { return move.targets.empty(); }),
+                       post.end());
+        }
+        if (!delta[state].empty()) { delta.get_mutable_post(state).clear(); }
+        initial.erase(state);
+        final.erase(state);
+        is_reachable[state] = false;
+        is_terminating[state] = false;
+        predecessors[state].clear();
+    }
+
+    if (trim_state.num_of_tombstones > 0
+        && static_cast<double>(trim_state.num_of_tombstones) >= defragment_threshold * static_cast<double>(num_of_states)) {
+        BoolVector is_staying(num_of_states, false);
+        for (State state{ 0 }; state < num_of_states; ++state) { is_staying[state] = !is_tombstone[state]; }
+        remove_states(*this, is_staying, state_map);
+        restart_from_useful_states();
+    } else if (state_map) {
         state_map->clear();
-        state_map->reserve(useful_states.size());
-        for (State q=0;q<useful_states.size();q++)
-            if (useful_states[q])
-                (*state_map)[q] = renaming[q];
+        for (State state{ 0 }; state < num_of_states; ++state) {
+            if (!is_tombstone[state]) { (*state_map)[state] = state; }
+        }
     }
+    start_tracking();
 }
 
 Nfa Nfa::get_trimmed_automaton(StateToStateMap* state_map) const {
@@ -289,87 +511,35 @@ Nfa Nfa::get_trimmed_automaton(StateToStateMap* state_map) const {
 
     size_t new_state_num{ 0 };
     for (const State original_state: original_useful_states) {
-        (*state_map)[original_state] = new_state_num;
+        (*state_map)[original_state] = static_cast<State>(new_state_num);
         ++new_state_num;
     }
     return create_trimmed_aut(*this, *state_map);
 }
 
-// A data structure to store things in the depth first search within dfs in the trim.
-// It stores a state and the state of the iteration through the successors of the state.
-struct StackLevel {
-    State state;
-    Post::const_iterator post_it;
-    Post::const_iterator post_end;
-    StateSet::const_iterator targets_it{};
-    StateSet::const_iterator targets_end{};
-
-    StackLevel(State q, const Delta & delta) : state(q), post_it(delta[q].cbegin()), post_end(delta[q].cend()) {
-        if (post_it != post_end) {
-            targets_it = post_it->cbegin();
-            targets_end = post_it->cend();
-        }
-    };
-};
-
 BoolVector Nfa::get_useful_states() const
 {
-#ifdef _STATIC_STRUCTURES_
-    // STATIC SEEMS TO GIVE LIKE 5-10% SPEEDUP
-    static std::vector<StackLevel> stack;
-    //tracking elements seems to cost more than it saves, switching it off
-    BoolVector reached(size(),false);
-    BoolVector reached_and_reaching(size(),false);
-    stack.clear();
-    reached.clear();
-    reached_and_reaching.clear();
-#else
-    std::vector<StackLevel> stack;//the DFS stack
-    //tracking elements seems to cost more than it saves, switching it off
-    BoolVector reached(size(),false); // Reachable from initial state.
+    // A single DFS marking the states on its stack as reaching when it touches a reaching state misses states whose
+    //  path to final states goes through a state which is on the stack, but not known to be reaching yet. Terminating
+    //  states are therefore computed by a backward search from the reachable final states.
+    const StateBoolArray reached{ compute_reachability(*this) }; // Reachable from initial state.
     BoolVector reached_and_reaching(size(),false); // Reachable from initial state and reaches final state.
-#endif
-
-    for (const State q0: initial) {
-
-        stack.emplace_back(q0,delta);
-        reached[q0]=true;
-        if (final[q0])
-            reached_and_reaching[q0]=true;
-        while (!stack.empty()) {
-            StackLevel & level = stack.back();
-            //Continue the iteration through the successors of q (a shitty code. Is there a better way? What would be the needed interface for mata?)
-            while (level.post_it != level.post_end && level.targets_it == level.targets_end) {
-                if (level.targets_it == level.targets_end) {
-                    ++level.post_it;
-                    if (level.post_it != level.post_end) {
-                        level.targets_it = level.post_it->cbegin();
-                        level.targets_end = level.post_it->cend();
-                    }
-                } else
-                    ++level.targets_it;
-            }
-            if (level.post_it == level.post_end) {
-                stack.pop_back();
-            }
-            else {
-                State succ_state = *(level.targets_it);
-                ++level.targets_it;
-                if (final[succ_state])
-                    reached_and_reaching[succ_state]=true;
-                if (reached_and_reaching[succ_state])
-                {
-                    //A major trick, because of which one DFS is enough for reached as well as reaching.
-                    //On touching a state which reaches finals states, everything in the stack below reaches a final state.
-                    //An invariant of the stack is that everything below a reaching state is reaching.
-                    for (auto it = stack.crbegin(); it != stack.crend() && !reached_and_reaching[it->state]; it++) {
-                            reached_and_reaching[it->state]=true;
-                    }
-                }
-                if (!reached[succ_state]) {
-                    reached[succ_state]=true;
-                    stack.emplace_back(succ_state,delta);
-                }
+    std::vector<State> worklist{};
+    for (const State state: final) {
+        if (reached[state]) {
+            reached_and_reaching[state] = true;
+            worklist.push_back(state);
+        }
+    }
+    const ReverseDelta reverse{ delta };
+    while (!worklist.empty()) {
+        const State state{ worklist.back() };
+        worklist.pop_back();
+        for (const ReverseDelta::InTransition& in_transition: reverse.pre(state)) {
+            const State source{ in_transition.source };
+            if (reached[source] && !reached_and_reaching[source]) {
+                reached_and_reaching[source] = true;
+                worklist.push_back(source);
             }
         }
     }
@@ -507,14 +677,8 @@ void Nfa::get_one_letter_aut(Nfa& result) const {
 
 TransSequence Nfa::get_transitions_to(State state_to) const {
     TransSequence transitions_to_state{};
-    const size_t num_of_states{ delta.num_of_states() };
-    for (State state_from{ 0 }; state_from < num_of_states; ++state_from) {
-        for (const Move& state_from_move: delta[state_from]) {
-            const auto target_state{ state_from_move.targets.find(state_to) };
-            if (target_state != state_from_move.targets.end()) {
-                transitions_to_state.emplace_back(state_from, state_from_move.symbol, state_to );
-            }
-        }
+    for (const ReverseDelta::InTransition& in_transition: delta.pre(state_to)) {
+        transitions_to_state.emplace_back(in_transition.source, in_transition.symbol, state_to);
     }
     return transitions_to_state;
 }
@@ -549,7 +713,7 @@ Nfa::const_iterator Nfa::const_iterator::for_begin(const Nfa* nfa)
     result.nfa = nfa;
 
     for (size_t trIt{ 0 }; trIt < nfa->delta.num_of_states(); ++trIt) {
-        auto& moves{ nfa->get_moves_from(trIt) };
+        auto& moves{ nfa->get_moves_from(static_cast<State>(trIt)) };
         if (!moves.empty()) {
             auto move{ moves.begin() };
             while (move != moves.end()) {
@@ -582,7 +746,7 @@ Nfa::const_iterator& Nfa::const_iterator::operator++()
     assert(nullptr != nfa);
 
     ++(this->ssIt);
-    const StateSet& state_set = this->tlIt->targets;
+    const Move::Targets& state_set = this->tlIt->targets;
     assert(!state_set.empty());
     if (this->ssIt != state_set.end())
     {
@@ -592,7 +756,7 @@ Nfa::const_iterator& Nfa::const_iterator::operator++()
 
     // out of state set
     ++(this->tlIt);
-    const Post& tlist = this->nfa->get_moves_from(this->trIt);
+    const Post& tlist = this->nfa->get_moves_from(static_cast<State>(this->trIt));
     assert(!tlist.empty());
     if (this->tlIt != tlist.end())
     {
@@ -607,16 +771,16 @@ Nfa::const_iterator& Nfa::const_iterator::operator++()
     assert(this->nfa->delta.begin() != this->nfa->delta.end());
 
     while (this->trIt < this->nfa->delta.num_of_states() &&
-           this->nfa->get_moves_from(this->trIt).empty())
+           this->nfa->get_moves_from(static_cast<State>(this->trIt)).empty())
     {
         ++this->trIt;
     }
 
     if (this->trIt < this->nfa->delta.num_of_states())
     {
-        this->tlIt = this->nfa->get_moves_from(this->trIt).begin();
-        assert(!this->nfa->get_moves_from(this->trIt).empty());
-        const StateSet& new_state_set = this->tlIt->targets;
+        this->tlIt = this->nfa->get_moves_from(static_cast<State>(this->trIt)).begin();
+        assert(!this->nfa->get_moves_from(static_cast<State>(this->trIt)).empty());
+        const Move::Targets& new_state_set = this->tlIt->targets;
         assert(!new_state_set.empty());
         this->ssIt = new_state_set.begin();
 
@@ -771,13 +935,16 @@ Symbol Nfa::get_max_symbol() const {
 void Nfa::unify_final() {
     if (final.empty() || final.size() == 1) { return; }
     const State new_final_state{ add_state() };
+    // Collect all the new transitions first, the reverse index is not updated by adding transitions.
+    const ReverseDelta reverse{ delta };
+    TransSequence transitions_to_new_final_state{};
     for (const auto& orig_final_state: final) {
-        const auto transitions_to{ get_transitions_to(orig_final_state) };
-        for (const auto& transitions: transitions_to) {
-            delta.add(transitions.src, transitions.symb, new_final_state);
+        for (const ReverseDelta::InTransition& in_transition: reverse.pre(orig_final_state)) {
+            transitions_to_new_final_state.emplace_back(in_transition.source, in_transition.symbol, new_final_state);
         }
         if (initial[orig_final_state]) { initial.insert(new_final_state); }
     }
+    for (const Trans& transition: transitions_to_new_final_state) { delta.add(transition); }
     final.clear();
     final.insert(new_final_state);
 }
@@ -799,6 +966,7 @@ Nfa& Nfa::operator=(Nfa&& other) noexcept {
         final = std::move(other.final);
         alphabet = other.alphabet;
         attributes = std::move(other.attributes);
+        incremental_trim_state = std::move(other.incremental_trim_state);
         other.alphabet = nullptr;
     }
     return *this;
@@ -807,12 +975,12 @@ Nfa& Nfa::operator=(Nfa&& other) noexcept {
 void Nfa::clear_transitions() {
     const size_t delta_size = delta.num_of_states();
     for (size_t i = 0; i < delta_size; ++i) {
-        delta.get_mutable_post(i) = Post();
+        delta.get_mutable_post(static_cast<State>(i)) = Post();
     }
 }
 
 State Nfa::add_state() {
-    const size_t num_of_states{ size() };
+    const State num_of_states{ static_cast<State>(size()) };
     delta.increase_size(num_of_states + 1);
     return num_of_states;
 }
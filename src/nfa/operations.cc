@@ -19,12 +19,15 @@
 #include <list>
 #include <unordered_set>
 #include <iterator>
+#include <cctype>
 
 // MATA headers
 #include "mata/utils/sparse-set.hh"
+#include "mata/utils/k-way-merge.hh"
 #include "mata/nfa/nfa.hh"
 #include "mata/nfa/algorithms.hh"
 #include "mata/nfa/builder.hh"
+#include "mata/nfa/scc.hh"
 #include <mata/simlib/explicit_lts.hh>
 
 using std::tie;
@@ -37,6 +40,68 @@ using Mata::BoolVector;
 using StateBoolArray = std::vector<bool>; ///< Bool array for states in the automaton.
 
 namespace {
+    /**
+     * Subset construction with macrostates represented as bit sets, for automata with few states.
+     * @param[in] frozen_delta Transitions of @p aut.
+     * @param[out] macrostates Store of bit sets of states of @p aut, state q of the result is macrostate q.
+     */
+    Nfa determinize_with_bit_macrostates(const Nfa& aut, const FrozenDelta& frozen_delta,
+                                         BitMacrostateStore& macrostates) {
+        namespace BitWords = Mata::Util::BitWords;
+        const size_t num_of_words{ macrostates.num_of_words() };
+        Nfa result;
+
+        std::vector<uint64_t> final_states(num_of_words, 0);
+        for (const State q: aut.final) { BitWords::set(final_states.data(), q); }
+        std::vector<uint64_t> targets_union(num_of_words, 0);
+        for (const State q: aut.initial) { BitWords::set(targets_union.data(), q); }
+
+        const BitMacrostateStore::Id S0id{ macrostates.insert(targets_union.data()).first };
+        result.add_state();
+        result.initial.insert(S0id);
+        if (BitWords::intersects(targets_union.data(), final_states.data(), num_of_words)) {
+            result.final.insert(S0id);
+        }
+        if (frozen_delta.empty()) { return result; }
+
+        const std::vector<uint64_t> move_targets{ macrostates.get_move_targets(frozen_delta) };
+        using Iterator = FrozenPost::const_iterator;
+        Mata::Util::SynchronizedExistentialIterator<Iterator> synchronized_iterator;
+        std::vector<BitMacrostateStore::Id> worklist{ S0id };
+
+        while (!worklist.empty()) {
+            const BitMacrostateStore::Id Sid{ worklist.back() };
+            worklist.pop_back();
+
+            synchronized_iterator.reset();
+            BitWords::for_each(macrostates[Sid], num_of_words, [&](const size_t q) {
+                Mata::Util::push_back(synchronized_iterator, frozen_delta[static_cast<State>(q)]);
+            });
+
+            std::span<const Iterator> moves{};
+            while (synchronized_iterator.advance()) {
+                synchronized_iterator.get_current(moves);
+                const Symbol symbol{ (*moves.begin())->symbol };
+                std::fill(targets_union.begin(), targets_union.end(), 0);
+                for (const Iterator& move: moves) {
+                    BitWords::unite(targets_union.data(),
+                                    move_targets.data() + frozen_delta.index_of(move) * num_of_words, num_of_words);
+                }
+
+                const auto [Tid, is_new]{ macrostates.insert(targets_union.data()) };
+                if (is_new) {
+                    result.add_state();
+                    if (BitWords::intersects(targets_union.data(), final_states.data(), num_of_words)) {
+                        result.final.insert(Tid);
+                    }
+                    worklist.push_back(Tid);
+                }
+                result.delta.get_mutable_post(Sid).push_back(Move(symbol, static_cast<State>(Tid)));
+            }
+        }
+        return result;
+    }
+
     Simlib::Util::BinaryRelation compute_fw_direct_simulation(const Nfa& aut) {
         Symbol maxSymbol = 0;
         const size_t state_num = aut.size();
@@ -74,7 +139,7 @@ namespace {
 
 		// map each state q of aut to the state of the reduced automaton representing the simulation class of q
 		for (State q = 0; q < num_of_states; ++q) {
-			const State qReprState = quot_proj[q];
+			const State qReprState = static_cast<State>(quot_proj[q]);
 			if (state_map.count(qReprState) == 0) { // we need to map q's class to a new state in reducedAut
 				const State qClass = result.add_state();
 				state_map[qReprState] = qClass;
@@ -96,7 +161,7 @@ namespace {
                     const StateSet representatives_of_states_to = [&]{
                         StateSet state_set;
                         for (auto s : q_trans.targets) {
-                            state_set.insert(quot_proj[s]);
+                            state_set.insert(static_cast<State>(quot_proj[s]));
                         }
                         return state_set;
                     }();
@@ -145,7 +210,7 @@ bool Mata::Nfa::are_state_disjoint(const Nfa& lhs, const Nfa& rhs)
     lhs_states.insert(lhs.final.begin(), lhs.final.end());
 
     const size_t delta_size = lhs.delta.num_of_states();
-    for (size_t i = 0; i < delta_size; i++) {
+    for (State i = 0; i < delta_size; i++) {
         lhs_states.insert(i);
         for (const auto& symStates : lhs.delta[i])
         {
@@ -163,7 +228,7 @@ bool Mata::Nfa::are_state_disjoint(const Nfa& lhs, const Nfa& rhs)
     }
 
     const size_t lhs_post_size = lhs.delta.num_of_states();
-    for (size_t i = 0; i < lhs_post_size; i++) {
+    for (State i = 0; i < lhs_post_size; i++) {
         if (haskey(lhs_states, i))
             return false;
         for (const auto& symState : lhs.delta[i]) {
@@ -208,258 +273,96 @@ bool Mata::Nfa::make_complete(Nfa& aut, const Mata::Util::OrdVector<Symbol>& sym
     return was_something_added;
 }
 
-//TODO: based on the comments inside, this function needs to be rewritten in a more optimal way.
-Nfa Mata::Nfa::remove_epsilon(const Nfa& aut, Symbol epsilon) {
-    // cannot use multimap, because it can contain multiple occurrences of (a -> a), (a -> a)
-    std::unordered_map<State, StateSet> eps_closure;
-
-    // TODO: grossly inefficient
-    // first we compute the epsilon closure
-    const size_t num_of_states{aut.size() };
-    for (size_t i{ 0 }; i < num_of_states; ++i)
-    {
-        for (const auto& trans: aut.delta[i])
-        { // initialize
-            const auto it_ins_pair = eps_closure.insert({i, {i}});
-            if (trans.symbol == epsilon)
-            {
-                StateSet& closure = it_ins_pair.first->second;
-                // TODO: Fix possibly insert to OrdVector. Create list already ordered, then merge (do not need to resize each time);
-                closure.insert(trans.targets);
-            }
-        }
-    }
-
-    bool changed = true;
-    while (changed) { // Compute the fixpoint.
-        changed = false;
-        for (size_t i = 0; i < num_of_states; ++i) {
-            const Post& post{ aut.delta[i] };
-            const auto eps_move_it { post.find(Move{ epsilon}) };//TODO: make faster if default epsilon
-            if (eps_move_it != post.end()) {
-                StateSet& src_eps_cl = eps_closure[i];
-                for (const State tgt: eps_move_it->targets) {
-                    const StateSet& tgt_eps_cl = eps_closure[tgt];
-                    for (const State st: tgt_eps_cl) {
-                        if (src_eps_cl.count(st) == 0) {
-                            changed = true;
-                            break;
-                        }
-                    }
-                    src_eps_cl.insert(tgt_eps_cl);
+namespace {
+/**
+ * Compute the transitions of @p aut without epsilon transitions into @p result_delta and collect the states which
+ *  become final since their epsilon closures contain a final state in @p new_final_states.
+ */
+void remove_epsilon_transitions(const Nfa& aut, const Symbol epsilon, Delta& result_delta,
+                                std::vector<State>& new_final_states) {
+    // Compute the epsilon closures of the strongly connected components of the epsilon transitions, which are shared
+    //  by all states of the component, in a single pass from the last component in the topological order: the
+    //  closure of a component is the component itself with the closures of its epsilon successors.
+    const SccDecomposition sccs{ compute_sccs(aut, epsilon) };
+    const size_t num_of_components{ sccs.num_of_components() };
+    std::vector<std::vector<State>> component_closures(num_of_components); // Sorted closures of the components.
+    KWayMerger<State> closure_merger{};
+    std::vector<State> closure{};
+    for (size_t component{ num_of_components }; component > 0; --component) {
+        const std::span<const State> component_states{ sccs[component - 1] };
+        closure.assign(component_states.begin(), component_states.end());
+        std::sort(closure.begin(), closure.end());
+        closure_merger.add(closure.data(), closure.data() + closure.size());
+        for (const State state: component_states) {
+            const Post& post{ aut.delta[state] };
+            const auto eps_move_it{ post.find(epsilon) };
+            if (eps_move_it == post.end()) { continue; }
+            for (const State target: eps_move_it->targets) {
+                const size_t target_component{ sccs.component_of(target) };
+                if (target_component != component - 1) {
+                    const std::vector<State>& target_closure{ component_closures[target_component] };
+                    closure_merger.add(target_closure.data(), target_closure.data() + target_closure.size());
                 }
             }
         }
+        closure_merger.merge(component_closures[component - 1]);
     }
+    const auto eps_closure = [&](const State state) -> const std::vector<State>& {
+        return component_closures[sccs.component_of(state)];
+    };
 
-    // Construct the automaton without epsilon transitions.
-    Nfa result{ Delta{}, aut.initial, aut.final, aut.alphabet };
-    for (const auto& state_closure_pair : eps_closure) { // For every state.
-        State src_state = state_closure_pair.first;
-        for (State eps_cl_state : state_closure_pair.second) { // For every state in its epsilon closure.
-            if (aut.final[eps_cl_state]) result.final.insert(src_state);
+    // Construct the transitions without epsilon transitions.
+    result_delta.start_bulk();
+    const size_t num_of_states{ aut.size() };
+    for (State src_state{ 0 }; src_state < num_of_states; ++src_state) { // For every state.
+        bool is_final{ aut.final[src_state] };
+        for (State eps_cl_state : eps_closure(src_state)) { // For every state in its epsilon closure.
+            is_final = is_final || aut.final[eps_cl_state];
             for (const Move& move : aut.delta[eps_cl_state]) {
                 if (move.symbol == epsilon) continue;
-                // TODO: this could be done more efficiently if we had a better add method
                 for (State tgt_state : move.targets) {
-                    result.delta.add(src_state, move.symbol, tgt_state);
+                    result_delta.add_unsorted(src_state, move.symbol, tgt_state);
                 }
             }
         }
+        if (is_final && !aut.final[src_state]) { new_final_states.push_back(src_state); }
     }
-    return result;
+    result_delta.finalize();
 }
+} // Anonymous namespace.
 
-Nfa Mata::Nfa::fragile_revert(const Nfa& aut) {
-    const size_t num_of_states{ aut.size() };
-
-    Nfa result(num_of_states);
-
-    result.initial = aut.final;
-    result.final = aut.initial;
-
-    //COMPUTE NON-e SYMBOLS
-    //This stuff is ugly because of our handling of epsilon, what about negative numbers?
-    OrdVector<Symbol> symbols = aut.get_used_symbols();
-    if (symbols.empty())
-        return result;
-    if (symbols.back() == EPSILON)
-        symbols.pop_back();
-    // size of the "used alphabet", i.e. max symbol+1 or 0
-    Symbol alphasize =  (symbols.empty()) ? 0 : (symbols.back()+1);
-
-#ifdef _STATIC_STRUCTURES_
-    //STATIC DATA STRUCTURES:
-    // Not sure that it works ideally, whether the space for the inner vectors stays there.
-    static std::vector<std::vector<State>> sources;
-    static std::vector<std::vector<State>> targets;
-    static std::vector<State> e_sources;
-    static std::vector<State> e_targets;
-    if (alphasize>sources.size()) {
-        sources.resize(alphasize);
-        targets.resize(alphasize);
-    }
-
-    e_sources.clear();
-    e_targets.clear();
-
-    //WHEN ONLY MAX SYMBOL IS COMPUTED
-    // for (int i = 0;i<alphasize;i++) {
-    //     for (int i = 0;i<alphasize;i++) {
-    //         if (!sources[i].empty())
-    //         {
-    //             sources[i].resize(0);
-    //             targets[i].resize(0);
-    //         }
-    //     }
-    // }
-
-    //WHEN ALL SYMBOLS ARE COMPUTED
-    for (Symbol symbol: symbols) {
-        if(!sources[symbol].empty()) {
-            sources[symbol].clear();
-            targets[symbol].clear();
-        }
-    }
-#else
-    // NORMAL, NON STATIC DATA STRUCTURES:
-    //All transition of delta are to be copied here, into two arrays of transition sources and targets indexed by the transition symbol.
-    // There is a special treatment for epsilon, since we want the arrays to be only as long as the largest symbol in the automaton,
-    // and epsilon is the maximum (so we don't want to have the maximum array lenght whenever epsilon is present)
-    std::vector<std::vector<State>> sources (alphasize);
-    std::vector<std::vector<State>> targets (alphasize);
-    std::vector<State> e_sources;
-    std::vector<State> e_targets;
-#endif
-
-    //Copy all transition with non-e symbols to the arrays of sources and targets indexed by symbols.
-    //Targets and sources of e-transitions go to the special place.
-    //Important: since we are going through delta in order of sources, the sources arrays are all ordered.
-    for (State sourceState{ 0 }; sourceState < num_of_states; ++sourceState) {
-        for (const Move &move: aut.delta[sourceState]) {
-            if (move.symbol == EPSILON) {
-                for (const State targetState: move.targets) {
-                    //reserve_on_insert(e_sources);
-                    e_sources.push_back(sourceState);
-                    //reserve_on_insert(e_targets);
-                    e_targets.push_back(targetState);
-                }
-            }
-            else {
-                for (const State targetState: move.targets) {
-                    //reserve_on_insert(sources[move.symbol]);
-                    sources[move.symbol].push_back(sourceState);
-                    //reserve_on_insert(targets[move.symbol]);
-                    targets[move.symbol].push_back(targetState);
-                }
-            }
-        }
-    }
-
-    //Now make the delta of the reversed automaton.
-    //Important: since sources are ordered, when adding them as targets, we can just push them back.
-    result.delta.reserve(num_of_states);
-
-    // adding non-e transitions
-    for (const Symbol symbol: symbols) {
-        for (size_t i{ 0 }; i < sources[symbol].size(); ++i) {
-            State tgt_state =sources[symbol][i];
-            State src_state =targets[symbol][i];
-            Post & src_post = result.delta.get_mutable_post(src_state);
-            if (src_post.empty() || src_post.back().symbol != symbol) {
-                src_post.push_back(Move(symbol));
-            }
-            src_post.back().push_back(tgt_state);
-        }
-    }
-
-    // adding e-transitions
-    for (size_t i{ 0 }; i < e_sources.size(); ++i) {
-        State tgt_state =e_sources[i];
-        State src_state =e_targets[i];
-        Post & src_post = result.delta.get_mutable_post(src_state);
-        if (src_post.empty() || src_post.back().symbol != EPSILON) {
-            src_post.push_back(Move(EPSILON));
-        }
-        src_post.back().push_back(tgt_state);
-    }
-
-    //sorting the targets
-    //Hm I don't know why I put this here, but it should not be needed ...
-    //for (State q = 0, states_num = result.delta.post_size(); q<states_num;++q) {
-    //    for (auto m = result.delta.get_mutable_post(q).begin(); m != result.delta.get_mutable_post(q).end(); ++m) {
-    //        sort_and_rmdupl(m->targets);
-    //    }
-    //}
-
+Nfa Mata::Nfa::remove_epsilon(const Nfa& aut, Symbol epsilon) {
+    Nfa result{ Delta{}, aut.initial, aut.final, aut.alphabet };
+    std::vector<State> new_final_states{};
+    remove_epsilon_transitions(aut, epsilon, result.delta, new_final_states);
+    for (const State state: new_final_states) { result.final.insert(state); }
     return result;
 }
 
-Nfa Mata::Nfa::simple_revert(const Nfa& aut) {
-    Nfa result;
-    result.clear();
-
-    const size_t num_of_states{ aut.size() };
-    result.delta.increase_size(num_of_states);
-
-    for (State sourceState{ 0 }; sourceState < num_of_states; ++sourceState) {
-        for (const Move &transition: aut.delta[sourceState]) {
-            for (const State targetState: transition.targets) {
-                result.delta.add(targetState, transition.symbol, sourceState);
-            }
-        }
-    }
-
-    result.initial = aut.final;
-    result.final = aut.initial;
-
-    return result;
+void Nfa::remove_epsilon(const Symbol epsilon) {
+    // The new transitions are computed from the current ones, so only the delta is replaced, the rest of the
+    //  automaton is kept.
+    Delta result_delta{};
+    std::vector<State> new_final_states{};
+    remove_epsilon_transitions(*this, epsilon, result_delta, new_final_states);
+    delta = std::move(result_delta);
+    for (const State state: new_final_states) { final.insert(state); }
 }
 
-//not so great, can be removed
-Nfa Mata::Nfa::somewhat_simple_revert(const Nfa& aut) {
-    const size_t num_of_states{ aut.size() };
-
-    Nfa result(num_of_states);
-
+Nfa Mata::Nfa::revert(const Nfa& aut) {
+    // The transitions incoming to each state, ordered by symbols and sources, are exactly its moves in the result.
+    const ReverseDelta reverse{ aut.delta };
+    Nfa result;
+    result.delta.increase_size(aut.size());
+    for (State state{ 0 }; state < reverse.num_of_states(); ++state) {
+        if (reverse.pre(state).empty()) { continue; }
+        reverse.get_reverted_post(state, result.delta.get_mutable_post(state));
+    }
     result.initial = aut.final;
     result.final = aut.initial;
-
-    for (State sourceState{ 0 }; sourceState < num_of_states; ++sourceState) {
-        for (const Move &transition: aut.delta[sourceState]) {
-            for (const State targetState: transition.targets) {
-                Post & post = result.delta.get_mutable_post(targetState);
-                //auto move = std::find(post.begin(),post.end(),Move(transition.symbol));
-                auto move = post.find(Move(transition.symbol));
-                if (move == post.end()) {
-                    //post.push_back(Move(transition.symbol,sourceState));
-                    post.insert(Move(transition.symbol,sourceState));
-                }
-                else
-                    move->push_back(sourceState);
-                    //move->insert(sourceState);
-            }
-        }
-    }
-
-    //sorting the targets
-    for (State q = 0, states_num = result.delta.num_of_states(); q < states_num; ++q) {
-        //Post & post = result.delta.get_mutable_post(q);
-        //Util::sort_and_rmdupl(post);
-        for (auto m = result.delta.get_mutable_post(q).begin(); m != result.delta.get_mutable_post(q).end(); ++m) {
-            sort_and_rmdupl(m->targets);
-        }
-    }
-
     return result;
 }
 
-Nfa Mata::Nfa::revert(const Nfa& aut) {
-    return simple_revert(aut);
-    //return fragile_revert(aut);
-    //return somewhat_simple_revert(aut);
-}
-
 bool Mata::Nfa::is_deterministic(const Nfa& aut)
 {
     if (aut.initial.size() != 1) { return false; }
@@ -467,7 +370,7 @@ bool Mata::Nfa::is_deterministic(const Nfa& aut)
     if (aut.delta.empty()) { return true; }
 
     const size_t aut_size = aut.size();
-    for (size_t i = 0; i < aut_size; ++i)
+    for (State i = 0; i < aut_size; ++i)
     {
         for (const auto& symStates : aut.delta[i])
         {
@@ -684,11 +587,16 @@ Nfa Mata::Nfa::minimize(
 
 	const std::string& str_algo = params.at("algorithm");
 	if ("brzozowski" == str_algo) {  /* default */ }
-	else {
+	else if ("hopcroft" == str_algo) {
+		algo = Algorithms::minimize_hopcroft;
+	} else {
 		throw std::runtime_error(std::to_string(__func__) +
 			" received an unknown value of the \"algo\" key: " + str_algo);
 	}
 
+	// Deterministic automata are minimized by partition refinement directly, without any subset construction.
+	if (is_deterministic(aut)) { algo = Algorithms::minimize_hopcroft; }
+
 	return algo(aut);
 }
 
@@ -709,19 +617,17 @@ Nfa Mata::Nfa::uni(const Nfa &lhs, const Nfa &rhs) {
         unionAutomaton.final.insert(thisStateToUnionState[thisFinalState]);
     }
 
+    unionAutomaton.delta.start_bulk();
     for (State thisState = 0; thisState < size; ++thisState) {
         State unionState = thisStateToUnionState[thisState];
         for (const Move &transitionFromThisState : lhs.delta[thisState]) {
-
-            Move transitionFromUnionState(transitionFromThisState.symbol, StateSet{});
-
             for (State stateTo : transitionFromThisState.targets) {
-                transitionFromUnionState.insert(thisStateToUnionState[stateTo]);
+                unionAutomaton.delta.add_unsorted(unionState, transitionFromThisState.symbol,
+                                                  thisStateToUnionState[stateTo]);
             }
-
-            unionAutomaton.delta.get_mutable_post(unionState).insert(transitionFromUnionState);
         }
     }
+    unionAutomaton.delta.finalize();
 
     return unionAutomaton;
 }
@@ -749,6 +655,21 @@ Simlib::Util::BinaryRelation Mata::Nfa::Algorithms::compute_relation(const Nfa&
     }
 }
 
+Mata::Nfa::Algorithms::SimulatedStates Mata::Nfa::Algorithms::get_simulated_states(const Nfa& aut) {
+    const size_t num_of_states{ aut.size() };
+    SimulatedStates simulated_states(num_of_states);
+    if (num_of_states == 0) { return simulated_states; }
+
+    const Simlib::Util::BinaryRelation simulation{ compute_relation(aut) };
+    // Iterating over the simulated states in the increasing order keeps each vector sorted.
+    for (State q{ 0 }; q < num_of_states; ++q) {
+        for (State r{ 0 }; r < num_of_states; ++r) {
+            if (q == r || simulation.get(q, r)) { simulated_states[r].push_back(q); }
+        }
+    }
+    return simulated_states;
+}
+
 Nfa Mata::Nfa::reduce(const Nfa &aut, bool trim_input, StateToStateMap *state_map, const StringMap& params) {
     if (!haskey(params, "algorithm")) {
         throw std::runtime_error(std::to_string(__func__) +
@@ -786,6 +707,10 @@ Nfa Mata::Nfa::reduce(const Nfa &aut, bool trim_input, StateToStateMap *state_ma
         }
     }
 
+    const std::vector<State> renaming{ Algorithms::reorder(result, params) };
+    if (state_map != nullptr && !renaming.empty()) {
+        for (auto& [original_state, state]: *state_map) { state = renaming[state]; }
+    }
     return result;
 }
 
@@ -793,79 +718,123 @@ Nfa Mata::Nfa::determinize(
         const Nfa&  aut,
         std::unordered_map<StateSet, State> *subset_map)
 {
+    const size_t num_of_states{ aut.size() };
+    if (num_of_states <= BitMacrostateStore::MAX_STATES) {
+        const FrozenDelta frozen_delta{ aut.delta };
+        if (BitMacrostateStore::is_suitable_for(num_of_states, frozen_delta)) {
+            BitMacrostateStore bit_macrostates{ num_of_states };
+            Nfa result{ determinize_with_bit_macrostates(aut, frozen_delta, bit_macrostates) };
+            if (subset_map != nullptr) {
+                for (BitMacrostateStore::Id id{ 0 }; id < bit_macrostates.size(); ++id) {
+                    (*subset_map)[bit_macrostates.get_state_set(id)] = id;
+                }
+            }
+            return result;
+        }
+    }
 
+    MacrostateStore macrostates{};
+    Nfa result{ determinize(aut, macrostates) };
+    if (subset_map != nullptr) { macrostates.to_subset_map(*subset_map); }
+    return result;
+}
+
+Nfa Mata::Nfa::determinize(const Nfa& aut, const StringMap& params, std::unordered_map<StateSet, State> *subset_map) {
     Nfa result;
-    //assuming all sets targets are non-empty
-    std::vector<std::pair<State, StateSet>> worklist;
-    bool deallocate_subset_map = false;
-    if (subset_map == nullptr) {
-        subset_map = new std::unordered_map<StateSet,State>();
-        deallocate_subset_map = true;
+    if (!haskey(params, "threads")) {
+        result = determinize(aut, subset_map);
+    } else {
+        const std::string& str_threads = params.at("threads");
+        size_t num_of_threads;
+        try {
+            // std::stoul() skips whitespace and accepts signs, so that "-1" would wrap around to a huge number.
+            if (str_threads.empty() || !std::isdigit(static_cast<unsigned char>(str_threads.front()))) {
+                throw std::invalid_argument(str_threads);
+            }
+            size_t num_of_parsed_chars;
+            num_of_threads = std::stoul(str_threads, &num_of_parsed_chars);
+            if (num_of_parsed_chars != str_threads.size()) { throw std::invalid_argument(str_threads); }
+        } catch (const std::logic_error&) {
+            throw std::runtime_error(std::to_string(__func__) +
+                                     " received an invalid value of the \"threads\" key: " + str_threads);
+        }
+        result = Algorithms::determinize_parallel(aut, num_of_threads, subset_map);
+    }
+
+    const std::vector<State> renaming{ Algorithms::reorder(result, params) };
+    if (subset_map != nullptr && !renaming.empty()) {
+        for (auto& [macrostate, state]: *subset_map) { state = renaming[state]; }
     }
+    return result;
+}
 
-    result.clear();
+Nfa Mata::Nfa::determinize(const Nfa& aut, MacrostateStore& macrostates) {
+    Nfa result;
+    macrostates.clear();
+    // Ids of the macrostates are the states of the result. Macrostates to process, each with non-empty targets.
+    std::vector<MacrostateStore::Id> worklist;
 
-    const StateSet S0 =  StateSet(aut.initial);
-    const State S0id = result.add_state();
-    result.initial.insert(S0id);
+    const auto is_final_macrostate = [&aut](std::span<const State> macrostate) {
+        return std::any_of(macrostate.begin(), macrostate.end(), [&aut](const State q) { return aut.final[q]; });
+    };
 
-    if (aut.final.intersects_with(S0)) {
+    const MacrostateStore::Id S0id{ macrostates.insert(StateSet(aut.initial)).first };
+    result.add_state();
+    result.initial.insert(S0id);
+    if (is_final_macrostate(macrostates[S0id])) {
         result.final.insert(S0id);
     }
-    worklist.emplace_back(std::make_pair(S0id, S0));
-
-    (*subset_map)[Mata::Util::OrdVector<State>(S0)] = S0id;
+    worklist.push_back(S0id);
 
     if (aut.delta.empty())
         return result;
 
-    using Iterator = Mata::Util::OrdVector<Move>::const_iterator;
+    // The subset construction only reads the transitions, traverse their contiguous frozen copy.
+    const FrozenDelta frozen_delta{ aut.delta };
+    using Iterator = FrozenPost::const_iterator;
     Mata::Util::SynchronizedExistentialIterator<Iterator> synchronized_iterator;
+    // Targets of the moves over one symbol are merged into a reused buffer, nothing is allocated per symbol.
+    Mata::Util::KWayMerger<State> targets_merger{};
+    std::vector<State> targets_union{};
+    std::span<const Iterator> moves{};
 
     while (!worklist.empty()) {
-        const auto Spair = worklist.back();
+        const MacrostateStore::Id Sid{ worklist.back() };
         worklist.pop_back();
-        const StateSet S = Spair.second;
-        const State Sid = Spair.first;
-        if (S.empty()) {
+        if (macrostates[Sid].empty()) {
             // This should not happen assuming all sets targets are non-empty.
             break;
         }
 
-        // add moves of S to the sync ex iterator
-        // TODO: shouldn't we also reset first?
-        for (State q: S) {
-            Mata::Util::push_back(synchronized_iterator, aut.delta[q]);
+        // Add moves of S to the sync ex iterator. The view of S is not used after new macrostates are inserted.
+        synchronized_iterator.reset();
+        for (const State q: macrostates[Sid]) {
+            Mata::Util::push_back(synchronized_iterator, frozen_delta[q]);
         }
 
+        // Moves of Sid are found in the increasing order of symbols, so they can be appended to its post directly.
         while (synchronized_iterator.advance()) {
 
             // extract post from the sychronized_iterator iterator
-            std::vector<Iterator> moves = synchronized_iterator.get_current();
+            synchronized_iterator.get_current(moves);
             Symbol currentSymbol = (*moves.begin())->symbol;
-            StateSet T;
-            for (auto m: moves){
-                T = T.Union(m->targets);
+            for (const Iterator& m: moves) {
+                targets_merger.add(m->begin(), m->end());
             }
+            targets_merger.merge(targets_union);
 
-            const auto existingTitr = subset_map->find(T);
-            State Tid;
-            if (existingTitr != subset_map->end()) {
-                Tid = existingTitr->second;
-            } else {
-                Tid = result.add_state();
-                (*subset_map)[Mata::Util::OrdVector<State>(T)] = Tid;
-                if (aut.final.intersects_with(T)) {
+            const auto [Tid, is_new]{ macrostates.insert(targets_union.begin(), targets_union.end()) };
+            if (is_new) {
+                result.add_state();
+                if (is_final_macrostate(targets_union)) {
                     result.final.insert(Tid);
                 }
-                worklist.emplace_back(std::make_pair(Tid, T));
+                worklist.push_back(Tid);
             }
-            result.delta.get_mutable_post(Sid).insert(Move(currentSymbol, Tid));
+            result.delta.get_mutable_post(Sid).push_back(Move(currentSymbol, static_cast<State>(Tid)));
         }
     }
 
-    if (deallocate_subset_map) { delete subset_map; }
-
     return result;
 }
 
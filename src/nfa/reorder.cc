@@ -0,0 +1,215 @@
+/* reorder.cc -- Renumbering states of automata for locality of their transitions.
+ *
+ * This file is a part of libmata.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include <algorithm>
+
+#include "mata/nfa/nfa.hh"
+#include "mata/nfa/algorithms.hh"
+
+using namespace Mata::Nfa;
+using Mata::BoolVector;
+
+namespace {
+
+/// Sorted initial states of @p aut followed by all its states, the roots of the traversals of the automaton.
+std::vector<State> get_roots(const Nfa& aut) {
+    std::vector<State> roots{ aut.initial.begin(), aut.initial.end() };
+    std::sort(roots.begin(), roots.end());
+    const size_t num_of_states{ aut.size() };
+    roots.reserve(roots.size() + num_of_states);
+    for (State state{ 0 }; state < num_of_states; ++state) { roots.push_back(state); }
+    return roots;
+}
+
+/// States of @p aut in the breadth-first order from the initial states, then from the remaining states.
+std::vector<State> order_bfs(const Nfa& aut) {
+    BoolVector is_visited(aut.size(), false);
+    std::vector<State> order{};
+    order.reserve(aut.size());
+    // The order itself is the queue of the search.
+    for (const State root: get_roots(aut)) {
+        if (is_visited[root]) { continue; }
+        is_visited[root] = true;
+        order.push_back(root);
+        for (size_t next{ order.size() - 1 }; next < order.size(); ++next) {
+            for (const Move& move: aut.delta[order[next]]) {
+                for (const State target: move.targets) {
+                    if (!is_visited[target]) {
+                        is_visited[target] = true;
+                        order.push_back(target);
+                    }
+                }
+            }
+        }
+    }
+    return order;
+}
+
+/// Visited state on the stack of the depth-first search with the position of the iteration over its successors.
+struct StackLevel {
+    Post::const_iterator move_it;
+    Post::const_iterator move_end;
+    Move::Targets::const_iterator target_it{};
+    Move::Targets::const_iterator target_end{};
+
+    explicit StackLevel(const Post& post) : move_it{ post.cbegin() }, move_end{ post.cend() } {
+        if (move_it != move_end) {
+            target_it = move_it->targets.cbegin();
+            target_end = move_it->targets.cend();
+        }
+    }
+};
+
+/// States of @p aut in the depth-first preorder from the initial states, then from the remaining states.
+std::vector<State> order_dfs_preorder(const Nfa& aut) {
+    BoolVector is_visited(aut.size(), false);
+    std::vector<State> order{};
+    order.reserve(aut.size());
+    std::vector<StackLevel> stack{};
+    const auto visit = [&](const State state) {
+        is_visited[state] = true;
+        order.push_back(state);
+        stack.emplace_back(aut.delta[state]);
+    };
+
+    for (const State root: get_roots(aut)) {
+        if (is_visited[root]) { continue; }
+        visit(root);
+        while (!stack.empty()) {
+            StackLevel& level{ stack.back() };
+            while (level.target_it == level.target_end && level.move_it != level.move_end) {
+                ++level.move_it;
+                if (level.move_it != level.move_end) {
+                    level.target_it = level.move_it->targets.cbegin();
+                    level.target_end = level.move_it->targets.cend();
+                }
+            }
+            if (level.move_it == level.move_end) {
+                stack.pop_back();
+                continue;
+            }
+            const State target{ *level.target_it };
+            ++level.target_it;
+            if (!is_visited[target]) { visit(target); } // Invalidates the reference to the level.
+        }
+    }
+    return order;
+}
+
+/**
+ * States of @p aut in the reverse Cuthill-McKee order of its transition graph taken as undirected.
+ *
+ * Each connected component is searched breadth-first from its state of the minimal degree, neighbours of each state
+ *  are visited in the increasing order of their degrees. Reversing the resulting order keeps the endpoints of each
+ *  transition close to each other.
+ */
+std::vector<State> order_reverse_cuthill_mckee(const Nfa& aut) {
+    const size_t num_of_states{ aut.size() };
+    std::vector<size_t> degrees(num_of_states, 0);
+    for (State state{ 0 }; state < aut.delta.num_of_states(); ++state) {
+        for (const Move& move: aut.delta[state]) {
+            degrees[state] += move.size();
+            for (const State target: move.targets) { ++degrees[target]; }
+        }
+    }
+    const auto is_lower_degree = [&degrees](const State lhs, const State rhs) {
+        return degrees[lhs] < degrees[rhs] || (degrees[lhs] == degrees[rhs] && lhs < rhs);
+    };
+    std::vector<State> roots(num_of_states);
+    for (State state{ 0 }; state < num_of_states; ++state) { roots[state] = state; }
+    std::sort(roots.begin(), roots.end(), is_lower_degree);
+    const ReverseDelta reverse{ aut.delta };
+
+    BoolVector is_visited(num_of_states, false);
+    std::vector<State> order{};
+    order.reserve(num_of_states);
+    std::vector<State> neighbours{};
+    for (const State root: roots) {
+        if (is_visited[root]) { continue; }
+        is_visited[root] = true;
+        order.push_back(root);
+        for (size_t next{ order.size() - 1 }; next < order.size(); ++next) {
+            const State state{ order[next] };
+            neighbours.clear();
+            for (const Move& move: aut.delta[state]) {
+                for (const State target: move.targets) {
+                    if (!is_visited[target]) { neighbours.push_back(target); }
+                }
+            }
+            for (const ReverseDelta::InTransition& in_transition: reverse.pre(state)) {
+                if (!is_visited[in_transition.source]) { neighbours.push_back(in_transition.source); }
+            }
+            std::sort(neighbours.begin(), neighbours.end(), is_lower_degree);
+            neighbours.erase(std::unique(neighbours.begin(), neighbours.end()), neighbours.end());
+            for (const State neighbour: neighbours) {
+                is_visited[neighbour] = true;
+                order.push_back(neighbour);
+            }
+        }
+    }
+    std::reverse(order.begin(), order.end());
+    return order;
+}
+
+} // Anonymous namespace.
+
+std::vector<State> Nfa::reorder(const ReorderStrategy strategy) {
+    std::vector<State> order{};
+    switch (strategy) {
+        case ReorderStrategy::BFS: order = order_bfs(*this); break;
+        case ReorderStrategy::DFS_PREORDER: order = order_dfs_preorder(*this); break;
+        case ReorderStrategy::REVERSE_CUTHILL_MCKEE: order = order_reverse_cuthill_mckee(*this); break;
+    }
+
+    const size_t num_of_states{ size() };
+    std::vector<State> renaming(num_of_states);
+    for (State state{ 0 }; state < num_of_states; ++state) { renaming[order[state]] = state; }
+
+    // Posts are moved to their new states, only their targets are renamed.
+    Delta reordered_delta(num_of_states);
+    std::vector<State> targets{};
+    for (State state{ 0 }; state < delta.num_of_states(); ++state) {
+        Post& post{ reordered_delta.get_mutable_post(renaming[state]) };
+        post = std::move(delta.get_mutable_post(state));
+        for (Move& move: post) {
+            targets.clear();
+            for (const State target: move.targets) { targets.push_back(renaming[target]); }
+            move.targets = StateSet(targets);
+        }
+    }
+    delta = std::move(reordered_delta);
+
+    for (Util::SparseSet<State>* states: { &initial, &final }) {
+        targets.assign(states->begin(), states->end());
+        states->clear();
+        for (const State state: targets) { states->insert(renaming[state]); }
+    }
+    return renaming;
+}
+
+std::vector<State> Mata::Nfa::Algorithms::reorder(Nfa& aut, const StringMap& params) {
+    if (!Util::haskey(params, "reorder")) { return {}; }
+
+    const std::string& strategy = params.at("reorder");
+    if ("bfs" == strategy) {
+        return aut.reorder(ReorderStrategy::BFS);
+    } else if ("dfs" == strategy) {
+        return aut.reorder(ReorderStrategy::DFS_PREORDER);
+    } else if ("rcm" == strategy) {
+        return aut.reorder(ReorderStrategy::REVERSE_CUTHILL_MCKEE);
+    }
+    throw std::runtime_error(std::to_string(__func__) +
+                             " received an unknown value of the \"reorder\" key: " + strategy);
+}
@@ -0,0 +1,145 @@
+/* scc.cc -- Strongly connected components of automata.
+ *
+ * This file is a part of libmata.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include <algorithm>
+#include <limits>
+
+#include "mata/nfa/scc.hh"
+
+using namespace Mata::Nfa;
+using Mata::Symbol;
+
+namespace {
+
+/// Visited state on the DFS stack of Tarjan's algorithm with the position of the iteration over its successors.
+struct StackLevel {
+    State state;
+    Post::const_iterator move_it;
+    Post::const_iterator move_end;
+    Move::Targets::const_iterator target_it{};
+    Move::Targets::const_iterator target_end{};
+
+    StackLevel(const State state, const Post& post) : state{ state }, move_it{ post.cbegin() }, move_end{ post.cend() } {}
+};
+
+} // Anonymous namespace.
+
+template<class IsFollowed>
+SccDecomposition SccDecomposition::compute(const Nfa& aut, const IsFollowed& is_followed) {
+    constexpr size_t UNVISITED{ std::numeric_limits<size_t>::max() };
+    const size_t num_of_states{ aut.size() };
+    std::vector<size_t> index(num_of_states, UNVISITED); // Order of the first visit of each state.
+    std::vector<size_t> low_link(num_of_states, 0);
+    std::vector<bool> is_on_tarjan_stack(num_of_states, false);
+    std::vector<State> tarjan_stack{}; // Visited states whose components have not been completed yet.
+    std::vector<StackLevel> dfs_stack{};
+    size_t next_index{ 0 };
+
+    // Components are completed in a reverse topological order, they are renumbered when all of them are known.
+    SccDecomposition sccs{};
+    sccs.component_of_.assign(num_of_states, 0);
+    std::vector<bool> is_on_cycle_reversed{};
+
+    const auto visit = [&](const State state) {
+        index[state] = low_link[state] = next_index++;
+        tarjan_stack.push_back(state);
+        is_on_tarjan_stack[state] = true;
+        dfs_stack.emplace_back(state, aut.delta[state]);
+    };
+
+    for (State root{ 0 }; root < num_of_states; ++root) {
+        if (index[root] != UNVISITED) { continue; }
+        visit(root);
+        while (!dfs_stack.empty()) {
+            StackLevel& level{ dfs_stack.back() };
+            // Find the next followed successor of the state on the top of the DFS stack.
+            while (level.target_it == level.target_end && level.move_it != level.move_end) {
+                if (is_followed(level.move_it->symbol)) {
+                    level.target_it = level.move_it->targets.cbegin();
+                    level.target_end = level.move_it->targets.cend();
+                }
+                ++level.move_it;
+            }
+
+            if (level.target_it != level.target_end) {
+                const State successor{ *level.target_it };
+                ++level.target_it;
+                if (index[successor] == UNVISITED) {
+                    visit(successor); // Invalidates the reference to the level.
+                } else if (is_on_tarjan_stack[successor]) {
+                    low_link[level.state] = std::min(low_link[level.state], index[successor]);
+                }
+                continue;
+            }
+
+            // All successors of the state have been visited.
+            const State state{ level.state };
+            dfs_stack.pop_back();
+            if (!dfs_stack.empty()) {
+                const State parent{ dfs_stack.back().state };
+                low_link[parent] = std::min(low_link[parent], low_link[state]);
+            }
+            if (low_link[state] == index[state]) {
+                const size_t component{ sccs.offsets.size() - 1 };
+                const size_t first{ sccs.states.size() };
+                State member;
+                do {
+                    member = tarjan_stack.back();
+                    tarjan_stack.pop_back();
+                    is_on_tarjan_stack[member] = false;
+                    sccs.component_of_[member] = component;
+                    sccs.states.push_back(member);
+                } while (member != state);
+                sccs.offsets.push_back(sccs.states.size());
+
+                bool is_on_cycle{ sccs.states.size() - first > 1 };
+                if (!is_on_cycle) {
+                    for (const Move& move: aut.delta[state]) {
+                        if (is_followed(move.symbol) && move.targets.count(state) > 0) {
+                            is_on_cycle = true;
+                            break;
+                        }
+                    }
+                }
+                is_on_cycle_reversed.push_back(is_on_cycle);
+            }
+        }
+    }
+
+    // Reverse the order of the components to get a topological order.
+    const size_t num_of_components{ sccs.offsets.size() - 1 };
+    for (size_t& component: sccs.component_of_) { component = num_of_components - 1 - component; }
+    std::vector<State> states{};
+    states.reserve(sccs.states.size());
+    std::vector<size_t> offsets{ 0 };
+    offsets.reserve(sccs.offsets.size());
+    for (size_t component{ num_of_components }; component > 0; --component) {
+        states.insert(states.end(), sccs.states.begin() + static_cast<long>(sccs.offsets[component - 1]),
+                      sccs.states.begin() + static_cast<long>(sccs.offsets[component]));
+        offsets.push_back(states.size());
+    }
+    sccs.states = std::move(states);
+    sccs.offsets = std::move(offsets);
+    sccs.is_on_cycle_.assign(is_on_cycle_reversed.rbegin(), is_on_cycle_reversed.rend());
+    return sccs;
+}
+
+SccDecomposition Mata::Nfa::compute_sccs(const Nfa& aut) {
+    return SccDecomposition::compute(aut, [](Symbol) { return true; });
+}
+
+SccDecomposition Mata::Nfa::compute_sccs(const Nfa& aut, const Symbol symbol) {
+    return SccDecomposition::compute(aut, [symbol](const Symbol move_symbol) { return move_symbol == symbol; });
+}
@@ -0,0 +1,139 @@
+/* symbol-classes.cc -- Classes of symbols with the same transitions in automata.
+ *
+ * This file is a part of libmata.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include <algorithm>
+
+#include "mata/nfa/symbol-classes.hh"
+
+using namespace Mata::Nfa;
+using Mata::Symbol;
+using Mata::Util::OrdVector;
+
+namespace {
+
+/// Sort @p moves by their symbols and move them to @p post, keeping only the first move over each symbol.
+void fill_post(std::vector<Move>& moves, Post& post) {
+    std::stable_sort(moves.begin(), moves.end(),
+                     [](const Move& lhs, const Move& rhs) { return lhs.symbol < rhs.symbol; });
+    post.reserve(moves.size());
+    for (Move& move: moves) {
+        if (post.empty() || post.back().symbol != move.symbol) { post.push_back(std::move(move)); }
+    }
+}
+
+} // Anonymous namespace.
+
+SymbolClasses SymbolClasses::compute(const Nfa& aut, const OrdVector<Symbol>* symbols) {
+    std::vector<Symbol> all_symbols{};
+    if (symbols != nullptr) { all_symbols = symbols->ToVector(); }
+    for (State state{ 0 }; state < aut.delta.num_of_states(); ++state) {
+        for (const Move& move: aut.delta[state]) { all_symbols.push_back(move.symbol); }
+    }
+    std::sort(all_symbols.begin(), all_symbols.end());
+    all_symbols.erase(std::unique(all_symbols.begin(), all_symbols.end()), all_symbols.end());
+    if (!all_symbols.empty() && all_symbols.back() == EPSILON) { all_symbols.pop_back(); }
+
+    const size_t num_of_symbols{ all_symbols.size() };
+    std::unordered_map<Symbol, size_t> index_of{};
+    index_of.reserve(num_of_symbols);
+    for (size_t index{ 0 }; index < num_of_symbols; ++index) { index_of[all_symbols[index]] = index; }
+
+    // Refine the partition by the targets of the symbols from each state: symbols of a class over which a state has
+    //  the same targets get the same new class, symbols of the class over which the state has no transitions stay.
+    std::vector<size_t> class_of(num_of_symbols, 0);
+    size_t num_of_classes{ 1 };
+    if (symbols != nullptr) {
+        for (size_t index{ 0 }; index < num_of_symbols; ++index) {
+            if (!symbols->count(all_symbols[index])) {
+                class_of[index] = 1;
+                num_of_classes = 2;
+            }
+        }
+    }
+    std::unordered_map<StateSet, size_t> target_ids{};
+    std::unordered_map<std::pair<size_t, size_t>, size_t> split_classes{};
+    for (State state{ 0 }; state < aut.delta.num_of_states(); ++state) {
+        split_classes.clear();
+        for (const Move& move: aut.delta[state]) {
+            if (move.symbol == EPSILON) { continue; }
+            const size_t target_id{ target_ids.emplace(move.targets, target_ids.size()).first->second };
+            size_t& symbol_class{ class_of[index_of.at(move.symbol)] };
+            const auto [split_class, is_new]{ split_classes.emplace(std::make_pair(symbol_class, target_id),
+                                                                    num_of_classes) };
+            if (is_new) { ++num_of_classes; }
+            symbol_class = split_class->second;
+        }
+    }
+
+    // Renumber the classes in the order of their smallest symbols.
+    SymbolClasses result{};
+    std::unordered_map<size_t, Symbol> renaming{};
+    result.class_of_.reserve(num_of_symbols);
+    for (size_t index{ 0 }; index < num_of_symbols; ++index) {
+        const auto [renamed, is_new]{ renaming.emplace(class_of[index], static_cast<Symbol>(result.members.size())) };
+        if (is_new) { result.members.emplace_back(); }
+        result.class_of_[all_symbols[index]] = renamed->second;
+        result.members[renamed->second].push_back(all_symbols[index]); // Symbols are visited in the increasing order.
+    }
+    return result;
+}
+
+OrdVector<Symbol> SymbolClasses::get_classes_of(const OrdVector<Symbol>& symbols) const {
+    std::vector<Symbol> classes{};
+    for (const Symbol symbol: symbols) {
+        const auto symbol_class{ class_of_.find(symbol) };
+        if (symbol_class != class_of_.end()) { classes.push_back(symbol_class->second); }
+    }
+    return OrdVector<Symbol>(classes);
+}
+
+SymbolClasses Mata::Nfa::compute_symbol_classes(const Nfa& aut) {
+    return SymbolClasses::compute(aut, nullptr);
+}
+
+SymbolClasses Mata::Nfa::compute_symbol_classes(const Nfa& aut, const OrdVector<Symbol>& symbols) {
+    return SymbolClasses::compute(aut, &symbols);
+}
+
+Nfa Mata::Nfa::to_symbol_classes(const Nfa& aut, const SymbolClasses& classes) {
+    Nfa result{ Delta(aut.delta.num_of_states()), aut.initial, aut.final };
+    std::vector<Move> moves{};
+    for (State state{ 0 }; state < aut.delta.num_of_states(); ++state) {
+        moves.clear();
+        for (const Move& move: aut.delta[state]) {
+            moves.emplace_back(move.symbol == EPSILON ? EPSILON : classes.class_of(move.symbol), move.targets);
+        }
+        // All symbols of a class have the same targets, the first move over each class is kept.
+        fill_post(moves, result.delta.get_mutable_post(state));
+    }
+    return result;
+}
+
+Nfa Mata::Nfa::from_symbol_classes(const Nfa& aut, const SymbolClasses& classes) {
+    Nfa result{ Delta(aut.delta.num_of_states()), aut.initial, aut.final, aut.alphabet };
+    std::vector<Move> moves{};
+    for (State state{ 0 }; state < aut.delta.num_of_states(); ++state) {
+        moves.clear();
+        for (const Move& move: aut.delta[state]) {
+            if (move.symbol == EPSILON) {
+                moves.push_back(move);
+                continue;
+            }
+            for (const Symbol symbol: classes[move.symbol]) { moves.emplace_back(symbol, move.targets); }
+        }
+        fill_post(moves, result.delta.get_mutable_post(state));
+    }
+    return result;
+}
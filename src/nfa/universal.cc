@@ -18,14 +18,150 @@
 // MATA headers
 #include "mata/nfa/nfa.hh"
 #include "mata/nfa/algorithms.hh"
+#include "mata/nfa/symbol-classes.hh"
 #include "mata/utils/sparse-set.hh"
+#include "mata/utils/antichain.hh"
+#include "mata/utils/k-way-merge.hh"
 
 using namespace Mata::Nfa;
 using namespace Mata::Util;
+using Mata::Symbol;
 
 //TODO: this could be merged with inclusion, or even removed, universality could be implemented using inclusion,
 // it is not something needed in practice, so some little overhead is ok
 
+namespace {
+
+using Mata::Nfa::Algorithms::SimulatedStates;
+
+/// One symbol of each class of the symbols of @p alphabet with the same transitions in @p aut. Universality is
+///  checked over these symbols only, since any symbol of a class has the same successors as its representative.
+Mata::Util::OrdVector<Symbol> get_class_representatives(const Nfa& aut, const Mata::Alphabet& alphabet) {
+	const Mata::Util::OrdVector<Symbol> symbols{ alphabet.get_alphabet_symbols() };
+	const SymbolClasses classes{ compute_symbol_classes(aut, symbols) };
+	std::vector<Symbol> representatives{};
+	for (const Symbol symbol_class : classes.get_classes_of(symbols)) {
+		representatives.push_back(classes.get_representative(symbol_class));
+	}
+	return Mata::Util::OrdVector<Symbol>(representatives);
+}
+
+/// universality check using Antichains with macrostates represented as bit sets
+bool is_universal_antichains_with_bit_macrostates(
+	const Nfa&              aut,
+	const Mata::Alphabet&   alphabet,
+	const FrozenDelta&      frozen_delta,
+	Run*                    cex,
+	const SimulatedStates*  simulated_states)
+{ // {{{
+	namespace BitWords = Mata::Util::BitWords;
+	using Id = BitMacrostateStore::Id;
+
+	BitMacrostateStore macrostates{ aut.size() };
+	const size_t num_of_words{ macrostates.num_of_words() };
+	const std::vector<uint64_t> move_targets{ macrostates.get_move_targets(frozen_delta) };
+
+	std::vector<uint64_t> final_states(num_of_words, 0);
+	for (const State q : aut.final) { BitWords::set(final_states.data(), q); }
+	std::vector<uint64_t> succ_words(num_of_words, 0);
+	for (const State q : aut.initial) { BitWords::set(succ_words.data(), q); }
+
+	// States simulated by each state, as bit sets.
+	std::vector<uint64_t> simulated_words{};
+	std::vector<uint64_t> closed_words{};
+	if (simulated_states != nullptr) {
+		simulated_words.resize(simulated_states->size() * num_of_words, 0);
+		for (State r = 0; r < simulated_states->size(); ++r) {
+			for (const State q : (*simulated_states)[r]) { BitWords::set(simulated_words.data() + r * num_of_words, q); }
+		}
+	}
+	// Close the macrostate in succ_words downward under simulation.
+	auto close_succ_words = [&]() {
+		if (simulated_states == nullptr) { return; }
+		closed_words.assign(num_of_words, 0);
+		BitWords::for_each(succ_words.data(), num_of_words, [&](const size_t r) {
+			BitWords::unite(closed_words.data(), simulated_words.data() + r * num_of_words, num_of_words);
+		});
+		std::swap(succ_words, closed_words);
+	};
+	close_succ_words();
+
+	// Processed macrostates as in is_universal_antichains_impl(), with subsumption checked on the bit sets.
+	using ProcessedType = Antichain<uint64_t, Id, BitSetTraits>;
+	auto get_words = [&macrostates, num_of_words](const Id id) {
+		return std::span<const uint64_t>{ macrostates[id], num_of_words };
+	};
+
+	const Id initial_id{ macrostates.insert(succ_words.data()).first };
+	ProcessedType processed{};
+	std::vector<ProcessedType::Handle> worklist = { processed.insert(0, get_words(initial_id), initial_id) };
+	const Mata::Util::OrdVector<Symbol> alph_symbols{ get_class_representatives(aut, alphabet) };
+
+	// 'paths[s] == t' denotes that macrostate 's' was accessed from macrostate 't',
+	// 'paths[s] == s' means that 's' is the initial macrostate
+	std::vector<std::pair<Id, Symbol>> paths = { {initial_id, 0} };
+	std::vector<State> states{};
+
+	while (!worklist.empty()) {
+		const ProcessedType::Handle handle{ worklist.back() };
+		worklist.pop_back();
+		// Skip macrostates subsumed by macrostates processed later.
+		if (!processed.is_alive(handle)) { continue; }
+		const Id state{ processed.get_value(handle) };
+
+		states.clear();
+		BitWords::for_each(macrostates[state], num_of_words, [&states](const size_t q) {
+			states.push_back(static_cast<State>(q));
+		});
+
+		for (const Symbol symb : alph_symbols) {
+			std::fill(succ_words.begin(), succ_words.end(), 0);
+			for (const State q : states) {
+				const FrozenPost post{ frozen_delta[q] };
+				const auto move{ post.find(symb) };
+				if (move != post.end()) {
+					BitWords::unite(succ_words.data(), move_targets.data() + frozen_delta.index_of(move) * num_of_words,
+					                num_of_words);
+				}
+			}
+			close_succ_words();
+
+			if (!BitWords::intersects(succ_words.data(), final_states.data(), num_of_words)) {
+				if (nullptr != cex) {
+					cex->word.clear();
+					cex->word.push_back(symb);
+					Id trav = state;
+					while (paths[trav].first != trav)
+					{ // go back until initial state
+						cex->word.push_back(paths[trav].second);
+						trav = paths[trav].first;
+					}
+
+					std::reverse(cex->word.begin(), cex->word.end());
+				}
+
+				return false;
+			}
+
+			const auto [succ, is_new] = macrostates.insert(succ_words.data());
+			// Every macrostate explored before is subsumed by some macrostate in processed.
+			if (!is_new) { continue; }
+			paths.emplace_back(state, symb);
+
+			const std::span<const uint64_t> succ_set{ get_words(succ) };
+			if (processed.contains_subset_of(0, succ_set)) { continue; }
+
+			// prune processed (and thus the worklist) and insert succ inside
+			processed.remove_supersets_of(0, succ_set);
+			worklist.push_back(processed.insert(0, succ_set, succ));
+		}
+	}
+
+	return true;
+} // }}}
+
+} // Anonymous namespace.
+
 
 /// naive universality check (complementation + emptiness)
 bool Mata::Nfa::Algorithms::is_universal_naive(
@@ -39,63 +175,92 @@ bool Mata::Nfa::Algorithms::is_universal_naive(
 } // is_universal_naive }}}
 
 
-/// universality check using Antichains
-bool Mata::Nfa::Algorithms::is_universal_antichains(
-	const Nfa&         aut,
-	const Alphabet&    alphabet,
-	Run*               cex)
-{ // {{{
+namespace {
 
-	using WorklistType = std::list<StateSet>;
-	using ProcessedType = std::list<StateSet>;
+/// universality check using Antichains. With @p simulated_states of aut (see Algorithms::get_simulated_states()),
+///  macrostates are closed downward under simulation, so that the subsumption by set inclusion of the closed
+///  macrostates is the subsumption by simulation of the original ones.
+bool is_universal_antichains_impl(
+	const Nfa&              aut,
+	const Mata::Alphabet&   alphabet,
+	Run*                    cex,
+	const SimulatedStates*  simulated_states)
+{ // {{{
+	// check the initial state
+	if (are_disjoint(aut.initial, aut.final)) {
+		if (nullptr != cex) { cex->word.clear(); }
+		return false;
+	}
 
-	auto subsumes = [](const StateSet& lhs, const StateSet& rhs) {
-		if (lhs.size() > rhs.size()) { // bigger set cannot be subset
-			return false;
+	const size_t num_of_states{ aut.size() };
+	if (num_of_states <= BitMacrostateStore::MAX_STATES) {
+		const FrozenDelta frozen_delta{ aut.delta };
+		if (BitMacrostateStore::is_suitable_for(num_of_states, frozen_delta)) {
+			return is_universal_antichains_with_bit_macrostates(aut, alphabet, frozen_delta, cex, simulated_states);
 		}
+	}
 
-		return std::includes(rhs.begin(), rhs.end(), lhs.begin(), lhs.end());
-	};
+	using Id = MacrostateStore::Id;
+	// Processed macrostates, all in a single bucket. The worklist is always a subset of processed, it refers to
+	//  processed macrostates by handles, and handles of macrostates removed from processed are skipped.
+	using ProcessedType = Antichain<State, Id>;
+	using WorklistType = std::deque<ProcessedType::Handle>;
+
+	// All explored macrostates, each stored once; the worklists and paths refer to them by ids.
+	MacrostateStore macrostates{};
 
 	// process parameters
 	// TODO: set correctly!!!!
 	bool is_dfs = true;
 
-	// check the initial state
-	if (are_disjoint(aut.initial, aut.final)) {
-		if (nullptr != cex) { cex->word.clear(); }
-		return false;
-	}
+	// Close the macrostate in succ_states downward under simulation.
+	std::vector<State> succ_states{};
+	Mata::Util::KWayMerger<State> succ_states_merger{};
+	auto close_succ_states = [&]() {
+		if (simulated_states == nullptr) { return; }
+		for (const State q : succ_states) {
+			succ_states_merger.add((*simulated_states)[q].data(),
+			                       (*simulated_states)[q].data() + (*simulated_states)[q].size());
+		}
+		succ_states_merger.merge(succ_states);
+	};
 
 	// initialize
-	WorklistType worklist = { StateSet(aut.initial) };
-	ProcessedType processed = { StateSet(aut.initial) };
-	Mata::Util::OrdVector<Symbol> alph_symbols = alphabet.get_alphabet_symbols();
+	succ_states = StateSet(aut.initial).ToVector();
+	close_succ_states();
+	const Id initial_id{ macrostates.insert(succ_states).first };
+	ProcessedType processed{};
+	WorklistType worklist = { processed.insert(0, macrostates[initial_id], initial_id) };
+	const Mata::Util::OrdVector<Symbol> alph_symbols{ get_class_representatives(aut, alphabet) };
 
-	// 'paths[s] == t' denotes that state 's' was accessed from state 't',
-	// 'paths[s] == s' means that 's' is an initial state
-	std::map<StateSet, std::pair<StateSet, Symbol>> paths =
-		{ {StateSet(aut.initial), {StateSet(aut.initial), 0}} };
+	// 'paths[s] == t' denotes that macrostate 's' was accessed from macrostate 't',
+	// 'paths[s] == s' means that 's' is the initial macrostate
+	std::vector<std::pair<Id, Symbol>> paths = { {initial_id, 0} };
 
 	while (!worklist.empty()) {
 		// get a next state
-		StateSet state;
+		ProcessedType::Handle handle;
 		if (is_dfs) {
-			state = *worklist.rbegin();
+			handle = *worklist.rbegin();
 			worklist.pop_back();
 		} else { // BFS
-			state = *worklist.begin();
+			handle = *worklist.begin();
 			worklist.pop_front();
 		}
+		// Skip macrostates subsumed by macrostates processed later.
+		if (!processed.is_alive(handle)) { continue; }
+		const Id state{ processed.get_value(handle) };
 
 		// process it
+		const StateSet state_set{ macrostates.get_state_set(state) };
 		for (Symbol symb : alph_symbols) {
-			StateSet succ = aut.post(state, symb);
-			if (!aut.final.intersects_with(succ)) {
+			succ_states = aut.post(state_set, symb).ToVector();
+			close_succ_states();
+			if (!std::any_of(succ_states.begin(), succ_states.end(), [&aut](const State q) { return aut.final[q]; })) {
 				if (nullptr != cex) {
 					cex->word.clear();
 					cex->word.push_back(symb);
-					StateSet trav = state;
+					Id trav = state;
 					while (paths[trav].first != trav)
 					{ // go back until initial state
 						cex->word.push_back(paths[trav].second);
@@ -108,42 +273,56 @@ bool Mata::Nfa::Algorithms::is_universal_antichains(
 				return false;
 			}
 
-			bool is_subsumed = false;
-			for (const auto& anti_state : processed) {
-				// trying to find a smaller state in processed
-				if (subsumes(anti_state, succ)) {
-					is_subsumed = true;
-					break;
-				}
-			}
-
-			if (is_subsumed) { continue; }
-
-			// prune data structures and insert succ inside
-			for (std::list<StateSet>* ds : {&processed, &worklist}) {
-				auto it = ds->begin();
-				while (it != ds->end()) {
-					if (subsumes(succ, *it)) {
-						auto to_remove = it;
-						++it;
-						ds->erase(to_remove);
-					} else {
-						++it;
-					}
-				}
+			const auto [succ, is_new] = macrostates.insert(succ_states);
+			// Every macrostate explored before is subsumed by some macrostate in processed.
+			if (!is_new) { continue; }
+			paths.emplace_back(state, symb);
 
-				// TODO: set pushing strategy
-				ds->push_back(succ);
-			}
+			// trying to find a smaller state in processed
+			const std::span<const State> stored_succ{ macrostates[succ] };
+			if (processed.contains_subset_of(0, stored_succ)) { continue; }
 
-			// also set that succ was accessed from state
-			paths[succ] = {state, symb};
+			// prune processed (and thus the worklist) and insert succ inside
+			processed.remove_supersets_of(0, stored_succ);
+			// TODO: set pushing strategy
+			worklist.push_back(processed.insert(0, stored_succ, succ));
 		}
 	}
 
 	return true;
 } // }}}
 
+} // Anonymous namespace.
+
+/// universality check using Antichains
+bool Mata::Nfa::Algorithms::is_universal_antichains(
+	const Nfa&         aut,
+	const Alphabet&    alphabet,
+	Run*               cex)
+{ // {{{
+	return is_universal_antichains_impl(aut, alphabet, cex, nullptr);
+} // }}}
+
+/// universality check using Antichains with subsumption by simulation
+bool Mata::Nfa::Algorithms::is_universal_antichains_sim(
+	const Nfa&         aut,
+	const Alphabet&    alphabet,
+	Run*               cex)
+{ // {{{
+	const SimulatedStates simulated_states{ get_simulated_states(aut) };
+	return is_universal_antichains_impl(aut, alphabet, cex, &simulated_states);
+} // }}}
+
+bool Mata::Nfa::Algorithms::is_universal_antichains_sim(
+	const Nfa&              aut,
+	const Alphabet&         alphabet,
+	const SimulatedStates&  simulated_states,
+	Run*                    cex)
+{ // {{{
+	assert(simulated_states.size() == aut.size());
+	return is_universal_antichains_impl(aut, alphabet, cex, &simulated_states);
+} // }}}
+
 // The dispatching method that calls the correct one based on parameters
 bool Mata::Nfa::is_universal(
 	const Nfa&         aut,
@@ -164,6 +343,8 @@ bool Mata::Nfa::is_universal(
 	if ("naive" == str_algo) { /* default */ }
 	else if ("antichains" == str_algo) {
 		algo = Algorithms::is_universal_antichains;
+	} else if ("antichains-sim" == str_algo) {
+		algo = Algorithms::is_universal_antichains_sim;
 	} else {
 		throw std::runtime_error(std::to_string(__func__) +
 			" received an unknown value of the \"algo\" key: " + str_algo);
@@ -145,8 +145,10 @@ namespace {
 
             this->outgoingEdges = std::vector<std::vector<std::pair<Mata::Symbol, Mata::Nfa::State>>> (prog_size);
 
+            explicit_nfa.delta.start_bulk();
+
             // We traverse all the states and create corresponding states and edges in mata::Nfa::Nfa
-            for (Mata::Nfa::State current_state = start_state; current_state < prog_size; current_state++) {
+            for (Mata::Nfa::State current_state = static_cast<Mata::Nfa::State>(start_state); current_state < prog_size; current_state++) {
                 re2::Prog::Inst *inst = prog->inst(static_cast<int>(current_state));
                 // Every type of state can be final (due to epsilon transition), so we check it regardless of its type
                 if (this->state_cache.is_final_state[current_state]) {
@@ -252,7 +254,7 @@ namespace {
                     for (auto transition: this->outgoingEdges[copyEdgeFromTo->first]) {
                         // We copy transitions only to states that has incoming edge
                         if (this->state_cache.has_state_incoming_edge[copyEdgeFromTo->second]) {
-                            explicit_nfa.delta.add(copyEdgeFromTo->second, transition.first, transition.second);
+                            explicit_nfa.delta.add_unsorted(copyEdgeFromTo->second, transition.first, transition.second);
                         }
                         // However, we still need to save the transitions (we could possibly copy them to another state in
                         // the epsilon closure that has incoming edge)
@@ -262,6 +264,7 @@ namespace {
                     }
                 }
             }
+            explicit_nfa.delta.finalize();
             RegexParser::renumber_states(output_nfa, prog_size, explicit_nfa);
         }
 
@@ -289,7 +292,7 @@ namespace {
                         }
                         if (this->state_cache.has_state_incoming_edge[mappedState]) {
                             this->state_cache.has_state_incoming_edge[mappedTargetState] = true;
-                            nfa.delta.add(mappedState, symbol, mappedTargetState);
+                            nfa.delta.add_unsorted(mappedState, symbol, mappedTargetState);
                         }
                     }
                 }
@@ -297,7 +300,7 @@ namespace {
             if (use_epsilon) {
                 // There is an epsilon transition to the currentState+1, so we must handle it
                 if (!this->state_cache.is_last[currentState]) {
-                    nfa.delta.add(currentState, epsilon_value, currentState + 1);
+                    nfa.delta.add_unsorted(currentState, epsilon_value, currentState + 1);
                 }
             }
         }
@@ -351,7 +354,7 @@ namespace {
             Mata::Nfa::State mapped_parget_state;
             std::vector<Mata::Nfa::State> states_for_second_check(prog_size);
 
-            for (Mata::Nfa::State state = start_state; state < prog_size; state++) {
+            for (Mata::Nfa::State state = static_cast<Mata::Nfa::State>(start_state); state < prog_size; state++) {
                 re2::Prog::Inst *inst = prog->inst(static_cast<int>(state));
                 if (inst->last()) {
                     this->state_cache.is_last[state] = true;
@@ -479,6 +482,7 @@ namespace {
                 renumbered_explicit_nfa.final.insert(renumbered_states[state]);
             }
 
+            renumbered_explicit_nfa.delta.start_bulk();
             for (Mata::Nfa::State state{ 0 }; state < program_size; state++) {
                 const auto& transition_list = input_nfa.get_moves_from(state);
                 for (const auto& transition: transition_list) {
@@ -488,11 +492,12 @@ namespace {
                         }
                         assert(renumbered_states[state] <= renumbered_explicit_nfa.size());
                         assert(renumbered_states[stateTo] <= renumbered_explicit_nfa.size());
-                        renumbered_explicit_nfa.delta.add(renumbered_states[state], transition.symbol,
-                                                          renumbered_states[stateTo]);
+                        renumbered_explicit_nfa.delta.add_unsorted(renumbered_states[state], transition.symbol,
+                                                                   renumbered_states[stateTo]);
                     }
                 }
             }
+            renumbered_explicit_nfa.delta.finalize();
 
 
             for (auto state: input_nfa.initial) {
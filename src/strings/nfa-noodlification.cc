@@ -61,7 +61,7 @@ SegNfa::NoodleSequence SegNfa::noodlify(const SegNfa& aut, const Symbol epsilon,
         }
     }
 
-    State unused_state = aut.size(); // get some State not used in aut
+    State unused_state = static_cast<State>(aut.size()); // get some State not used in aut
     std::map<std::pair<State, State>, std::shared_ptr<Nfa::Nfa>> segments_one_initial_final;
     segs_one_initial_final(segments, include_empty, unused_state, segments_one_initial_final);
 
@@ -190,7 +190,7 @@ SegNfa::NoodleSubstSequence SegNfa::noodlify_mult_eps(const SegNfa& aut, const s
         }
     }
 
-    State unused_state = aut.size(); // get some State not used in aut
+    State unused_state = static_cast<State>(aut.size()); // get some State not used in aut
     std::map<std::pair<State, State>, std::shared_ptr<Nfa::Nfa>> segments_one_initial_final;
     segs_one_initial_final(segments, include_empty, unused_state, segments_one_initial_final);
 
@@ -0,0 +1,110 @@
+/* tests-antichain.cc -- tests of Antichain
+ *
+ * This file is a part of libmata.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include "../3rdparty/catch.hpp"
+
+#include "mata/utils/antichain.hh"
+
+using namespace Mata::Util;
+
+TEST_CASE("Mata::Util::Antichain") {
+    using Set = std::vector<unsigned>;
+    Antichain<unsigned, int> antichain{};
+    CHECK(antichain.empty());
+    CHECK(!antichain.contains_subset_of(0, Set{ 1, 2 }));
+
+    const auto h1{ antichain.insert(0, Set{ 1, 3 }, 1) };
+    const auto h2{ antichain.insert(0, Set{ 2, 5, 7 }, 2) };
+    const auto h3{ antichain.insert(4, Set{ 1 }, 3) };
+    CHECK(antichain.size() == 3);
+    CHECK(antichain.get_bucket(h3) == 4);
+    CHECK(antichain.get_value(h2) == 2);
+    CHECK(std::ranges::equal(antichain.get_set(h1), Set{ 1, 3 }));
+
+    SECTION("subsumption is checked within buckets") {
+        CHECK(antichain.contains_subset_of(0, Set{ 1, 3 }));
+        CHECK(antichain.contains_subset_of(0, Set{ 0, 1, 2, 3 }));
+        CHECK(antichain.contains_subset_of(0, Set{ 2, 4, 5, 6, 7 }));
+        CHECK(!antichain.contains_subset_of(0, Set{ 1, 2, 5 }));
+        CHECK(!antichain.contains_subset_of(0, Set{}));
+        CHECK(!antichain.contains_subset_of(1, Set{ 1, 3 }));
+        CHECK(antichain.contains_subset_of(4, Set{ 1, 3 }));
+        CHECK(!antichain.contains_subset_of(7, Set{ 1, 3 }));
+    }
+
+    SECTION("removal of supersets") {
+        CHECK(antichain.remove_supersets_of(0, Set{ 4 }) == 0);
+        CHECK(antichain.remove_supersets_of(0, Set{ 3 }) == 1);
+        CHECK(!antichain.is_alive(h1));
+        CHECK(antichain.is_alive(h2));
+        CHECK(antichain.is_alive(h3));
+        CHECK(antichain.size() == 2);
+        CHECK(!antichain.contains_subset_of(0, Set{ 1, 3 }));
+
+        const auto h4{ antichain.insert(0, Set{ 3 }, 4) };
+        CHECK(antichain.contains_subset_of(0, Set{ 1, 3 }));
+        CHECK(antichain.remove_supersets_of(0, Set{}) == 2);
+        CHECK(!antichain.is_alive(h2));
+        CHECK(!antichain.is_alive(h4));
+        CHECK(antichain.is_alive(h3));
+        CHECK(antichain.size() == 1);
+    }
+
+    SECTION("many sets") {
+        antichain.clear();
+        CHECK(antichain.empty());
+        // Pairs { i, i + 100 } are pairwise incomparable.
+        for (unsigned i{ 0 }; i < 100; ++i) {
+            const Set set{ i, i + 100 };
+            CHECK(!antichain.contains_subset_of(0, set));
+            antichain.insert(0, set, static_cast<int>(i));
+        }
+        for (unsigned i{ 0 }; i < 100; ++i) {
+            CHECK(antichain.contains_subset_of(0, Set{ i, 50 + i, i + 100 }));
+            CHECK(!antichain.contains_subset_of(0, Set{ i }));
+        }
+        CHECK(antichain.remove_supersets_of(0, Set{ 150 }) == 1);
+        CHECK(antichain.size() == 99);
+    }
+}
+
+TEST_CASE("Mata::Util::Antichain with bit sets") {
+    // Sets of numbers smaller than 128, two words each.
+    using Set = std::vector<uint64_t>;
+    auto create_set = [](const std::vector<size_t>& numbers) {
+        Set set(2, 0);
+        for (const size_t number: numbers) { BitWords::set(set.data(), number); }
+        return set;
+    };
+    Antichain<uint64_t, int, BitSetTraits> antichain{};
+    const auto h1{ antichain.insert(0, create_set({ 1, 70 }), 1) };
+    const auto h2{ antichain.insert(0, create_set({ 2, 64, 127 }), 2) };
+    CHECK(antichain.size() == 2);
+    CHECK(std::ranges::equal(antichain.get_set(h1), create_set({ 1, 70 })));
+
+    CHECK(antichain.contains_subset_of(0, create_set({ 1, 70 })));
+    CHECK(antichain.contains_subset_of(0, create_set({ 0, 1, 3, 70 })));
+    CHECK(antichain.contains_subset_of(0, create_set({ 2, 5, 64, 100, 127 })));
+    CHECK(!antichain.contains_subset_of(0, create_set({ 1, 2, 64 })));
+    CHECK(!antichain.contains_subset_of(0, create_set({})));
+    CHECK(!antichain.contains_subset_of(1, create_set({ 1, 70 })));
+
+    CHECK(antichain.remove_supersets_of(0, create_set({ 6 })) == 0);
+    CHECK(antichain.remove_supersets_of(0, create_set({ 127 })) == 1);
+    CHECK(antichain.is_alive(h1));
+    CHECK(!antichain.is_alive(h2));
+    CHECK(antichain.remove_supersets_of(0, create_set({})) == 1);
+    CHECK(antichain.empty());
+}
@@ -0,0 +1,98 @@
+/* tests-nfa-dense-dfa.cc -- Tests for deterministic automata with dense transition tables
+ *
+ * This file is a part of libmata.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include <string>
+
+#include "../3rdparty/catch.hpp"
+
+#include "mata/nfa/nfa.hh"
+#include "mata/nfa/dense-dfa.hh"
+
+#include "nfa-util.hh"
+
+using namespace Mata::Nfa;
+using namespace Mata::Util;
+
+namespace {
+    bool match(const DenseDfa& dfa, const std::string& word) {
+        return dfa.match(reinterpret_cast<const uint8_t*>(word.data()), word.size());
+    }
+
+    Run to_run(const std::string& word) {
+        Run run{};
+        for (const char symbol: word) { run.word.push_back(static_cast<unsigned char>(symbol)); }
+        return run;
+    }
+}
+
+TEST_CASE("Mata::Nfa::DenseDfa") {
+    SECTION("matches the language of the automaton") {
+        Nfa aut{ 20 };
+        FILL_WITH_AUT_A(aut);
+        const Nfa dfa{ determinize(aut) };
+        const DenseDfa dense{ dfa };
+        CHECK(dense.num_of_states() == dfa.size());
+        CHECK(dense.alphabet_size() == 256);
+        for (const std::string word: { "", "a", "aa", "ba", "aaa", "aba", "baa", "bba", "abac", "aaaaa", "ab",
+                                       "bab", "cba", "baaca", "abaaa" }) {
+            CHECK(match(dense, word) == is_in_lang(dfa, to_run(word)));
+            CHECK(dense.match(to_run(word).word) == is_in_lang(dfa, to_run(word)));
+        }
+    }
+
+    SECTION("range of symbols") {
+        Nfa aut{ 3 };
+        aut.initial = { 0 };
+        aut.final = { 2 };
+        aut.delta.add(0, 'a', 1);
+        aut.delta.add(1, 'b', 2);
+        aut.delta.add(2, 'z', 2);
+        aut.delta.add(1, 1000, 2);
+
+        const DenseDfa dense{ aut, 'a', 2 };
+        CHECK(match(dense, "ab"));
+        CHECK(!match(dense, "abz"));
+        CHECK(!match(dense, "a"));
+        CHECK(!match(dense, "b"));
+        CHECK(!match(dense, "\x01" "ab"));
+        CHECK(!dense.match(std::vector<Mata::Symbol>{ 'a', 1000 }));
+        CHECK(dense.step(dense.get_initial_state(), 'c') == dense.get_dead_state());
+        CHECK(dense.step(dense.get_dead_state(), 'a') == dense.get_dead_state());
+        CHECK(!dense.is_accepting(dense.get_dead_state()));
+
+        CHECK(match(DenseDfa{ aut }, "abzz"));
+        CHECK_THROWS_AS(DenseDfa(aut, 'a', 0), std::runtime_error);
+    }
+
+    SECTION("automaton without initial states") {
+        Nfa aut{ 1 };
+        aut.final = { 0 };
+        const DenseDfa dense{ aut };
+        CHECK(dense.get_initial_state() == dense.get_dead_state());
+        CHECK(!match(dense, ""));
+        CHECK(!match(dense, "a"));
+    }
+
+    SECTION("nondeterministic automaton") {
+        Nfa aut{ 3 };
+        aut.initial = { 0 };
+        aut.delta.add(0, 'a', 1);
+        aut.delta.add(0, 'a', 2);
+        CHECK_THROWS_AS(DenseDfa(aut), std::runtime_error);
+        aut.delta.remove(0, 'a', 2);
+        aut.initial.insert(1);
+        CHECK_THROWS_AS(DenseDfa(aut), std::runtime_error);
+    }
+}
@@ -16,58 +16,20 @@
  */
 
 
+#include <algorithm>
 #include <unordered_set>
 
 #include "../3rdparty/catch.hpp"
 
+#include "nfa-util.hh"
+
 #include "mata/nfa/nfa.hh"
+#include "mata/nfa/algorithms.hh"
 
 using namespace Mata::Nfa;
 using namespace Mata::Util;
 using namespace Mata::Parser;
 
-// Some common automata {{{
-
-// Automaton A
-#define FILL_WITH_AUT_A(x) \
-    x.initial = {1, 3}; \
-    x.final = {5}; \
-    x.delta.add(1, 'a', 3); \
-    x.delta.add(1, 'a', 10); \
-    x.delta.add(1, 'b', 7); \
-    x.delta.add(3, 'a', 7); \
-    x.delta.add(3, 'b', 9); \
-    x.delta.add(9, 'a', 9); \
-    x.delta.add(7, 'b', 1); \
-    x.delta.add(7, 'a', 3); \
-    x.delta.add(7, 'c', 3); \
-    x.delta.add(10, 'a', 7); \
-    x.delta.add(10, 'b', 7); \
-    x.delta.add(10, 'c', 7); \
-    x.delta.add(7, 'a', 5); \
-    x.delta.add(5, 'a', 5); \
-    x.delta.add(5, 'c', 9); \
-
-
-// Automaton B
-#define FILL_WITH_AUT_B(x) \
-    x.initial = {4}; \
-    x.final = {2, 12}; \
-    x.delta.add(4, 'c', 8); \
-    x.delta.add(4, 'a', 8); \
-    x.delta.add(8, 'b', 4); \
-    x.delta.add(4, 'a', 6); \
-    x.delta.add(4, 'b', 6); \
-    x.delta.add(6, 'a', 2); \
-    x.delta.add(2, 'b', 2); \
-    x.delta.add(2, 'a', 0); \
-    x.delta.add(0, 'a', 2); \
-    x.delta.add(2, 'c', 12); \
-    x.delta.add(12, 'a', 14); \
-    x.delta.add(14, 'b', 12); \
-
-// }}}
-
 TEST_CASE("Mata::Nfa::intersection()")
 { // {{{
     Nfa a, b, res;
@@ -287,6 +249,271 @@ TEST_CASE("Mata::Nfa::intersection() with preserving epsilon transitions")
     CHECK(result.get_trans_from_as_sequence(prod_map[{ 5, 8 }]).empty());
 }
 
+TEST_CASE("Mata::Nfa::intersection() with product map as a hash table")
+{
+    Nfa a{6};
+    a.initial.insert(0);
+    a.final.insert({1, 4, 5});
+    a.delta.add(0, EPSILON, 1);
+    a.delta.add(1, 'a', 1);
+    a.delta.add(1, 'b', 1);
+    a.delta.add(1, 'c', 2);
+    a.delta.add(2, 'b', 4);
+    a.delta.add(2, EPSILON, 3);
+    a.delta.add(3, 'a', 5);
+
+    Nfa b{10};
+    b.initial.insert(0);
+    b.final.insert({2, 4, 8, 7});
+    b.delta.add(0, 'b', 1);
+    b.delta.add(0, 'a', 2);
+    b.delta.add(2, 'a', 4);
+    b.delta.add(2, EPSILON, 3);
+    b.delta.add(3, 'b', 4);
+    b.delta.add(0, 'c', 5);
+    b.delta.add(5, 'a', 8);
+    b.delta.add(5, EPSILON, 6);
+    b.delta.add(6, 'a', 9);
+    b.delta.add(6, 'b', 7);
+
+    const bool preserve_epsilon{ GENERATE(false, true) };
+    std::unordered_map<std::pair<State, State>, State> matrix_prod_map;
+    std::unordered_map<std::pair<State, State>, State> table_prod_map;
+    const Nfa matrix_result{ Algorithms::intersection_eps(a, b, preserve_epsilon, { EPSILON }, &matrix_prod_map) };
+    const Nfa table_result{ Algorithms::intersection_eps(a, b, preserve_epsilon, { EPSILON }, &table_prod_map, 0) };
+
+    CHECK(matrix_result.size() == table_result.size());
+    CHECK(matrix_result.delta.size() == table_result.delta.size());
+    CHECK(matrix_prod_map.size() == table_prod_map.size());
+    CHECK(matrix_prod_map.size() == matrix_result.size());
+    for (const auto& [state_pair, product_state]: table_prod_map) {
+        REQUIRE(matrix_prod_map.count(state_pair) == 1);
+        CHECK(table_result.final[product_state] == matrix_result.final[matrix_prod_map[state_pair]]);
+        CHECK(table_result.initial[product_state] == matrix_result.initial[matrix_prod_map[state_pair]]);
+    }
+    CHECK(are_equivalent(matrix_result, table_result));
+}
+
+TEST_CASE("Mata::Nfa::intersection() of a sequence of automata")
+{
+    Nfa a, b;
+    a.add_state(10);
+    b.add_state(14);
+    FILL_WITH_AUT_A(a);
+    FILL_WITH_AUT_B(b);
+    Nfa c{ 3 };
+    c.initial.insert(0);
+    c.final.insert(1);
+    c.delta.add(0, 'a', 0);
+    c.delta.add(0, 'b', 0);
+    c.delta.add(0, 'c', 0);
+    c.delta.add(0, 'a', 1);
+    c.delta.add(0, 'b', 2); // State 2 is useless.
+
+    SECTION("three automata") {
+        const Nfa result{ intersection({ a, b, c }) };
+        const Nfa folded{ intersection(intersection(a, b), c) };
+        CHECK(are_equivalent(result, folded));
+        // Tuples with useless states are not explored.
+        CHECK(result.size() < folded.size());
+    }
+
+    SECTION("symbol of the first automaton missing in a middle automaton") {
+        // Synchronizing the posts of the initial tuple (1, 1, 0) on 'b' moves past 'a' of the first automaton, which
+        //  is the only symbol of state 1 of the second automaton.
+        Nfa d{ 2 };
+        d.initial = { 1 };
+        d.final = { 0 };
+        d.delta.add(1, 'a', 1);
+        d.delta.add(1, 'b', 0);
+        Nfa e{ 3 };
+        e.initial = { 1, 2 };
+        e.final = { 0, 1 };
+        e.delta.add(0, 'a', 2);
+        e.delta.add(0, 'b', 2);
+        e.delta.add(1, 'a', 0);
+        e.delta.add(1, 'a', 2);
+        e.delta.add(2, 'a', 0);
+        e.delta.add(2, 'b', 2);
+        Nfa f{ 2 };
+        f.initial = { 0 };
+        f.final = { 1 };
+        f.delta.add(0, 'b', 1);
+
+        const Nfa result{ intersection({ d, e, f }) };
+        CHECK(!is_in_lang(result, Run{ { 'b' }, {} }));
+        CHECK(is_lang_empty(result));
+        CHECK(are_equivalent(result, intersection(intersection(d, e), f)));
+    }
+
+    SECTION("repeated automata") {
+        // Tuples of the product repeat states and are not sorted.
+        const Nfa result{ intersection({ b, a, a }) };
+        CHECK(are_equivalent(result, intersection(a, b)));
+    }
+
+    SECTION("automata with empty intersection") {
+        b.final = { 12 };
+        const Nfa result{ intersection({ a, b, c }) };
+        CHECK(is_lang_empty(result));
+    }
+
+    SECTION("single automaton") {
+        const Nfa result{ intersection({ c }) };
+        CHECK(are_equivalent(result, c));
+        CHECK(result.size() == 2);
+    }
+
+    SECTION("no automata") {
+        CHECK_THROWS_AS(intersection(ConstAutRefSequence{}), std::runtime_error);
+    }
+}
+
+TEST_CASE("Mata::Nfa::is_intersection_empty()")
+{
+    Nfa a, b;
+    a.add_state(10);
+    b.add_state(14);
+    FILL_WITH_AUT_A(a);
+    FILL_WITH_AUT_B(b);
+    Run cex{};
+
+    SECTION("non-empty intersection") {
+        CHECK(!is_intersection_empty(a, b, &cex));
+        CHECK(is_in_lang(a, cex));
+        CHECK(is_in_lang(b, cex));
+        CHECK(cex.path.empty());
+        // The counterexample is a shortest word of the intersection, as found in the product.
+        Run product_cex{};
+        CHECK(!is_lang_empty(intersection(a, b), &product_cex));
+        CHECK(cex.word.size() == product_cex.word.size());
+    }
+
+    SECTION("empty intersection") {
+        b.final = { 12 };
+        CHECK(is_intersection_empty(a, b, &cex));
+        CHECK(is_intersection_empty(b, Nfa{ 2 }));
+    }
+
+    SECTION("n-ary intersection") {
+        Nfa c{ 2 };
+        c.initial.insert(0);
+        c.final.insert(1);
+        c.delta.add(0, 'a', 0);
+        c.delta.add(0, 'b', 0);
+        c.delta.add(0, 'a', 1);
+        CHECK(!is_intersection_empty({ a, b, c }, &cex));
+        CHECK(is_in_lang(a, cex));
+        CHECK(is_in_lang(b, cex));
+        CHECK(is_in_lang(c, cex));
+        CHECK(cex.word.back() == 'a');
+        CHECK(!is_intersection_empty({ a }, &cex));
+        CHECK(is_in_lang(a, cex));
+        // Tuples of the product repeat states and are not sorted.
+        CHECK(!is_intersection_empty({ b, a, a }, &cex));
+        CHECK(is_in_lang(a, cex));
+        CHECK(is_in_lang(b, cex));
+
+        c.delta.remove(0, 'a', 1);
+        CHECK(is_intersection_empty({ a, b, c }));
+        CHECK(is_intersection_empty({ c, a, b, a }));
+
+        // The intersection of no automata contains all words, among them the empty one.
+        CHECK(!is_intersection_empty(ConstAutRefSequence{}, &cex));
+        CHECK(cex.word.empty());
+    }
+
+    SECTION("n-ary intersection with a symbol of the first automaton missing in a middle automaton") {
+        // The automata of the test of intersection() of a sequence of automata. Only "b" is accepted by the first and
+        //  the last automaton, and the middle automaton rejects it.
+        Nfa d{ 2 };
+        d.initial = { 1 };
+        d.final = { 0 };
+        d.delta.add(1, 'a', 1);
+        d.delta.add(1, 'b', 0);
+        Nfa e{ 3 };
+        e.initial = { 1, 2 };
+        e.final = { 0, 1 };
+        e.delta.add(0, 'a', 2);
+        e.delta.add(0, 'b', 2);
+        e.delta.add(1, 'a', 0);
+        e.delta.add(1, 'a', 2);
+        e.delta.add(2, 'a', 0);
+        e.delta.add(2, 'b', 2);
+        Nfa f{ 2 };
+        f.initial = { 0 };
+        f.final = { 1 };
+        f.delta.add(0, 'b', 1);
+        CHECK(is_intersection_empty({ d, e, f }, &cex));
+    }
+
+    SECTION("n-ary intersection of random automata") {
+        // Words accepted by all automata are compared with the result and the counterexample.
+        const std::vector<Run> words{ get_all_words(5) };
+        for (unsigned seed{ 0 }; seed < 300; ++seed) {
+            std::vector<Nfa> automata{};
+            for (unsigned nfa{ 0 }; nfa < 3; ++nfa) {
+                automata.push_back(get_random_nfa(4, 3, 3, 0.3, 3 * seed + nfa));
+                automata.back().initial = { nfa };
+            }
+            const ConstAutRefSequence nfas{ automata[0], automata[1], automata[2] };
+            const auto shortest_word{ std::find_if(words.begin(), words.end(), [&automata](const Run& word) {
+                return std::all_of(automata.begin(), automata.end(),
+                                   [&word](const Nfa& nfa) { return is_in_lang(nfa, word); });
+            }) };
+
+            const bool is_empty{ is_intersection_empty(nfas, &cex) };
+            CHECK(is_empty == is_lang_empty(intersection(intersection(automata[0], automata[1]), automata[2])));
+            if (shortest_word != words.end()) {
+                REQUIRE(!is_empty);
+                // The counterexample is a shortest word of the intersection.
+                CHECK(cex.word.size() == shortest_word->word.size());
+            }
+            if (!is_empty) {
+                for (const Nfa& nfa: automata) { CHECK(is_in_lang(nfa, cex)); }
+            }
+            CHECK(is_lang_empty(intersection(nfas)) == is_empty);
+        }
+    }
+}
+
+TEST_CASE("Mata::Nfa::intersection() with parallel options")
+{
+    // Automata with pseudo-random transitions, so that the levels of their product are processed in multiple chunks.
+    const Nfa lhs{ get_random_nfa(50, 4, 3, 0.25, 1) };
+    const Nfa rhs{ get_random_nfa(40, 4, 3, 0.25, 2) };
+
+    std::unordered_map<std::pair<State, State>, State> sequential_prod_map;
+    std::unordered_map<std::pair<State, State>, State> parallel_prod_map;
+    const Nfa sequential_result{ intersection(lhs, rhs, false, &sequential_prod_map) };
+    const size_t threads{ GENERATE(as<size_t>{}, 1, 2, 4) };
+    const Nfa parallel_result{ intersection(lhs, rhs, ParallelOptions{ threads }, &parallel_prod_map) };
+
+    // The results are isomorphic by the product maps.
+    CHECK(parallel_result.size() == sequential_result.size());
+    CHECK(parallel_result.delta.size() == sequential_result.delta.size());
+    REQUIRE(parallel_prod_map.size() == sequential_prod_map.size());
+    std::vector<State> renaming(sequential_result.size());
+    for (const auto& [state_pair, product_state]: sequential_prod_map) {
+        REQUIRE(parallel_prod_map.count(state_pair) == 1);
+        renaming[product_state] = parallel_prod_map[state_pair];
+        CHECK(parallel_result.final[renaming[product_state]] == sequential_result.final[product_state]);
+        CHECK(parallel_result.initial[renaming[product_state]] == sequential_result.initial[product_state]);
+    }
+    for (const Trans& trans: sequential_result.delta) {
+        CHECK(parallel_result.delta.contains(renaming[trans.src], trans.symb, renaming[trans.tgt]));
+    }
+
+    SECTION("Empty product") {
+        Nfa no_initial{ 3 };
+        CHECK(intersection(lhs, no_initial, ParallelOptions{ 4 }).size() == 0);
+    }
+
+    SECTION("capped number of threads") {
+        CHECK(intersection(lhs, rhs, ParallelOptions{ 100000 }).size() == sequential_result.size());
+    }
+}
+
 TEST_CASE("Mata::Nfa::intersection() for profiling", "[.profiling],[intersection]")
 {
     Nfa a{6};
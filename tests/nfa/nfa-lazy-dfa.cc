@@ -0,0 +1,138 @@
+/* tests-nfa-lazy-dfa.cc -- Tests for the determinized automaton constructed on demand
+ *
+ * This file is a part of libmata.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include "../3rdparty/catch.hpp"
+
+#include "mata/nfa/nfa.hh"
+#include "mata/nfa/algorithms.hh"
+#include "mata/nfa/lazy-dfa.hh"
+
+#include "nfa-util.hh"
+
+using namespace Mata::Nfa;
+using namespace Mata::Util;
+using Mata::Symbol;
+
+TEST_CASE("Mata::Nfa::LazyDfa") {
+    Nfa aut{};
+    FILL_WITH_AUT_A(aut);
+
+    SECTION("states and transitions") {
+        LazyDfa dfa{ aut };
+        CHECK(dfa.num_of_explored_states() == 1);
+        const State initial{ dfa.initial_state() };
+        CHECK(dfa.get_macrostate(initial) == StateSet{ 1, 3 });
+        CHECK(!dfa.is_final(initial));
+
+        const State after_a{ dfa.post(initial, 'a') };
+        CHECK(dfa.get_macrostate(after_a) == StateSet{ 3, 7, 10 });
+        CHECK(dfa.post(initial, 'a') == after_a);
+        CHECK(dfa.num_of_cached_transitions() == 1);
+
+        const State sink{ dfa.post(initial, 'c') };
+        CHECK(dfa.is_empty(sink));
+        CHECK(!dfa.is_final(sink));
+        CHECK(dfa.post(sink, 'a') == sink);
+
+        const State after_aa{ dfa.post(after_a, 'a') };
+        CHECK(dfa.get_macrostate(after_aa) == StateSet{ 3, 5, 7 });
+        CHECK(dfa.is_final(after_aa));
+        CHECK(dfa.num_of_explored_states() == 4);
+    }
+
+    SECTION("membership") {
+        LazyDfa dfa{ aut };
+        for (const Run& word: get_all_words(5)) {
+            CHECK(is_in_lang(dfa, word) == is_in_lang(aut, word));
+        }
+        // The lazy view is complete, it has the empty macrostate on top of the states of determinize().
+        CHECK(dfa.num_of_explored_states() <= determinize(aut).size() + 1);
+    }
+
+    SECTION("bounded cache") {
+        LazyDfa dfa{ aut, 2 };
+        CHECK(dfa.max_cached_transitions() == 2);
+        const State initial{ dfa.initial_state() };
+        const State after_a{ dfa.post(initial, 'a') };
+        for (const Run& word: get_all_words(4)) {
+            CHECK(is_in_lang(dfa, word) == is_in_lang(aut, word));
+            CHECK(dfa.num_of_cached_transitions() <= 2);
+        }
+        // States returned before the flushes stay valid.
+        CHECK(dfa.post(initial, 'a') == after_a);
+        dfa.clear_cache();
+        CHECK(dfa.num_of_cached_transitions() == 0);
+        CHECK(dfa.get_macrostate(after_a) == StateSet{ 3, 7, 10 });
+    }
+
+    SECTION("automaton without states") {
+        const Nfa empty_aut{};
+        LazyDfa dfa{ empty_aut };
+        CHECK(dfa.is_empty(dfa.initial_state()));
+        CHECK(!is_in_lang(dfa, Run{ { 'a' }, {} }));
+        CHECK(!is_in_lang(dfa, Run{}));
+    }
+}
+
+TEST_CASE("Mata::Nfa::Algorithms::is_included_lazy_dfa()") {
+    Nfa smaller{};
+    Nfa bigger{};
+    Run cex{};
+    const StringMap params{ { "algorithm", "lazy_dfa" } };
+
+    SECTION("the same automaton") {
+        FILL_WITH_AUT_A(smaller);
+        FILL_WITH_AUT_A(bigger);
+        CHECK(is_included(smaller, bigger, &cex, nullptr, params));
+    }
+
+    SECTION("agrees with antichains") {
+        FILL_WITH_AUT_A(smaller);
+        FILL_WITH_AUT_B(bigger);
+        for (const auto& [lhs, rhs]: { std::make_pair(&smaller, &bigger), std::make_pair(&bigger, &smaller) }) {
+            const bool expected{ Algorithms::is_included_antichains(*lhs, *rhs) };
+            CHECK(Algorithms::is_included_lazy_dfa(*lhs, *rhs, nullptr, &cex) == expected);
+            if (!expected) {
+                CHECK(is_in_lang(*lhs, cex));
+                CHECK(!is_in_lang(*rhs, cex));
+            }
+        }
+    }
+
+    SECTION("shortest counterexample") {
+        smaller.initial = { 0 };
+        smaller.final = { 0, 1, 2 };
+        smaller.delta.add(0, 'a', 1);
+        smaller.delta.add(1, 'a', 2);
+        smaller.delta.add(0, 'b', 2);
+        bigger.initial = { 0 };
+        bigger.final = { 0, 1 };
+        bigger.delta.add(0, 'a', 1);
+        bigger.delta.add(1, 'a', 1);
+
+        CHECK(!is_included(smaller, bigger, &cex, nullptr, params));
+        CHECK(cex.word == std::vector<Symbol>{ 'b' });
+        CHECK(is_included(bigger, smaller, &cex, nullptr, params) == false);
+        CHECK(cex.word == std::vector<Symbol>{ 'a', 'a', 'a' });
+    }
+
+    SECTION("empty word") {
+        smaller.initial = { 0 };
+        smaller.final = { 0 };
+        bigger.initial = { 0 };
+        CHECK(!is_included(smaller, bigger, &cex, nullptr, params));
+        CHECK(cex.word.empty());
+    }
+}
@@ -0,0 +1,187 @@
+/* tests-nfa-macrostate-store.cc -- Tests for the store of macrostates of subset constructions
+ *
+ * This file is a part of libmata.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include "../3rdparty/catch.hpp"
+
+#include "mata/nfa/nfa.hh"
+#include "mata/nfa/macrostate-store.hh"
+
+using namespace Mata::Nfa;
+using namespace Mata::Util;
+namespace BitWords = Mata::Util::BitWords;
+
+TEST_CASE("Mata::Nfa::MacrostateStore") {
+    MacrostateStore macrostates{};
+    CHECK(macrostates.empty());
+
+    SECTION("insert and find") {
+        CHECK(macrostates.insert(StateSet{ 1, 2, 3 }) == std::make_pair(MacrostateStore::Id{ 0 }, true));
+        CHECK(macrostates.insert(StateSet{}) == std::make_pair(MacrostateStore::Id{ 1 }, true));
+        CHECK(macrostates.insert(StateSet{ 2 }) == std::make_pair(MacrostateStore::Id{ 2 }, true));
+        const std::vector<State> states{ 1, 2, 3 };
+        CHECK(macrostates.insert(states.begin(), states.end()) == std::make_pair(MacrostateStore::Id{ 0 }, false));
+        CHECK(macrostates.size() == 3);
+        CHECK(macrostates.num_of_stored_states() == 4);
+
+        CHECK(macrostates.find(StateSet{ 2 }) == 2);
+        CHECK(macrostates.find(StateSet{}) == 1);
+        CHECK(macrostates.find(StateSet{ 1, 2 }) == MacrostateStore::NO_ID);
+        CHECK(macrostates.get_state_set(0) == StateSet{ 1, 2, 3 });
+        CHECK(std::ranges::equal(macrostates[2], std::vector<State>{ 2 }));
+
+        std::unordered_map<StateSet, State> subset_map{};
+        macrostates.to_subset_map(subset_map);
+        CHECK(subset_map == std::unordered_map<StateSet, State>{ { { 1, 2, 3 }, 0 }, { {}, 1 }, { { 2 }, 2 } });
+
+        macrostates.clear();
+        CHECK(macrostates.empty());
+        CHECK(macrostates.find(StateSet{ 2 }) == MacrostateStore::NO_ID);
+    }
+
+    SECTION("many macrostates") {
+        for (State state{ 0 }; state < 1000; ++state) {
+            CHECK(macrostates.insert(StateSet{ state, state + 1, 2 * state + 2 }).second);
+        }
+        for (State state{ 0 }; state < 1000; ++state) {
+            CHECK(macrostates.find(StateSet{ state, state + 1, 2 * state + 2 }) == state);
+        }
+    }
+}
+
+TEST_CASE("Mata::Nfa::determinize() with macrostates") {
+    Nfa aut{ 4 };
+    // Initial states are not inserted in order, the initial macrostate is stored sorted nevertheless.
+    aut.initial = { 1, 0 };
+    aut.final = { 3 };
+    aut.delta.add(0, 'a', 2);
+    aut.delta.add(1, 'a', 3);
+    aut.delta.add(2, 'b', 3);
+    aut.delta.add(3, 'b', 3);
+
+    MacrostateStore macrostates{};
+    const Nfa result{ determinize(aut, macrostates) };
+    CHECK(result.size() == macrostates.size());
+    CHECK(macrostates.get_state_set(static_cast<MacrostateStore::Id>(*result.initial.begin())) == StateSet{ 0, 1 });
+    const MacrostateStore::Id after_a{ macrostates.find(StateSet{ 2, 3 }) };
+    REQUIRE(after_a != MacrostateStore::NO_ID);
+    CHECK(result.delta.contains(*result.initial.begin(), 'a', after_a));
+    CHECK(result.final[after_a]);
+    CHECK(!result.final[*result.initial.begin()]);
+
+    std::unordered_map<StateSet, State> subset_map{};
+    const Nfa result_with_subset_map{ determinize(aut, &subset_map) };
+    CHECK(subset_map.size() == macrostates.size());
+    CHECK(subset_map[StateSet{ 2, 3 }] == after_a);
+}
+
+TEST_CASE("Mata::Nfa::BitMacrostateStore") {
+    BitMacrostateStore macrostates{ 130 };
+    REQUIRE(macrostates.num_of_words() == 3);
+
+    std::vector<uint64_t> words(3, 0);
+    BitWords::set(words.data(), 1);
+    BitWords::set(words.data(), 129);
+    CHECK(macrostates.insert(words.data()) == std::make_pair(BitMacrostateStore::Id{ 0 }, true));
+    BitWords::set(words.data(), 64);
+    CHECK(macrostates.insert(words.data()) == std::make_pair(BitMacrostateStore::Id{ 1 }, true));
+    CHECK(macrostates.insert(words.data()) == std::make_pair(BitMacrostateStore::Id{ 1 }, false));
+    CHECK(macrostates.size() == 2);
+    CHECK(macrostates.get_state_set(0) == StateSet{ 1, 129 });
+    CHECK(macrostates.get_state_set(1) == StateSet{ 1, 64, 129 });
+
+    CHECK(BitWords::is_subset(macrostates[0], macrostates[1], 3));
+    CHECK(!BitWords::is_subset(macrostates[1], macrostates[0], 3));
+    CHECK(BitWords::intersects(macrostates[0], macrostates[1], 3));
+
+    std::vector<uint64_t> other(3, 0);
+    BitWords::set(other.data(), 2);
+    CHECK(!BitWords::intersects(macrostates[1], other.data(), 3));
+    CHECK(macrostates.find(other.data()) == BitMacrostateStore::NO_ID);
+    BitWords::unite(other.data(), macrostates[0], 3);
+    CHECK(BitWords::is_subset(macrostates[0], other.data(), 3));
+    CHECK(BitWords::test(other.data(), 2));
+}
+
+TEST_CASE("Mata::Nfa::TupleStore") {
+    TupleStore tuples{ 3 };
+    CHECK(tuples.empty());
+    CHECK(tuples.arity() == 3);
+
+    // Tuples are neither sorted nor free of duplicates.
+    CHECK(tuples.insert(std::vector<State>{ 2, 0, 2 }) == std::make_pair(TupleStore::Id{ 0 }, true));
+    CHECK(tuples.insert(std::vector<State>{ 2, 2, 0 }) == std::make_pair(TupleStore::Id{ 1 }, true));
+    CHECK(tuples.insert(std::vector<State>{ 0, 2, 2 }) == std::make_pair(TupleStore::Id{ 2 }, true));
+    CHECK(tuples.insert(std::vector<State>{ 2, 0, 2 }) == std::make_pair(TupleStore::Id{ 0 }, false));
+    CHECK(tuples.size() == 3);
+    CHECK(std::ranges::equal(tuples[1], std::vector<State>{ 2, 2, 0 }));
+    CHECK(tuples.find(std::vector<State>{ 0, 2, 2 }) == 2);
+    CHECK(tuples.find(std::vector<State>{ 0, 0, 2 }) == TupleStore::NO_ID);
+
+    // Many tuples, so that the table grows.
+    for (State state{ 0 }; state < 1000; ++state) { tuples.insert(std::vector<State>{ state, 7, state }); }
+    CHECK(tuples.size() == 1003);
+    for (State state{ 0 }; state < 1000; ++state) {
+        const TupleStore::Id id{ tuples.find(std::vector<State>{ state, 7, state }) };
+        REQUIRE(id != TupleStore::NO_ID);
+        CHECK(std::ranges::equal(tuples[id], std::vector<State>{ state, 7, state }));
+    }
+
+    tuples.clear();
+    CHECK(tuples.empty());
+    CHECK(tuples.find(std::vector<State>{ 2, 0, 2 }) == TupleStore::NO_ID);
+}
+
+TEST_CASE("Mata::Nfa::determinize() with bit and sorted macrostates") {
+    Nfa aut{ 20 };
+    aut.initial = { 0, 3 };
+    aut.final = { 7, 19 };
+    for (State state{ 0 }; state < 20; ++state) {
+        aut.delta.add(state, 'a', (state * 7 + 3) % 20);
+        aut.delta.add(state, 'b', (state * 3 + 1) % 20);
+        if (state % 3 == 0) { aut.delta.add(state, 'a', (state + 11) % 20); }
+    }
+
+    std::unordered_map<StateSet, State> subset_map{};
+    const Nfa with_bits{ determinize(aut, &subset_map) };
+    MacrostateStore macrostates{};
+    const Nfa with_sorted_sets{ determinize(aut, macrostates) };
+    CHECK(with_bits.size() == with_sorted_sets.size());
+    CHECK(subset_map.size() == macrostates.size());
+    for (State state{ 0 }; state < with_bits.size(); ++state) {
+        CHECK(subset_map.at(macrostates.get_state_set(static_cast<MacrostateStore::Id>(state))) == state);
+    }
+    CHECK(are_equivalent(with_bits, aut));
+    CHECK(are_equivalent(with_sorted_sets, aut));
+}
+
+TEST_CASE("Mata::Nfa::is_universal() with more states than for bit macrostates") {
+    const State num_of_states{ BitMacrostateStore::MAX_STATES + 10 };
+    Nfa aut{ num_of_states };
+    aut.initial = { 0 };
+    aut.final = { 0, num_of_states - 1 };
+    Mata::OnTheFlyAlphabet alphabet{ std::vector<std::string>{ "a", "b" } };
+    const Mata::Symbol b{ alphabet.translate_symb("b") };
+    const Mata::Symbol a{ alphabet.translate_symb("a") };
+    aut.delta.add(0, a, 0);
+    aut.delta.add(num_of_states - 1, a, num_of_states - 1);
+
+    Run cex{};
+    const StringMap params{ { "algorithm", "antichains" } };
+    CHECK(!is_universal(aut, alphabet, &cex, params));
+    CHECK(cex.word == std::vector<Mata::Symbol>{ b });
+
+    aut.delta.add(0, b, 0);
+    CHECK(is_universal(aut, alphabet, &cex, params));
+}
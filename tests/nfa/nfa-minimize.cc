@@ -0,0 +1,99 @@
+/* tests-nfa-minimize.cc -- Tests for minimization of automata
+ *
+ * This file is a part of libmata.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include "../3rdparty/catch.hpp"
+
+#include "mata/nfa/nfa.hh"
+#include "mata/nfa/algorithms.hh"
+
+#include "nfa-util.hh"
+
+using namespace Mata::Nfa;
+using namespace Mata::Util;
+
+TEST_CASE("Mata::Nfa::Algorithms::minimize_hopcroft()") {
+    Nfa aut{};
+
+    SECTION("equal states are merged") {
+        // Words over {a, b} with an even number of a's, with every state duplicated.
+        aut.initial = { 0 };
+        aut.final = { 0, 2 };
+        aut.delta.add(0, 'a', 1);
+        aut.delta.add(0, 'b', 2);
+        aut.delta.add(1, 'a', 2);
+        aut.delta.add(1, 'b', 3);
+        aut.delta.add(2, 'a', 3);
+        aut.delta.add(2, 'b', 0);
+        aut.delta.add(3, 'a', 0);
+        aut.delta.add(3, 'b', 1);
+
+        const Nfa result{ Algorithms::minimize_hopcroft(aut) };
+        CHECK(result.size() == 2);
+        CHECK(result.initial.size() == 1);
+        CHECK(result.final.size() == 1);
+        CHECK(is_deterministic(result));
+        CHECK(are_equivalent(result, aut));
+    }
+
+    SECTION("partial automaton, useless states are removed") {
+        aut.initial = { 0 };
+        aut.final = { 2, 4 };
+        aut.delta.add(0, 'a', 1);
+        aut.delta.add(0, 'b', 3);
+        aut.delta.add(1, 'a', 2);
+        aut.delta.add(3, 'a', 4);
+        aut.delta.add(0, 'c', 5); // State 5 does not lead to a final state.
+        aut.delta.add(5, 'a', 5);
+        aut.delta.add(6, 'a', 2); // State 6 is not reachable.
+
+        const Nfa result{ Algorithms::minimize_hopcroft(aut) };
+        CHECK(result.size() == 3);
+        CHECK(result.delta.size() == 3);
+        CHECK(are_equivalent(result, aut));
+    }
+
+    SECTION("empty language") {
+        aut.initial = { 0 };
+        aut.delta.add(0, 'a', 1);
+
+        const Nfa result{ Algorithms::minimize_hopcroft(aut) };
+        CHECK(result.size() == 1);
+        CHECK(result.initial.size() == 1);
+        CHECK(result.final.empty());
+        CHECK(result.delta.empty());
+    }
+
+    SECTION("same result as brzozowski") {
+        Nfa aut_b{};
+        FILL_WITH_AUT_A(aut);
+        FILL_WITH_AUT_B(aut_b);
+        for (const Nfa& input: { aut, aut_b, determinize(aut), determinize(aut_b), revert(determinize(aut)) }) {
+            const Nfa hopcroft{ Algorithms::minimize_hopcroft(input) };
+            const Nfa brzozowski{ Algorithms::minimize_brzozowski(input) };
+            CHECK(is_deterministic(hopcroft));
+            CHECK(hopcroft.size() == brzozowski.size());
+            CHECK(hopcroft.delta.size() == brzozowski.delta.size());
+            CHECK(are_equivalent(hopcroft, input));
+        }
+    }
+
+    SECTION("dispatch") {
+        FILL_WITH_AUT_A(aut);
+        const Nfa dfa{ determinize(aut) };
+        CHECK(are_equivalent(minimize(aut, { { "algorithm", "hopcroft" } }), aut));
+        CHECK(minimize(dfa).size() == Algorithms::minimize_hopcroft(dfa).size());
+        CHECK_THROWS_AS(minimize(aut, { { "algorithm", "unknown" } }), std::runtime_error);
+    }
+}
@@ -0,0 +1,88 @@
+/* tests-nfa-multi-matcher.cc -- Tests for matching words against many automata at once
+ *
+ * This file is a part of libmata.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include <string>
+
+#include "../3rdparty/catch.hpp"
+
+#include "mata/nfa/nfa.hh"
+#include "mata/nfa/builder.hh"
+#include "mata/nfa/multi-matcher.hh"
+
+#include "nfa-util.hh"
+
+using namespace Mata::Nfa;
+using namespace Mata::Util;
+using Mata::Symbol;
+
+TEST_CASE("Mata::Nfa::MultiMatcher") {
+    Nfa aut_a{ 20 };
+    FILL_WITH_AUT_A(aut_a);
+    Nfa aut_b{ 15 };
+    FILL_WITH_AUT_B(aut_b);
+    const Nfa word_abc{ Builder::create_single_word_nfa(std::vector<Symbol>{ 'a', 'b', 'c' }) };
+    // Words containing 'c', with epsilon transitions.
+    Nfa contains_c{ 3 };
+    contains_c.initial = { 0 };
+    contains_c.final = { 2 };
+    contains_c.delta.add(0, 'a', 0);
+    contains_c.delta.add(0, 'b', 0);
+    contains_c.delta.add(0, 'c', 0);
+    contains_c.delta.add(0, EPSILON, 1);
+    contains_c.delta.add(1, 'c', 2);
+    contains_c.delta.add(2, 'a', 2);
+    contains_c.delta.add(2, 'b', 2);
+    contains_c.delta.add(2, 'c', 2);
+    const Nfa empty{ 2 };
+
+    const ConstAutRefSequence patterns{ aut_a, aut_b, word_abc, contains_c, empty, word_abc };
+
+    SECTION("matches the languages of the patterns") {
+        MultiMatcher matcher{ patterns };
+        CHECK(matcher.num_of_patterns() == patterns.size());
+        CHECK(matcher.get_union().size() == aut_a.size() + aut_b.size() + 2 * word_abc.size() + 5);
+        CHECK(matcher.pattern_of(static_cast<State>(aut_a.size())) == 1);
+        // is_in_lang() does not follow epsilon transitions.
+        std::vector<Nfa> epsilon_free_patterns{};
+        for (const Nfa& pattern: patterns) { epsilon_free_patterns.push_back(remove_epsilon(pattern)); }
+        // Every word twice, the second time over cached transitions.
+        for (size_t round{ 0 }; round < 2; ++round) {
+            for (const Run& word: get_all_words(5)) {
+                std::vector<MultiMatcher::PatternId> expected{};
+                for (MultiMatcher::PatternId pattern_id{ 0 }; pattern_id < patterns.size(); ++pattern_id) {
+                    if (is_in_lang(epsilon_free_patterns[pattern_id], word)) { expected.push_back(pattern_id); }
+                }
+                CHECK(matcher.match(word.word) == expected);
+                CHECK(matcher.matches_any(word.word) == !expected.empty());
+            }
+        }
+    }
+
+    SECTION("bytes") {
+        MultiMatcher matcher{ patterns, 4 };
+        const std::string abc{ "abc" };
+        const auto* const data{ reinterpret_cast<const uint8_t*>(abc.data()) };
+        CHECK(matcher.match(data, abc.size()) == std::vector<MultiMatcher::PatternId>{ 2, 3, 5 });
+        CHECK(matcher.match(data, 2).empty());
+        CHECK(matcher.match(data + 2, 1) == std::vector<MultiMatcher::PatternId>{ 3 });
+        CHECK(matcher.get_lazy_dfa().num_of_cached_transitions() <= 4);
+    }
+
+    SECTION("no patterns") {
+        MultiMatcher matcher{ ConstAutRefSequence{} };
+        CHECK(matcher.match(std::vector<Symbol>{}).empty());
+        CHECK(!matcher.matches_any(std::vector<Symbol>{ 'a' }));
+    }
+}
@@ -13,47 +13,20 @@ using namespace Mata::Parser;
 // Profiling revert and trim
 /////////////////////////////
 
-TEST_CASE("Mata::Nfa::fragile_revert() speed, simple ", "[.profiling]") {
-    Nfa B;
-    FILL_WITH_AUT_D(B);
-    for (int i = 0; i < 300000; i++) {
-        B = fragile_revert(B);
-    }
-}
-
-TEST_CASE("Mata::Nfa::simple_revert() speed, simple ", "[.profiling]") {
+TEST_CASE("Mata::Nfa::revert() speed, simple ", "[.profiling]") {
     Nfa B;
     FILL_WITH_AUT_B(B);
     for (int i = 0; i < 300000; i++) {
-        B = simple_revert(B);
-    }
-}
-
-TEST_CASE("Mata::Nfa::simple_revert() speed, harder", "[.profiling]") {
-    Nfa B;
-//this gives an interesting test case if the parser is not trimming and reducing
-    Mata::Parser::create_nfa(&B, "((.*){10})*");
-    for (int i = 0; i < 200; i++) {
-        B = simple_revert(B);
-    }
-}
-
-TEST_CASE("Mata::Nfa::fragile_revert() speed, harder", "[.profiling]") {
-    Nfa B;
-//this gives an interesting test case if the parser is not trimming and reducing
-    create_nfa(&B, "((.*){10})*");
-    for (int i = 0; i < 200; i++) {
-        B = fragile_revert(B);
+        B = revert(B);
     }
 }
 
-TEST_CASE("Mata::Nfa::somewhat_simple_revert() speed, harder", "[.profiling]") {
+TEST_CASE("Mata::Nfa::revert() speed, harder", "[.profiling]") {
     Nfa B;
 //this gives an interesting test case if the parser is not trimming and reducing
     create_nfa(&B, "((.*){10})*");
-//FILL_WITH_AUT_C(B);
     for (int i = 0; i < 200; i++) {
-        B = somewhat_simple_revert(B);
+        B = revert(B);
     }
 }
 
@@ -0,0 +1,134 @@
+/* tests-nfa-reorder.cc -- Tests for renumbering states of automata
+ *
+ * This file is a part of libmata.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include <algorithm>
+
+#include "../3rdparty/catch.hpp"
+
+#include "mata/nfa/nfa.hh"
+
+#include "nfa-util.hh"
+
+using namespace Mata::Nfa;
+using namespace Mata::Util;
+
+namespace {
+    bool is_permutation(std::vector<State> renaming) {
+        std::sort(renaming.begin(), renaming.end());
+        for (State state{ 0 }; state < renaming.size(); ++state) {
+            if (renaming[state] != state) { return false; }
+        }
+        return true;
+    }
+}
+
+TEST_CASE("Mata::Nfa::Nfa::reorder()") {
+    Nfa aut{ 6 };
+    aut.initial = { 3 };
+    aut.final = { 2 };
+    aut.delta.add(3, 'a', 1);
+    aut.delta.add(3, 'b', 4);
+    aut.delta.add(1, 'a', 0);
+    aut.delta.add(4, 'a', 2);
+    aut.delta.add(4, 'b', 3);
+    const Nfa original{ aut };
+
+    SECTION("breadth-first order") {
+        CHECK(aut.reorder(ReorderStrategy::BFS) == std::vector<State>{ 3, 1, 4, 0, 2, 5 });
+        CHECK(aut.initial[0]);
+        CHECK(aut.final[4]);
+        CHECK(aut.delta.contains(0, 'a', 1));
+        CHECK(aut.delta.contains(0, 'b', 2));
+        CHECK(aut.delta.contains(1, 'a', 3));
+        CHECK(aut.delta.contains(2, 'a', 4));
+        CHECK(aut.delta.contains(2, 'b', 0));
+        CHECK(aut.delta.size() == original.delta.size());
+        CHECK(aut.size() == original.size());
+    }
+
+    SECTION("depth-first preorder") {
+        CHECK(aut.reorder(ReorderStrategy::DFS_PREORDER) == std::vector<State>{ 2, 1, 4, 0, 3, 5 });
+        CHECK(aut.initial[0]);
+        CHECK(aut.final[4]);
+        CHECK(aut.delta.contains(1, 'a', 2));
+        CHECK(aut.delta.contains(3, 'a', 4));
+    }
+
+    SECTION("all strategies preserve the language") {
+        const ReorderStrategy strategy{ GENERATE(ReorderStrategy::BFS, ReorderStrategy::DFS_PREORDER,
+                                                 ReorderStrategy::REVERSE_CUTHILL_MCKEE) };
+        Nfa aut_a{ 20 };
+        FILL_WITH_AUT_A(aut_a);
+        const Nfa original_a{ aut_a };
+        const std::vector<State> renaming{ aut_a.reorder(strategy) };
+        CHECK(renaming.size() == original_a.size());
+        CHECK(is_permutation(renaming));
+        CHECK(aut_a.delta.size() == original_a.delta.size());
+        for (const Trans& trans: original_a.delta) {
+            CHECK(aut_a.delta.contains(renaming[trans.src], trans.symb, renaming[trans.tgt]));
+        }
+        CHECK(are_equivalent(aut_a, original_a));
+    }
+
+    SECTION("reverse Cuthill-McKee order of a path") {
+        Nfa path{ 8 };
+        const std::vector<State> states{ 6, 0, 5, 2, 7, 1, 3, 4 };
+        path.initial = { states.front() };
+        path.final = { states.back() };
+        for (size_t i{ 0 }; i + 1 < states.size(); ++i) { path.delta.add(states[i], 'a', states[i + 1]); }
+        path.reorder(ReorderStrategy::REVERSE_CUTHILL_MCKEE);
+        for (const Trans& trans: path.delta) {
+            CHECK((trans.src == trans.tgt + 1 || trans.tgt == trans.src + 1));
+        }
+    }
+}
+
+TEST_CASE("Mata::Nfa::reorder() by parameters") {
+    Nfa lhs{ 20 };
+    FILL_WITH_AUT_A(lhs);
+    Nfa rhs{ 15 };
+    FILL_WITH_AUT_B(rhs);
+
+    SECTION("intersection") {
+        std::unordered_map<std::pair<State, State>, State> prod_map{};
+        const Nfa result{ intersection(lhs, rhs, { { "reorder", "bfs" } }, &prod_map) };
+        CHECK(are_equivalent(result, intersection(lhs, rhs)));
+        for (const State lhs_initial: lhs.initial) {
+            for (const State rhs_initial: rhs.initial) {
+                CHECK(result.initial[prod_map.at({ lhs_initial, rhs_initial })]);
+            }
+        }
+        CHECK_THROWS_AS(intersection(lhs, rhs, { { "reorder", "random" } }), std::runtime_error);
+        CHECK_THROWS_AS(intersection(lhs, rhs, { { "preserve_epsilon", "yes" } }), std::runtime_error);
+    }
+
+    SECTION("determinize") {
+        std::unordered_map<StateSet, State> subset_map{};
+        const Nfa result{ determinize(lhs, { { "reorder", "rcm" } }, &subset_map) };
+        CHECK(are_equivalent(result, lhs));
+        CHECK(result.initial[subset_map.at(StateSet(lhs.initial))]);
+        CHECK(subset_map.size() == result.size());
+    }
+
+    SECTION("reduce") {
+        StateToStateMap state_map{};
+        const Nfa result{ reduce(lhs, true, &state_map, { { "algorithm", "simulation" }, { "reorder", "dfs" } }) };
+        CHECK(are_equivalent(result, lhs));
+        for (const auto& [original_state, state]: state_map) {
+            CHECK(state < result.size());
+            if (lhs.initial[original_state]) { CHECK(result.initial[state]); }
+        }
+    }
+}
@@ -0,0 +1,120 @@
+/* tests-nfa-scc.cc -- Tests for strongly connected components of automata
+ *
+ * This file is a part of libmata.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include <algorithm>
+
+#include "../3rdparty/catch.hpp"
+
+#include "mata/nfa/nfa.hh"
+#include "mata/nfa/scc.hh"
+
+#include "nfa-util.hh"
+
+using namespace Mata::Nfa;
+using namespace Mata::Util;
+
+namespace {
+    std::vector<State> sorted_component(const SccDecomposition& sccs, const size_t component) {
+        std::vector<State> states(sccs[component].begin(), sccs[component].end());
+        std::sort(states.begin(), states.end());
+        return states;
+    }
+}
+
+TEST_CASE("Mata::Nfa::compute_sccs()") {
+    Nfa aut{ 7 };
+
+    SECTION("components in a topological order") {
+        aut.delta.add(0, 'a', 1);
+        aut.delta.add(1, 'a', 2);
+        aut.delta.add(2, 'b', 0);
+        aut.delta.add(2, 'a', 3);
+        aut.delta.add(3, 'a', 4);
+        aut.delta.add(4, 'b', 3);
+        aut.delta.add(5, 'a', 5);
+        aut.delta.add(5, 'a', 0);
+
+        const SccDecomposition sccs{ compute_sccs(aut) };
+        REQUIRE(sccs.num_of_components() == 4);
+        CHECK(sccs.component_of(0) == sccs.component_of(1));
+        CHECK(sccs.component_of(0) == sccs.component_of(2));
+        CHECK(sccs.component_of(3) == sccs.component_of(4));
+        CHECK(sorted_component(sccs, sccs.component_of(1)) == std::vector<State>{ 0, 1, 2 });
+        for (const Trans& trans: aut.delta) {
+            CHECK(sccs.component_of(trans.src) <= sccs.component_of(trans.tgt));
+        }
+        CHECK(sccs.is_on_cycle(0));
+        CHECK(sccs.is_on_cycle(4));
+        CHECK(sccs.is_on_cycle(5));
+        CHECK(!sccs.is_on_cycle(6));
+        CHECK(sccs[sccs.component_of(6)].size() == 1);
+    }
+
+    SECTION("transitions over a single symbol") {
+        aut.delta.add(0, 'a', 1);
+        aut.delta.add(1, 'b', 0);
+        aut.delta.add(1, 'a', 2);
+        aut.delta.add(2, 'a', 1);
+
+        const SccDecomposition sccs{ compute_sccs(aut, 'a') };
+        CHECK(sccs.num_of_components() == 6);
+        CHECK(sccs.component_of(1) == sccs.component_of(2));
+        CHECK(sccs.component_of(0) < sccs.component_of(1));
+        CHECK(!sccs.is_on_cycle(0));
+        CHECK(compute_sccs(aut).num_of_components() == 5);
+    }
+
+    SECTION("long path does not overflow the stack") {
+        constexpr State num_of_states{ 200000 };
+        for (State state{ 0 }; state + 1 < num_of_states; ++state) { aut.delta.add(state, 'a', state + 1); }
+        aut.delta.add(num_of_states - 1, 'a', 0);
+        const SccDecomposition sccs{ compute_sccs(aut) };
+        CHECK(sccs.num_of_components() == 1);
+        CHECK(sccs[0].size() == num_of_states);
+    }
+
+    SECTION("automaton without transitions") {
+        const SccDecomposition sccs{ compute_sccs(aut) };
+        CHECK(sccs.num_of_components() == aut.size());
+        CHECK(compute_sccs(Nfa{}).num_of_components() == 0);
+    }
+}
+
+TEST_CASE("Mata::Nfa::remove_epsilon() with epsilon cycles") {
+    Nfa aut{ 5 };
+    aut.initial = { 0 };
+    aut.final = { 4 };
+    aut.delta.add(0, EPSILON, 1);
+    aut.delta.add(1, EPSILON, 0);
+    aut.delta.add(1, EPSILON, 2);
+    aut.delta.add(2, 'a', 3);
+    aut.delta.add(3, EPSILON, 4);
+    aut.delta.add(4, EPSILON, 3);
+
+    const Nfa result{ remove_epsilon(aut) };
+    CHECK(result.delta.contains(0, 'a', 3));
+    CHECK(result.delta.contains(1, 'a', 3));
+    CHECK(result.delta.contains(2, 'a', 3));
+    CHECK(result.delta.size() == 3);
+    CHECK(result.final[3]);
+    CHECK(result.final[4]);
+    CHECK(!result.final[0]);
+
+    aut.remove_epsilon();
+    CHECK(aut.delta.size() == 3);
+    for (const Trans& trans: result.delta) { CHECK(aut.delta.contains(trans.src, trans.symb, trans.tgt)); }
+    CHECK(StateSet(aut.final) == StateSet(result.final));
+    CHECK(StateSet(aut.initial) == StateSet(result.initial));
+}
@@ -0,0 +1,136 @@
+/* tests-nfa-symbol-classes.cc -- Tests for classes of symbols with the same transitions
+ *
+ * This file is a part of libmata.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include "../3rdparty/catch.hpp"
+
+#include "mata/nfa/nfa.hh"
+#include "mata/nfa/symbol-classes.hh"
+
+#include "nfa-util.hh"
+
+using namespace Mata::Nfa;
+using namespace Mata::Util;
+using Mata::Symbol;
+
+namespace {
+    /// Identifier: a letter followed by letters and digits, with 'x' leading to an extra final state.
+    Nfa create_identifier_nfa() {
+        Nfa aut{ 3 };
+        aut.initial = { 0 };
+        aut.final = { 1, 2 };
+        for (Symbol symbol{ 'a' }; symbol <= 'z'; ++symbol) {
+            aut.delta.add(0, symbol, 1);
+            aut.delta.add(1, symbol, 1);
+        }
+        for (Symbol symbol{ '0' }; symbol <= '9'; ++symbol) { aut.delta.add(1, symbol, 1); }
+        aut.delta.add(1, 'x', 2);
+        return aut;
+    }
+}
+
+TEST_CASE("Mata::Nfa::compute_symbol_classes()") {
+    const Nfa aut{ create_identifier_nfa() };
+
+    SECTION("symbols of transitions") {
+        const SymbolClasses classes{ compute_symbol_classes(aut) };
+        REQUIRE(classes.num_of_classes() == 3);
+        CHECK(classes.class_of('0') == 0);
+        CHECK(classes.class_of('9') == 0);
+        CHECK(classes.class_of('a') == 1);
+        CHECK(classes.class_of('z') == 1);
+        CHECK(classes.class_of('x') == 2);
+        CHECK(classes[0].size() == 10);
+        CHECK(classes[1].size() == 25);
+        CHECK(classes[2] == OrdVector<Symbol>{ 'x' });
+        CHECK(classes.get_representative(1) == 'a');
+        CHECK(!classes.contains('!'));
+        CHECK(classes.get_class_map().size() == 36);
+    }
+
+    SECTION("symbols of an alphabet") {
+        OrdVector<Symbol> symbols{};
+        for (Symbol symbol{ 0 }; symbol < 'x'; ++symbol) { symbols.insert(symbol); }
+        const SymbolClasses classes{ compute_symbol_classes(aut, symbols) };
+        // Unused symbols of the alphabet, digits, letters of the alphabet, 'x', letters outside of the alphabet.
+        REQUIRE(classes.num_of_classes() == 5);
+        CHECK(classes.class_of('!') == 0);
+        CHECK(classes.class_of('0') == 1);
+        CHECK(classes.class_of('a') == 2);
+        CHECK(classes.class_of('w') == 2);
+        CHECK(classes.class_of('x') == 3);
+        CHECK(classes.class_of('y') == 4);
+        CHECK(classes.class_of('z') == 4);
+        CHECK(classes.get_classes_of(symbols) == OrdVector<Symbol>{ 0, 1, 2 });
+    }
+
+    SECTION("epsilon transitions") {
+        Nfa aut_eps{ aut };
+        aut_eps.delta.add(2, EPSILON, 0);
+        const SymbolClasses classes{ compute_symbol_classes(aut_eps) };
+        CHECK(!classes.contains(EPSILON));
+        CHECK(classes.num_of_classes() == 3);
+        const Nfa over_classes{ to_symbol_classes(aut_eps, classes) };
+        CHECK(over_classes.delta.contains(2, EPSILON, 0));
+        CHECK(from_symbol_classes(over_classes, classes).delta.contains(2, EPSILON, 0));
+    }
+
+    SECTION("automaton without transitions") {
+        CHECK(compute_symbol_classes(Nfa{ 2 }).num_of_classes() == 0);
+        CHECK(compute_symbol_classes(Nfa{ 2 }, { 'a', 'b' }).num_of_classes() == 1);
+    }
+}
+
+TEST_CASE("Mata::Nfa::to_symbol_classes()") {
+    Nfa aut{ 20 };
+    FILL_WITH_AUT_A(aut);
+    const SymbolClasses classes{ compute_symbol_classes(aut) };
+    const Nfa over_classes{ to_symbol_classes(aut, classes) };
+    CHECK(over_classes.size() == aut.size());
+    CHECK(over_classes.delta.size() <= aut.delta.size());
+    for (const Trans& trans: aut.delta) {
+        CHECK(over_classes.delta.contains(trans.src, classes.class_of(trans.symb), trans.tgt));
+    }
+
+    const Nfa back{ from_symbol_classes(over_classes, classes) };
+    CHECK(back.delta.size() == aut.delta.size());
+    for (const Trans& trans: aut.delta) { CHECK(back.delta.contains(trans.src, trans.symb, trans.tgt)); }
+    CHECK(StateSet(back.initial) == StateSet(aut.initial));
+    CHECK(StateSet(back.final) == StateSet(aut.final));
+}
+
+TEST_CASE("Mata::Nfa::complement() and is_universal() over symbol classes") {
+    const Nfa aut{ create_identifier_nfa() };
+    OrdVector<Symbol> symbols{};
+    for (Symbol symbol{ 0 }; symbol < 256; ++symbol) { symbols.insert(symbol); }
+    Mata::EnumAlphabet alphabet{ symbols.begin(), symbols.end() };
+
+    const Nfa cmpl{ complement(aut, symbols) };
+    CHECK(is_in_lang(cmpl, Run{ {}, {} }));
+    CHECK(is_in_lang(cmpl, Run{ { '0' }, {} }));
+    CHECK(is_in_lang(cmpl, Run{ { 'a', '!' }, {} }));
+    CHECK(!is_in_lang(cmpl, Run{ { 'a', '0', 'x' }, {} }));
+    CHECK(!is_in_lang(cmpl, Run{ { 'x' }, {} }));
+    CHECK(is_lang_empty(intersection(aut, cmpl)));
+    // The complement is complete over all bytes.
+    for (State state{ 0 }; state < cmpl.size(); ++state) { CHECK(cmpl.delta[state].size() == 256); }
+
+    const Nfa universal{ uni(aut, cmpl) };
+    for (const std::string algorithm: { "naive", "antichains", "antichains-sim" }) {
+        Run cex{};
+        CHECK(!is_universal(aut, alphabet, &cex, { { "algorithm", algorithm } }));
+        CHECK(!is_in_lang(aut, cex));
+        CHECK(is_universal(universal, alphabet, { { "algorithm", algorithm } }));
+    }
+}
@@ -1,3 +1,11 @@
+#ifndef MATA_TESTS_NFA_UTIL_HH
+#define MATA_TESTS_NFA_UTIL_HH
+
+#include <random>
+#include <vector>
+
+#include "mata/nfa/nfa.hh"
+
 // Automaton A
 #define FILL_WITH_AUT_A(x) \
     x.initial = {1, 3}; \
@@ -96,3 +104,43 @@
 	x.delta.add(2, 'a', 4); \
 	x.delta.add(1, 'a', 3); \
 
+/// All words over symbols 'a', 'b' and 'c' of length at most @p max_length.
+inline std::vector<Mata::Nfa::Run> get_all_words(const size_t max_length) {
+    std::vector<Mata::Nfa::Run> words{ Mata::Nfa::Run{} };
+    for (size_t i{ 0 }; i < words.size(); ++i) {
+        if (words[i].word.size() == max_length) { continue; }
+        for (const Mata::Symbol symbol: { Mata::Symbol{ 'a' }, Mata::Symbol{ 'b' }, Mata::Symbol{ 'c' } }) {
+            Mata::Nfa::Run word{ words[i] };
+            word.word.push_back(symbol);
+            words.push_back(word);
+        }
+    }
+    return words;
+}
+
+/**
+ * Automaton with @p num_of_states states (at least two), initial states 0 and 1, and @p num_of_transitions transitions
+ *  from each state over the first @p num_of_symbols symbols from 'a' to random targets. Each state is final with
+ *  probability @p final_probability. Equal arguments give equal automata.
+ */
+inline Mata::Nfa::Nfa get_random_nfa(const size_t num_of_states, const size_t num_of_transitions,
+                                     const size_t num_of_symbols, const double final_probability,
+                                     const unsigned seed) {
+    std::mt19937 generator{ seed };
+    std::uniform_int_distribution<size_t> random_state{ 0, num_of_states - 1 };
+    std::uniform_int_distribution<size_t> random_symbol{ 0, num_of_symbols - 1 };
+    std::bernoulli_distribution is_final{ final_probability };
+
+    Mata::Nfa::Nfa aut{ num_of_states };
+    aut.initial = { 0, 1 };
+    for (Mata::Nfa::State state{ 0 }; state < num_of_states; ++state) {
+        if (is_final(generator)) { aut.final.insert(state); }
+        for (size_t transition{ 0 }; transition < num_of_transitions; ++transition) {
+            aut.delta.add(state, static_cast<Mata::Symbol>('a' + random_symbol(generator)),
+                          static_cast<Mata::Nfa::State>(random_state(generator)));
+        }
+    }
+    return aut;
+}
+
+#endif // MATA_TESTS_NFA_UTIL_HH
@@ -1,5 +1,8 @@
 // TODO: some header
 
+#include <memory_resource>
+#include <random>
+#include <thread>
 #include <unordered_set>
 
 #include "../3rdparty/catch.hpp"
@@ -594,6 +597,50 @@ TEST_CASE("Mata::Nfa::determinize()")
     }
 } // }}}
 
+TEST_CASE("Mata::Nfa::determinize() with threads")
+{
+    // Automaton with pseudo-random transitions, so that its levels of macrostates are processed in multiple chunks.
+    const Nfa aut{ get_random_nfa(24, 3, 3, 0.2, 42) };
+
+    std::unordered_map<StateSet, State> sequential_subset_map;
+    const Nfa sequential_result{ determinize(aut, &sequential_subset_map) };
+    std::unordered_map<StateSet, State> single_thread_subset_map;
+    const Nfa single_thread_result{ determinize(aut, { { "threads", "1" } }, &single_thread_subset_map) };
+    CHECK(single_thread_result.size() == sequential_result.size());
+    CHECK(single_thread_result.delta.size() == sequential_result.delta.size());
+    CHECK(single_thread_subset_map.size() == sequential_subset_map.size());
+    for (const auto& [macrostate, state]: sequential_subset_map) {
+        REQUIRE(single_thread_subset_map.count(macrostate) == 1);
+        CHECK(single_thread_result.final[single_thread_subset_map[macrostate]] == sequential_result.final[state]);
+    }
+    CHECK(are_equivalent(single_thread_result, sequential_result));
+
+    // The result does not depend on the number of threads.
+    const std::string threads{ GENERATE("2", "4", "0") };
+    std::unordered_map<StateSet, State> subset_map;
+    const Nfa result{ determinize(aut, { { "threads", threads } }, &subset_map) };
+    CHECK(subset_map == single_thread_subset_map);
+    CHECK(result.initial.size() == 1);
+    CHECK(result.initial[0]);
+    CHECK(StateSet(result.final) == StateSet(single_thread_result.final));
+    std::vector<Trans> transitions{};
+    for (const Trans& trans: result.delta) { transitions.push_back(trans); }
+    std::vector<Trans> single_thread_transitions{};
+    for (const Trans& trans: single_thread_result.delta) { single_thread_transitions.push_back(trans); }
+    CHECK(transitions == single_thread_transitions);
+
+    SECTION("invalid number of threads") {
+        CHECK_THROWS_AS(determinize(aut, { { "threads", "many" } }), std::runtime_error);
+        CHECK_THROWS_AS(determinize(aut, { { "threads", "-1" } }), std::runtime_error);
+        CHECK_THROWS_AS(determinize(aut, { { "threads", " 2" } }), std::runtime_error);
+        CHECK_THROWS_AS(determinize(aut, { { "threads", "" } }), std::runtime_error);
+    }
+
+    SECTION("capped number of threads") {
+        CHECK(determinize(aut, { { "threads", "1000000" } }).size() == single_thread_result.size());
+    }
+}
+
 TEST_CASE("Mata::Nfa::minimize() for profiling", "[.profiling],[minimize]") {
     Nfa aut(4);
     Nfa result;
@@ -1338,6 +1385,7 @@ TEST_CASE("Mata::Nfa::is_universal()")
 	const std::unordered_set<std::string> ALGORITHMS = {
 		"naive",
 		"antichains",
+		"antichains-sim",
 	};
 
 	SECTION("empty automaton, empty alphabet")
@@ -1555,6 +1603,8 @@ TEST_CASE("Mata::Nfa::is_included()")
 	const std::unordered_set<std::string> ALGORITHMS = {
 		"naive",
 		"antichains",
+		"antichains-sim",
+		"hkc",
 	};
 
 	SECTION("{} <= {}, empty alphabet")
@@ -1744,6 +1794,64 @@ TEST_CASE("Mata::Nfa::is_included()")
 	}
 } // }}}
 
+TEST_CASE("Mata::Nfa::Algorithms::is_included_hkc()")
+{
+    Nfa smaller;
+    Nfa bigger;
+    Run cex;
+
+    SECTION("agrees with antichains")
+    {
+        FILL_WITH_AUT_A(smaller);
+        FILL_WITH_AUT_B(bigger);
+        for (const auto& [lhs, rhs] : { std::make_pair(&smaller, &bigger), std::make_pair(&bigger, &smaller),
+                                        std::make_pair(&smaller, &smaller) }) {
+            const bool expected{ is_included_antichains(*lhs, *rhs) };
+            CHECK(is_included_hkc(*lhs, *rhs, nullptr, &cex) == expected);
+            if (!expected) {
+                CHECK(is_in_lang(*lhs, cex));
+                CHECK(!is_in_lang(*rhs, cex));
+            }
+            CHECK(are_equivalent_hkc(*lhs, *rhs) == are_equivalent(*lhs, *rhs));
+        }
+    }
+
+    SECTION("shortest counterexample")
+    {
+        // a* is not included in (aa)*, the shortest counterexample is "a".
+        smaller.initial = {0};
+        smaller.final = {0};
+        smaller.delta.add(0, 'a', 0);
+        bigger.initial = {0};
+        bigger.final = {0};
+        bigger.delta.add(0, 'a', 1);
+        bigger.delta.add(1, 'a', 0);
+
+        CHECK(is_included_hkc(bigger, smaller, nullptr, &cex));
+        CHECK(!is_included_hkc(smaller, bigger, nullptr, &cex));
+        CHECK(cex.word == std::vector<Symbol>{ 'a' });
+        CHECK(!are_equivalent_hkc(smaller, bigger, nullptr, &cex));
+        CHECK(cex.word == std::vector<Symbol>{ 'a' });
+    }
+
+    SECTION("equivalent automata with different structure")
+    {
+        // (a + b)* with one and with two states.
+        smaller.initial = {0};
+        smaller.final = {0};
+        smaller.delta.add(0, 'a', 0);
+        smaller.delta.add(0, 'b', 0);
+        bigger.initial = {0, 1};
+        bigger.final = {0, 1};
+        bigger.delta.add(0, 'a', 1);
+        bigger.delta.add(1, 'b', 0);
+        bigger.delta.add(0, 'b', 0);
+        bigger.delta.add(1, 'a', 1);
+        CHECK(are_equivalent_hkc(smaller, bigger));
+        CHECK(are_equivalent(smaller, bigger, {{"algorithm", "hkc"}}));
+    }
+}
+
 TEST_CASE("Mata::Nfa::are_equivalent")
 {
     Nfa smaller(10);
@@ -1754,6 +1862,8 @@ TEST_CASE("Mata::Nfa::are_equivalent")
     const std::unordered_set<std::string> ALGORITHMS = {
             "naive",
             "antichains",
+            "antichains-sim",
+            "hkc",
     };
 
     SECTION("{} == {}, empty alphabet")
@@ -2031,6 +2141,37 @@ TEST_CASE("Mata::Nfa::revert()")
 		CHECK(res.delta.contains(12, 'b', 14));
 		CHECK(res.delta.contains(14, 'a', 12));
 	}
+
+	SECTION("symbols of large magnitude") {
+		aut.initial = { 0 };
+		aut.final = { 2 };
+		aut.delta.add(0, 0x10FFFF, 1);
+		aut.delta.add(0, 'a', 1);
+		aut.delta.add(1, 0xFFFFFFF0, 2);
+		aut.delta.add(3, 'a', 1);
+		Nfa res = revert(aut);
+		CHECK(res.initial[2]);
+		CHECK(res.final[0]);
+		CHECK(res.get_num_of_trans() == 4);
+		CHECK(res.delta.contains(1, 0x10FFFF, 0));
+		CHECK(res.delta.contains(1, 'a', 0));
+		CHECK(res.delta.contains(1, 'a', 3));
+		CHECK(res.delta.contains(2, 0xFFFFFFF0, 1));
+		CHECK(res.delta[1].find('a')->targets == StateSet{ 0, 3 });
+	}
+
+	SECTION("in place") {
+		Nfa nfa{ 15 };
+		FILL_WITH_AUT_B(nfa);
+		const Nfa res = revert(nfa);
+		nfa.revert_inplace();
+		CHECK(StateSet(nfa.initial) == StateSet(res.initial));
+		CHECK(StateSet(nfa.final) == StateSet(res.final));
+		CHECK(nfa.get_num_of_trans() == 12);
+		for (const Trans& trans: res.delta) { CHECK(nfa.delta.contains(trans.src, trans.symb, trans.tgt)); }
+		nfa.revert_inplace();
+		CHECK(are_equivalent(nfa, revert(res)));
+	}
 } // }}}
 
 
@@ -2292,6 +2433,60 @@ TEST_CASE("Mata::Nfa::fw-direct-simulation()")
     }
 } // }}
 
+TEST_CASE("Mata::Nfa::Algorithms::get_simulated_states()")
+{
+    Nfa aut(6);
+    aut.initial.insert(1);
+    aut.final.insert(2);
+    aut.delta.add(1, 'a', 4);
+    aut.delta.add(4, 'b', 5);
+    aut.delta.add(2, 'b', 5);
+    aut.delta.add(1, 'b', 4);
+
+    const std::vector<std::vector<State>> simulated_states{ Algorithms::get_simulated_states(aut) };
+    const Simlib::Util::BinaryRelation simulation{ compute_relation(aut) };
+    REQUIRE(simulated_states.size() == 6);
+    for (State r = 0; r < 6; ++r) {
+        CHECK(std::is_sorted(simulated_states[r].begin(), simulated_states[r].end()));
+        for (State q = 0; q < 6; ++q) {
+            const bool is_simulated{ std::binary_search(simulated_states[r].begin(), simulated_states[r].end(), q) };
+            CHECK(is_simulated == (q == r || simulation.get(q, r)));
+        }
+    }
+    CHECK(std::binary_search(simulated_states[1].begin(), simulated_states[1].end(), 4));
+    CHECK(Algorithms::get_simulated_states(Nfa{}).empty());
+}
+
+TEST_CASE("Mata::Nfa::Algorithms antichains with precomputed simulated states")
+{
+    Nfa bigger(20);
+    FILL_WITH_AUT_A(bigger);
+    Nfa smaller(15);
+    FILL_WITH_AUT_B(smaller);
+    const Algorithms::SimulatedStates simulated_states{ Algorithms::get_simulated_states(bigger) };
+
+    for (const Nfa* aut : { &smaller, &bigger }) {
+        Run cex{};
+        Run cex_precomputed{};
+        CHECK(Algorithms::is_included_antichains_sim(*aut, bigger, simulated_states, &cex_precomputed)
+              == Algorithms::is_included_antichains_sim(*aut, bigger, nullptr, &cex));
+        CHECK(cex_precomputed.word == cex.word);
+    }
+    CHECK(Algorithms::is_included_antichains_sim(bigger, bigger, simulated_states));
+
+    Nfa universal(1);
+    universal.initial = { 0 };
+    universal.final = { 0 };
+    universal.delta.add(0, 'a', 0);
+    universal.delta.add(0, 'b', 0);
+    const Mata::EnumAlphabet alphabet{ 'a', 'b' };
+    Run cex{};
+    CHECK(Algorithms::is_universal_antichains_sim(universal, alphabet,
+                                                  Algorithms::get_simulated_states(universal), &cex));
+    CHECK(!Algorithms::is_universal_antichains_sim(bigger, alphabet, simulated_states, &cex));
+    CHECK(!is_in_lang(bigger, cex));
+}
+
 TEST_CASE("Mata::Nfa::reduce_size_by_simulation()")
 {
 	Nfa aut;
@@ -2743,6 +2938,122 @@ TEST_CASE("Mata::Nfa::trim()")
         CHECK(aut.size() == 0);
         CHECK(state_map.empty());
     }
+
+    SECTION("Path to final states closing a cycle") {
+        Nfa aut{ 4 };
+        aut.initial.insert(0);
+        aut.final.insert(3);
+        aut.delta.add(0, 'a', 1);
+        aut.delta.add(1, 'a', 2);
+        aut.delta.add(2, 'a', 0);
+        aut.delta.add(0, 'b', 3);
+        aut.trim();
+        CHECK(aut.size() == 4);
+        CHECK(aut.delta.size() == 4);
+    }
+}
+
+TEST_CASE("Mata::Nfa::incremental_trim()") {
+    Nfa aut{ 6 };
+    aut.initial.insert(0);
+    aut.final.insert(5);
+    aut.delta.add(0, 'a', 1);
+    aut.delta.add(1, 'a', 2);
+    aut.delta.add(2, 'a', 5);
+    aut.delta.add(0, 'b', 3);
+    aut.delta.add(3, 'b', 4);
+    aut.delta.add(4, 'b', 5);
+    aut.add_state(7);
+    StateToStateMap state_map{};
+
+    SECTION("tombstones are compacted lazily") {
+        aut.incremental_trim(&state_map, 0.4);
+        CHECK(aut.size() == 6);
+        CHECK(state_map.size() == 6);
+
+        aut.delta.remove(3, 'b', 4);
+        aut.incremental_trim(&state_map, 0.4);
+        CHECK(aut.size() == 6);
+        CHECK(!aut.delta.contains(0, 'b', 3));
+        CHECK(aut.delta[4].empty());
+        CHECK(aut.get_useful_states().count() == 4);
+        CHECK(state_map.size() == 4);
+        CHECK(state_map.at(5) == 5);
+
+        aut.delta.add(2, 'c', 6);
+        aut.incremental_trim(&state_map, 0.4);
+        CHECK(aut.size() == 4);
+        CHECK(aut.delta.size() == 3);
+        CHECK(state_map.size() == 4);
+        CHECK(state_map.at(5) == 3);
+        CHECK(aut.final[3]);
+    }
+
+    SECTION("tombstones become useful again") {
+        aut.incremental_trim(nullptr, 1.0);
+        aut.final.erase(5);
+        aut.final.insert(4);
+        aut.incremental_trim(nullptr, 1.0);
+        CHECK(aut.delta.size() == 2);
+        CHECK(aut.delta[1].empty());
+        aut.delta.add(0, 'a', 1);
+        aut.delta.add(1, 'a', 4);
+        aut.incremental_trim(nullptr, 1.0);
+        CHECK(aut.delta.size() == 4);
+        CHECK(aut.get_useful_states().count() == 4);
+    }
+
+    SECTION("untracked modification trims the whole automaton") {
+        aut.incremental_trim(nullptr, 1.0);
+        aut.delta.get_mutable_post(1).clear();
+        aut.incremental_trim(nullptr, 1.0);
+        CHECK(aut.size() == 4);
+    }
+}
+
+TEST_CASE("Mata::Nfa::incremental_trim() agrees with trim()") {
+    const double defragment_threshold{ GENERATE(0.0, 0.25, 1.0) };
+    std::mt19937 generator{ 42 };
+    const auto random_state = [&](const size_t bound) {
+        return std::uniform_int_distribution<State>{ 0, static_cast<State>(bound - 1) }(generator);
+    };
+    Nfa aut{ get_random_nfa(30, 3, 2, 0.1, 42) };
+
+    for (size_t round{ 0 }; round < 60; ++round) {
+        Nfa expected{ aut };
+        expected.trim();
+        aut.incremental_trim(nullptr, defragment_threshold);
+        const Mata::BoolVector useful_states{ aut.get_useful_states() };
+        CHECK(useful_states.count() == expected.size());
+        for (const Trans& trans: aut.delta) { CHECK((useful_states[trans.src] && useful_states[trans.tgt])); }
+        CHECK(are_equivalent(aut, expected));
+        if (defragment_threshold <= 0.0) { CHECK(aut.size() == expected.size()); }
+
+        for (size_t change{ 0 }; change < 4; ++change) {
+            const size_t num_of_states{ aut.size() + 1 };
+            switch (random_state(8)) {
+                case 0: case 1: case 2: case 3:
+                    aut.delta.add(random_state(num_of_states), static_cast<Symbol>('a' + random_state(2)),
+                                  random_state(num_of_states));
+                    break;
+                case 4: case 5: {
+                    std::vector<Trans> transitions{ aut.delta.begin(), aut.delta.end() };
+                    if (!transitions.empty()) { aut.delta.remove(transitions[random_state(transitions.size())]); }
+                    break;
+                }
+                case 6: {
+                    const State state{ random_state(num_of_states) };
+                    if (aut.final[state]) { aut.final.erase(state); } else { aut.final.insert(state); }
+                    break;
+                }
+                default: {
+                    const State state{ random_state(num_of_states) };
+                    if (aut.initial[state]) { aut.initial.erase(state); } else { aut.initial.insert(state); }
+                    break;
+                }
+            }
+        }
+    }
 }
 
 TEST_CASE("Mata::Nfa::Nfa::delta.empty()")
@@ -2795,6 +3106,66 @@ TEST_CASE("Mata::Nfa::Nfa::delta.empty()")
     }
 }
 
+TEST_CASE("Mata::Nfa::Move") {
+    SECTION("move assignment between moves over the same symbol") {
+        Move move{ 'a', StateSet{ 1, 2 } };
+        Move other{ 'a', StateSet{ 3 } };
+        move = std::move(other);
+        CHECK(move.targets == StateSet{ 3 });
+    }
+
+    SECTION("insert state sets") {
+        Move move{ 'a' };
+        move.insert(StateSet{ 4, 5 });
+        move.insert(StateSet{ 7, 9 });
+        CHECK(move.targets == StateSet{ 4, 5, 7, 9 });
+        move.insert(StateSet{ 1, 5, 8, 10 });
+        CHECK(move.targets == StateSet{ 1, 4, 5, 7, 8, 9, 10 });
+        move.insert(StateSet{});
+        CHECK(move.targets == StateSet{ 1, 4, 5, 7, 8, 9, 10 });
+    }
+}
+
+TEST_CASE("Mata::Nfa::Delta::add_unsorted()") {
+    Delta delta{};
+    delta.add(1, 'b', 2);
+
+    delta.start_bulk();
+    CHECK(delta.is_in_bulk());
+    delta.add_unsorted(3, 'a', 0);
+    delta.add_unsorted(1, 'c', 4);
+    delta.add_unsorted(1, 'b', 0);
+    delta.add_unsorted(1, 'a', 5);
+    delta.add_unsorted(1, 'b', 2);
+    delta.add_unsorted(1, 'b', 0);
+    delta.add_unsorted(0, 'a', 1);
+    CHECK(delta.size() == 1);
+    delta.finalize();
+    CHECK(!delta.is_in_bulk());
+
+    Delta expected{};
+    expected.add(0, 'a', 1);
+    expected.add(1, 'a', 5);
+    expected.add(1, 'b', 0);
+    expected.add(1, 'b', 2);
+    expected.add(1, 'c', 4);
+    expected.add(3, 'a', 0);
+    CHECK(delta.num_of_states() == 6);
+    CHECK(delta.size() == expected.size());
+    for (State state{ 0 }; state < expected.num_of_states(); ++state) {
+        CHECK(delta[state].ToVector() == expected[state].ToVector());
+        for (const Move& move: delta[state]) {
+            CHECK(move.targets == expected[state].find(move.symbol)->targets);
+        }
+    }
+
+    SECTION("finalize without transitions") {
+        delta.start_bulk();
+        delta.finalize();
+        CHECK(delta.size() == expected.size());
+    }
+}
+
 TEST_CASE("Mata::Nfa::delta.operator[]")
 {
     Nfa aut{20};
@@ -2822,6 +3193,180 @@ TEST_CASE("Mata::Nfa::delta.operator[]")
     REQUIRE(aut2.delta[60].empty());
 }
 
+TEST_CASE("Mata::Nfa::FrozenDelta") {
+    Nfa aut{20};
+    FILL_WITH_AUT_A(aut);
+    const FrozenDelta frozen{ aut.delta };
+    CHECK(frozen.num_of_states() == aut.delta.num_of_states());
+    CHECK(frozen.size() == aut.delta.size());
+    CHECK(!frozen.empty());
+    CHECK(frozen[25].empty());
+
+    auto check_equal = [&aut](const FrozenDelta& frozen_delta) {
+        for (State q{ 0 }; q < aut.delta.num_of_states(); ++q) {
+            const Post& post{ aut.delta[q] };
+            const FrozenPost frozen_post{ frozen_delta[q] };
+            REQUIRE(frozen_post.size() == post.size());
+            auto move_it{ post.begin() };
+            for (const FrozenMove& frozen_move: frozen_post) {
+                CHECK(frozen_move.symbol == move_it->symbol);
+                CHECK(std::vector<State>(frozen_move.begin(), frozen_move.end()) == move_it->targets.ToVector());
+                ++move_it;
+            }
+        }
+    };
+    check_equal(frozen);
+
+    SECTION("find") {
+        CHECK(frozen[7].find('a')->targets.size() == 2);
+        CHECK(frozen[7].find('a')->count(5) == 1);
+        CHECK(frozen[7].find('a')->count(4) == 0);
+        CHECK(frozen[7].find('d') == frozen[7].end());
+        CHECK(frozen[7].back().symbol == 'c');
+    }
+
+    SECTION("copies point to own targets") {
+        FrozenDelta copy{ frozen };
+        check_equal(copy);
+        CHECK(copy[1].begin()->targets.data() != frozen[1].begin()->targets.data());
+        FrozenDelta assigned{};
+        assigned = copy;
+        check_equal(assigned);
+        FrozenDelta moved{ std::move(copy) };
+        check_equal(moved);
+    }
+
+    SECTION("empty delta") {
+        const FrozenDelta empty{ Delta{} };
+        CHECK(empty.num_of_states() == 0);
+        CHECK(empty.empty());
+        CHECK(empty[0].empty());
+    }
+}
+
+TEST_CASE("Mata::Nfa::Delta::pre()") {
+    Nfa aut{20};
+    FILL_WITH_AUT_A(aut);
+    using InTransition = ReverseDelta::InTransition;
+
+    // All transitions are found in the reverse index exactly once, ordered by symbols and sources.
+    const ReverseDelta& reverse{ aut.delta.get_reverse() };
+    CHECK(reverse.size() == aut.delta.size());
+    for (const Trans& trans: aut.delta) {
+        const std::span<const InTransition> pre{ aut.delta.pre(trans.tgt) };
+        CHECK(std::count(pre.begin(), pre.end(), InTransition{ trans.symb, trans.src }) == 1);
+        CHECK(std::is_sorted(pre.begin(), pre.end()));
+    }
+    const std::span<const InTransition> pre_over_a{ aut.delta.pre(3, 'a') };
+    CHECK(std::vector<InTransition>(pre_over_a.begin(), pre_over_a.end())
+          == std::vector<InTransition>{ { 'a', 1 }, { 'a', 7 } });
+    CHECK(aut.delta.pre(3, 'd').empty());
+    CHECK(aut.delta.pre(25).empty());
+
+    SECTION("the index is rebuilt after modifications") {
+        CHECK(&aut.delta.get_reverse() == &reverse);
+        aut.delta.add(4, 'd', 3);
+        CHECK(aut.delta.pre(3, 'd').size() == 1);
+        aut.delta.remove(4, 'd', 3);
+        CHECK(aut.delta.pre(3, 'd').empty());
+        aut.delta.get_mutable_post(4).insert(Move{ 'd', 3 });
+        CHECK(aut.delta.pre(3, 'd').size() == 1);
+        aut.delta.start_bulk();
+        aut.delta.add_unsorted(5, 'd', 3);
+        aut.delta.finalize();
+        CHECK(aut.delta.pre(3, 'd').size() == 2);
+    }
+
+    SECTION("concurrent readers share one index") {
+        Nfa copy{ 20 };
+        FILL_WITH_AUT_A(copy);
+        std::vector<const ReverseDelta*> indices(4);
+        std::vector<std::thread> threads{};
+        for (size_t thread{ 0 }; thread < indices.size(); ++thread) {
+            threads.emplace_back([&copy, &indices, thread]() { indices[thread] = &copy.delta.get_reverse(); });
+        }
+        for (std::thread& thread: threads) { thread.join(); }
+        CHECK(std::all_of(indices.begin(), indices.end(),
+                          [&](const ReverseDelta* index) { return index == &copy.delta.get_reverse(); }));
+        CHECK(copy.delta.pre(3, 'a').size() == 2);
+    }
+
+    SECTION("backward algorithms") {
+        CHECK(aut.get_transitions_to(3).size() == aut.delta.pre(3).size());
+        const Nfa reverted{ revert(aut) };
+        CHECK(reverted.size() == aut.size());
+        CHECK(reverted.delta.size() == aut.delta.size());
+        for (const Trans& trans: aut.delta) { CHECK(reverted.delta.contains(trans.tgt, trans.symb, trans.src)); }
+        CHECK(aut.get_terminating_states() == reverted.get_reachable_states());
+    }
+}
+
+TEST_CASE("Mata::Nfa::Delta with a memory resource") {
+    std::pmr::monotonic_buffer_resource arena{};
+    Nfa aut{ Delta{ &arena } };
+
+    {
+        // Any allocation outside of the arena fails while the transitions are added.
+        struct DefaultResourceGuard {
+            std::pmr::memory_resource* previous{ std::pmr::set_default_resource(std::pmr::null_memory_resource()) };
+            ~DefaultResourceGuard() { std::pmr::set_default_resource(previous); }
+        } guard{};
+        aut.delta.add(0, 'b', 1);
+        aut.delta.add(0, 'a', 2);
+        aut.delta.add(0, 'a', 1);
+        aut.delta.add(1, 'a', StateSet{ 0, 2 });
+        aut.delta.add(1, 'a', StateSet{ 3 });
+        aut.delta.start_bulk();
+        aut.delta.add_unsorted(3, 'c', 0);
+        aut.delta.add_unsorted(2, 'b', 3);
+        aut.delta.add_unsorted(0, 'a', 3);
+        aut.delta.finalize();
+        Post& post{ aut.delta.get_mutable_post(4) };
+        post.insert(Move{ 'c', 0, post.get_allocator() });
+    }
+
+    CHECK(aut.delta.get_memory_resource() == &arena);
+    CHECK(aut.delta.size() == 10);
+    CHECK(aut.delta[0].find('a')->targets == StateSet{ 1, 2, 3 });
+    CHECK(aut.delta[1].find('a')->targets == StateSet{ 0, 2, 3 });
+    for (State state{ 0 }; state < aut.delta.num_of_states(); ++state) {
+        CHECK(aut.delta[state].get_allocator().resource() == &arena);
+        for (const Move& move: aut.delta[state]) { CHECK(move.get_allocator().resource() == &arena); }
+    }
+    const std::vector<Trans> transitions{ aut.delta.begin(), aut.delta.end() };
+
+    SECTION("copies allocate from the default resource") {
+        const Nfa copy{ aut };
+        CHECK(copy.delta.get_memory_resource() == std::pmr::get_default_resource());
+        CHECK(copy.delta[0].find('a')->get_allocator().resource() == std::pmr::get_default_resource());
+        CHECK(std::vector<Trans>(copy.delta.begin(), copy.delta.end()) == transitions);
+    }
+
+    SECTION("moving keeps the memory resource") {
+        const Nfa moved{ std::move(aut) };
+        CHECK(moved.delta.get_memory_resource() == &arena);
+        CHECK(std::vector<Trans>(moved.delta.begin(), moved.delta.end()) == transitions);
+    }
+
+    SECTION("copy into another memory resource") {
+        std::pmr::monotonic_buffer_resource other_arena{};
+        const Delta copy{ aut.delta, &other_arena };
+        CHECK(copy.get_memory_resource() == &other_arena);
+        CHECK(copy[1].find('a')->get_allocator().resource() == &other_arena);
+        CHECK(std::vector<Trans>(copy.begin(), copy.end()) == transitions);
+    }
+
+    SECTION("assigning keeps the memory resource of the target") {
+        Nfa other{ 3 };
+        other.delta.add(0, 'a', 1);
+        aut = other;
+        CHECK(aut.delta.get_memory_resource() == &arena);
+        CHECK(aut.delta[0].find('a')->get_allocator().resource() == &arena);
+        CHECK(aut.delta.contains(0, 'a', 1));
+        CHECK(aut.delta.size() == 1);
+    }
+}
+
 TEST_CASE("Mata::Nfa::Nfa::unify_(initial/final)()") {
     Nfa nfa{10};
 
@@ -15,6 +15,8 @@
  * GNU General Public License for more details.
  */
 
+#include <memory_resource>
+
 #include "../3rdparty/catch.hpp"
 
 #include "mata/utils/util.hh"
@@ -111,3 +113,55 @@ TEST_CASE("Mata::Util::OrdVector::difference()") {
         CHECK(set1.difference(set2) == Mata::Util::OrdVector<int>{ 1, 2 });
     }
 }
+
+TEST_CASE("Mata::Util::OrdVector::insert()") {
+    using OrdVectorT = OrdVector<std::vector<int>>;
+    OrdVectorT set{};
+
+    SECTION("copied elements") {
+        const std::vector<int> elem{ 2, 3 };
+        set.insert(elem);
+        set.insert(std::vector<int>{ 1 });
+        set.insert(elem);
+        CHECK(set.size() == 2);
+        CHECK(set.ToVector() == std::vector<std::vector<int>>{ { 1 }, { 2, 3 } });
+    }
+
+    SECTION("moved elements keep their contents when shifted") {
+        set.insert(std::vector<int>{ 5 });
+        set.insert(std::vector<int>{ 7, 8 });
+        set.insert(std::vector<int>{ 3, 4 });
+        set.insert(std::vector<int>{ 6 });
+        set.insert(std::vector<int>{ 7, 8 });
+        CHECK(set.ToVector() == std::vector<std::vector<int>>{ { 3, 4 }, { 5 }, { 6 }, { 7, 8 } });
+    }
+}
+
+TEST_CASE("Mata::Util::sort_and_rmdupl()") {
+    std::vector<int> vec{ 3, 1, 1, 2, 3 };
+    sort_and_rmdupl(vec);
+    CHECK(vec == std::vector<int>{ 1, 2, 3 });
+    CHECK(OrdVector<int>{ 3, 1, 1, 2 }.ToVector() == std::vector<int>{ 1, 2, 3 });
+}
+
+TEST_CASE("Mata::Util::OrdVector with a polymorphic allocator") {
+    using PmrOrdVector = OrdVector<int, std::pmr::polymorphic_allocator<int>>;
+    std::pmr::monotonic_buffer_resource arena{};
+    PmrOrdVector set{ { 3, 1, 2 }, &arena };
+    CHECK(set.get_allocator().resource() == &arena);
+    CHECK(set == OrdVector<int>{ 1, 2, 3 });
+    CHECK(set.ToVector() == std::vector<int>{ 1, 2, 3 });
+
+    set.insert(OrdVector<int>{ 0, 2, 4 });
+    CHECK(set.ToVector() == std::vector<int>{ 0, 1, 2, 3, 4 });
+    CHECK(set.get_allocator().resource() == &arena);
+
+    set = OrdVector<int>{ 5 };
+    CHECK(set.ToVector() == std::vector<int>{ 5 });
+    CHECK(set.get_allocator().resource() == &arena);
+
+    const PmrOrdVector copy{ set };
+    CHECK(copy.get_allocator().resource() == std::pmr::get_default_resource());
+    const OrdVector<int> converted{ set, std::allocator<int>{} };
+    CHECK(converted == OrdVector<int>{ 5 });
+}
@@ -6,6 +6,7 @@
 
 #include "mata/utils/util.hh"
 #include "mata/utils/synchronized-iterator.hh"
+#include "mata/utils/k-way-merge.hh"
 
 using namespace Mata::Util;
 
@@ -115,6 +116,41 @@ TEST_CASE("Mata::Util::SynchronizedIterator")
         REQUIRE(!iu.advance());
     }
 
+    SECTION("synchronized_universal_iterator, position[0] moves past a middle vector") {
+        SynchronizedUniversalIterator<OrdVector<int>::const_iterator> iu;
+
+        // Synchronizing v3 moves position[0] to 2, which v2 does not contain.
+        OrdVector<int> v1{1, 2};
+        OrdVector<int> v2{1};
+        OrdVector<int> v3{2};
+
+        push_back(iu,v1);
+        push_back(iu,v2);
+        push_back(iu,v3);
+
+        REQUIRE(!iu.advance());
+
+        iu.reset();
+        v1 = {1, 2, 3, 5};
+        v2 = {1, 3, 4, 5};
+        v3 = {2, 3, 5};
+        OrdVector<int> v4{0, 5};
+
+        push_back(iu,v1);
+        push_back(iu,v2);
+        push_back(iu,v3);
+        push_back(iu,v4);
+
+        REQUIRE(iu.advance());
+        auto current = iu.get_current();
+        REQUIRE(current.size() == 4);
+        CHECK(*current[0] == 5);
+        CHECK(*current[1] == 5);
+        CHECK(*current[2] == 5);
+        CHECK(*current[3] == 5);
+        REQUIRE(!iu.advance());
+    }
+
     SECTION("SynchronizedExistentialIterator, basic functionality")
     {
         SynchronizedExistentialIterator<OrdVector<int>::const_iterator> ie;
@@ -205,3 +241,87 @@ TEST_CASE("Mata::Util::SynchronizedIterator")
         REQUIRE(!ie.advance());
     }
 }
+
+TEST_CASE("Mata::Util::SynchronizedIterator::get_current(span)")
+{
+    OrdVector<int> v1{1, 2, 4};
+    OrdVector<int> v2{0, 2, 4};
+    std::span<const OrdVector<int>::const_iterator> current{};
+
+    SECTION("universal iterator")
+    {
+        SynchronizedUniversalIterator<OrdVector<int>::const_iterator> iu;
+        push_back(iu, v1);
+        push_back(iu, v2);
+
+        REQUIRE(iu.advance());
+        iu.get_current(current);
+        REQUIRE(current.size() == 2);
+        CHECK(*current[0] == 2);
+        CHECK(*current[1] == 2);
+        REQUIRE(iu.advance());
+        iu.get_current(current);
+        CHECK(*current[0] == 4);
+        CHECK(*current[1] == 4);
+        CHECK(!iu.advance());
+    }
+
+    SECTION("existential iterator")
+    {
+        SynchronizedExistentialIterator<OrdVector<int>::const_iterator> ie;
+        push_back(ie, v1);
+        push_back(ie, v2);
+
+        REQUIRE(ie.advance());
+        ie.get_current(current);
+        REQUIRE(current.size() == 1);
+        CHECK(*current[0] == 0);
+        REQUIRE(ie.advance());
+        ie.get_current(current);
+        REQUIRE(current.size() == 1);
+        CHECK(*current[0] == 1);
+        REQUIRE(ie.advance());
+        ie.get_current(current);
+        REQUIRE(current.size() == 2);
+        CHECK(*current[0] == 2);
+        CHECK(*current[1] == 2);
+    }
+}
+
+TEST_CASE("Mata::Util::KWayMerger")
+{
+    KWayMerger<int> merger{};
+    std::vector<int> result{ 42 };
+
+    SECTION("no ranges")
+    {
+        merger.merge(result);
+        CHECK(result.empty());
+    }
+
+    SECTION("single range")
+    {
+        const std::vector<int> range{ 1, 3, 5 };
+        merger.add(range.data(), range.data() + range.size());
+        merger.merge(result);
+        CHECK(result == range);
+    }
+
+    SECTION("overlapping and empty ranges")
+    {
+        const std::vector<int> r1{ 1, 4, 7 };
+        const std::vector<int> r2{ 0, 4, 8, 9 };
+        const std::vector<int> r3{};
+        const std::vector<int> r4{ 1, 2, 9 };
+        for (const auto* range: { &r1, &r2, &r3, &r4 }) {
+            merger.add(range->data(), range->data() + range->size());
+        }
+        merger.merge(result);
+        CHECK(result == std::vector<int>{ 0, 1, 2, 4, 7, 8, 9 });
+
+        // The merger is empty again after a merge.
+        merger.add(r1.data(), r1.data() + r1.size());
+        merger.merge(result);
+        CHECK(result == r1);
+    }
+}
@@ -0,0 +1,94 @@
+/* tests-two-dimensional-map.cc -- tests of TwoDimensionalMap
+ *
+ * This file is a part of libmata.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include <algorithm>
+#include <tuple>
+
+#include "../3rdparty/catch.hpp"
+
+#include "mata/nfa/nfa.hh"
+#include "mata/utils/two-dimensional-map.hh"
+
+using namespace Mata::Util;
+using namespace Mata::Nfa;
+
+TEST_CASE("Mata::Util::TwoDimensionalMap") {
+    const size_t matrix_budget{ GENERATE(size_t{ 0 }, TwoDimensionalMap<State, State>::DEFAULT_MATRIX_BUDGET) };
+    TwoDimensionalMap<State, State> map{ 1000, 300, matrix_budget };
+    CHECK(map.is_matrix() == (matrix_budget != 0));
+    CHECK(map.empty());
+    CHECK(!map.contains(0, 0));
+    CHECK(map.get(999, 299) == Limits::max_state);
+
+    SECTION("insert and get") {
+        map.insert(3, 5, 42);
+        map.insert(5, 3, 43);
+        CHECK(map.size() == 2);
+        CHECK(map.get(3, 5) == 42);
+        CHECK(map.get(5, 3) == 43);
+        CHECK(!map.contains(3, 3));
+        map.insert(3, 5, 44);
+        CHECK(map.size() == 2);
+        CHECK(map.get(3, 5) == 44);
+    }
+
+    SECTION("many pairs") {
+        State value{ 0 };
+        for (State first{ 0 }; first < 1000; first += 3) {
+            for (State second{ 0 }; second < 300; second += 7) {
+                map.insert(first, second, value++);
+            }
+        }
+        CHECK(map.size() == value);
+
+        value = 0;
+        for (State first{ 0 }; first < 1000; first += 3) {
+            for (State second{ 0 }; second < 300; second += 7) {
+                CHECK(map.get(first, second) == value++);
+                if (first + 1 < 1000) { CHECK(!map.contains(first + 1, second)); }
+            }
+        }
+
+        size_t visited{ 0 };
+        map.for_each([&](const State first, const State second, const State stored_value) {
+            CHECK(map.get(first, second) == stored_value);
+            ++visited;
+        });
+        CHECK(visited == map.size());
+    }
+}
+
+TEST_CASE("Mata::Util::TwoDimensionalMap with a large sparse matrix") {
+    // The matrix has 2^28 cells, but only the pages with inserted pairs are allocated.
+    TwoDimensionalMap<State, State> map{ 1 << 14, 1 << 14, size_t{ 1 } << 28 };
+    CHECK(map.is_matrix());
+    map.insert(0, 0, 1);
+    map.insert((1 << 14) - 1, (1 << 14) - 1, 2);
+    map.insert(1 << 13, 5, 3);
+    CHECK(map.size() == 3);
+    CHECK(map.get(0, 0) == 1);
+    CHECK(map.get((1 << 14) - 1, (1 << 14) - 1) == 2);
+    CHECK(map.get(1 << 13, 5) == 3);
+    CHECK(!map.contains(1 << 13, 4));
+    CHECK(!map.contains(1 << 12, 5));
+
+    std::vector<std::tuple<State, State, State>> pairs{};
+    map.for_each([&pairs](const State first, const State second, const State value) {
+        pairs.emplace_back(first, second, value);
+    });
+    std::sort(pairs.begin(), pairs.end());
+    CHECK(pairs == std::vector<std::tuple<State, State, State>>{
+        { 0, 0, 1 }, { 1 << 13, 5, 3 }, { (1 << 14) - 1, (1 << 14) - 1, 2 } });
+}
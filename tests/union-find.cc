@@ -0,0 +1,43 @@
+/* tests-union-find.cc -- tests of UnionFind
+ *
+ * This file is a part of libmata.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include "../3rdparty/catch.hpp"
+
+#include "mata/utils/union-find.hh"
+
+using namespace Mata::Util;
+
+TEST_CASE("Mata::Util::UnionFind") {
+    UnionFind<unsigned> classes{};
+    CHECK(classes.find(5) == 5);
+    CHECK(!classes.are_together(1, 2));
+
+    CHECK(classes.unite(1, 2));
+    CHECK(classes.unite(3, 4));
+    CHECK(!classes.unite(2, 1));
+    CHECK(classes.are_together(1, 2));
+    CHECK(!classes.are_together(2, 3));
+
+    CHECK(classes.unite(2, 4));
+    CHECK(classes.are_together(1, 3));
+    CHECK(classes.find(1) == classes.find(4));
+    CHECK(!classes.are_together(1, 5));
+    CHECK(classes.find(100) == 100);
+
+    // A long chain of unions.
+    for (unsigned i{ 10 }; i < 1000; ++i) { classes.unite(i, i + 1); }
+    CHECK(classes.are_together(10, 1000));
+    CHECK(!classes.are_together(9, 1000));
+}